@@ -0,0 +1,300 @@
+/*
+ * Callback benchmark
+ *
+ * Compare fge::CallbackHandler with the previous implementation (recursive mutex locked on
+ * every call, callbacks in a std::forward_list and every lambda allocated).
+ *
+ * Each measure call a handler filled with N callbacks (a function, a method and a small lambda
+ * mixed), from one thread and then from --threads threads at the same time.
+ * Most handlers of the engine are empty, so 0 callbacks is measured too.
+ * The cost of adding and removing a callback is also measured.
+ *
+ * usage: fgeCallbackBenchmark [--callbacks 0,1,8,64] [--calls N] [--threads N] [--output FILE]
+ *
+ * The report is written as JSON on the standard output or in the provided file.
+ */
+
+#include "FastEngine/C_callback.hpp"
+#include "benchmark_common.hpp"
+#include <algorithm>
+#include <chrono>
+#include <forward_list>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Options : fge::benchmark::Options
+{
+    std::vector<unsigned int> _callbacks{0, 1, 8, 64};
+    unsigned int _calls{1000000};
+    unsigned int _threads{4};
+};
+
+//The previous handler implementation, kept as the reference
+namespace legacy
+{
+
+template <class ... Types>
+class CallbackLambda : public fge::CallbackFunctorBase<Types ...>
+{
+public:
+    template<typename TLambda>
+    explicit CallbackLambda(const TLambda& lambda) :
+            g_lambda(new TLambda(lambda))
+    {
+        this->g_executeLambda = [](void* lambdaPtr, Types... arguments)
+        {
+            return (*reinterpret_cast<TLambda*>(lambdaPtr))(arguments...);
+        };
+        this->g_deleteLambda = [](void* lambdaPtr)
+        {
+            delete reinterpret_cast<TLambda*>(lambdaPtr);
+        };
+    }
+    ~CallbackLambda() override
+    {
+        (*this->g_deleteLambda)(this->g_lambda);
+    }
+
+    void call(Types ... args) override
+    {
+        (*this->g_executeLambda)(this->g_lambda, args...);
+    }
+    bool check([[maybe_unused]] void* ptr) override
+    {
+        return false;
+    }
+
+private:
+    void* g_lambda;
+    void (*g_executeLambda)(void *, Types...);
+    void (*g_deleteLambda)(void *);
+};
+
+template <class ... Types>
+class CallbackHandler
+{
+public:
+    void add(fge::CallbackFunctorBase<Types ...>* callback)
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        this->g_callees.push_front({CalleePtr(callback)});
+    }
+    void delPtr(void* ptr)
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        this->g_callees.remove_if([&](const CalleeData& data){
+            return data._f->check(ptr);
+        });
+    }
+    void call(Types ... args)
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        auto itCalleeNext = this->g_callees.begin();
+        for (auto itCallee=this->g_callees.begin(); itCallee!=this->g_callees.end(); itCallee=itCalleeNext)
+        {
+            ++itCalleeNext;
+            itCallee->_f->call(args ...);
+        }
+    }
+
+private:
+    using CalleePtr = std::unique_ptr<fge::CallbackFunctorBase<Types ...> >;
+    struct CalleeData
+    {
+        CalleePtr _f;
+    };
+
+    std::forward_list<CalleeData> g_callees;
+    std::recursive_mutex g_mutex;
+};
+
+}//end legacy
+
+struct Counter
+{
+    void onCall(int value)
+    {
+        this->_sum += static_cast<uint64_t>(value);
+    }
+
+    uint64_t _sum{0};
+};
+
+uint64_t gFunctionSum = 0;
+void OnCall(int value)
+{
+    gFunctionSum += static_cast<uint64_t>(value);
+}
+
+thread_local uint64_t gThreadSum = 0;
+void OnConcurrentCall(int value)
+{
+    gThreadSum += static_cast<uint64_t>(value);
+}
+
+template<class THandler, class TLambda>
+void FillHandler(THandler& handler, unsigned int count, Counter& counter, uint64_t& lambdaSum)
+{
+    for (unsigned int i=0; i<count; ++i)
+    {
+        switch (i%3)
+        {
+        case 0:
+            handler.add(new fge::CallbackFunctor<int>(&OnCall));
+            break;
+        case 1:
+            handler.add(new fge::CallbackFunctorObject<Counter, int>(&Counter::onCall, &counter));
+            break;
+        default:
+            handler.add(new TLambda([&lambdaSum](int value){
+                lambdaSum += static_cast<uint64_t>(value);
+            }));
+            break;
+        }
+    }
+}
+
+template<class THandler, class TLambda>
+nlohmann::json RunHandler(unsigned int callbacks, const Options& options)
+{
+    nlohmann::json result;
+
+    //One thread
+    {
+        THandler handler;
+        Counter counter;
+        uint64_t lambdaSum = 0;
+        FillHandler<THandler, TLambda>(handler, callbacks, counter, lambdaSum);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int i=0; i<options._calls; ++i)
+        {
+            handler.call(1);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double time = std::chrono::duration<double, std::milli>(end-start).count();
+        result["call_ms"] = time;
+        result["call_ns"] = time * 1000000.0 / static_cast<double>(std::max(options._calls, 1u));
+    }
+
+    //Multiple threads calling the same handler, callbacks only read
+    {
+        THandler handler;
+        for (unsigned int i=0; i<callbacks; ++i)
+        {
+            handler.add(new fge::CallbackFunctor<int>(&OnConcurrentCall));
+        }
+
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int t=0; t<options._threads; ++t)
+        {
+            threads.emplace_back([&](){
+                for (unsigned int i=0; i<options._calls; ++i)
+                {
+                    handler.call(1);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        result["concurrent_call_ms"] = std::chrono::duration<double, std::milli>(end-start).count();
+    }
+
+    //Add and remove
+    {
+        THandler handler;
+        Counter counter;
+        uint64_t lambdaSum = 0;
+        FillHandler<THandler, TLambda>(handler, callbacks, counter, lambdaSum);
+
+        const unsigned int count = std::max(options._calls/1000u, 1u);
+        std::vector<Counter> counters(count);
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& object : counters)
+        {
+            handler.add(new fge::CallbackFunctorObject<Counter, int>(&Counter::onCall, &object));
+        }
+        for (auto& object : counters)
+        {
+            handler.delPtr(&object);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        result["add_remove_ms"] = std::chrono::duration<double, std::milli>(end-start).count();
+        result["add_remove_count"] = count;
+    }
+
+    return result;
+}
+
+nlohmann::json RunCallbacks(unsigned int callbacks, const Options& options)
+{
+    nlohmann::json result;
+    result["callbacks"] = callbacks;
+    result["calls"] = options._calls;
+    result["threads"] = options._threads;
+
+    result["handler"] = RunHandler<fge::CallbackHandler<int>, fge::CallbackLambda<int> >(callbacks, options);
+    result["legacy"] = RunHandler<legacy::CallbackHandler<int>, legacy::CallbackLambda<int> >(callbacks, options);
+
+    const double time = result["handler"]["call_ms"];
+    const double legacyTime = result["legacy"]["call_ms"];
+    result["speedup"] = time > 0.0 ? legacyTime / time : 0.0;
+    const double concurrentTime = result["handler"]["concurrent_call_ms"];
+    const double legacyConcurrentTime = result["legacy"]["concurrent_call_ms"];
+    result["concurrent_speedup"] = concurrentTime > 0.0 ? legacyConcurrentTime / concurrentTime : 0.0;
+    return result;
+}
+
+//Handle an argument of the benchmark, return false if it's unknown
+bool ParseOption(const std::string& arg, const std::string& value, Options& options)
+{
+    if (arg == "--callbacks")
+    {
+        options._callbacks = fge::benchmark::ParseList<unsigned int>(value, [](const std::string& element){
+            return static_cast<unsigned int>(std::stoul(element));
+        });
+    }
+    else if (arg == "--calls")
+    {
+        options._calls = static_cast<unsigned int>(std::stoul(value));
+    }
+    else if (arg == "--threads")
+    {
+        options._threads = std::max(1u, static_cast<unsigned int>(std::stoul(value)));
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+}//end
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if ( !fge::benchmark::ParseArguments(argc, argv, options, [&](const std::string& arg, const std::string& value){
+        return ParseOption(arg, value, options);
+    }) )
+    {
+        return 1;
+    }
+
+    nlohmann::json report;
+    report["results"] = nlohmann::json::array();
+    for (unsigned int callbacks : options._callbacks)
+    {
+        report["results"].push_back(RunCallbacks(callbacks, options));
+    }
+
+    return fge::benchmark::WriteReport(report, options);
+}
@@ -0,0 +1,136 @@
+/*
+ * Common helpers of the benchmarks
+ *
+ * Every benchmark take "--name value" arguments, the --output argument is handled here.
+ * The report is written as JSON on the standard output or in the provided file.
+ */
+
+#ifndef _FGE_BENCHMARK_COMMON_HPP_INCLUDED
+#define _FGE_BENCHMARK_COMMON_HPP_INCLUDED
+
+#include <json.hpp>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fge::benchmark
+{
+
+/**
+ * \struct Options
+ * \brief Options shared by every benchmark, benchmark options inherit from it
+ */
+struct Options
+{
+    std::string _output; ///< The output file, empty for the standard output
+};
+
+/**
+ * \brief Handle a benchmark specific argument
+ *
+ * A bad value must be reported by throwing an exception (like std::stoul() does).
+ *
+ * \return \b false if the argument is unknown
+ */
+using ArgumentHandler = std::function<bool(const std::string& arg, const std::string& value)>;
+
+/**
+ * \brief Parse the "--name value" arguments of a benchmark
+ *
+ * Errors are printed on the standard error output.
+ *
+ * \param argc The argument count of main()
+ * \param argv The arguments of main()
+ * \param options The shared options to fill
+ * \param handler The handler of the other arguments
+ * \return \b true if every argument is valid
+ */
+inline bool ParseArguments(int argc, char* argv[], fge::benchmark::Options& options, const ArgumentHandler& handler)
+{
+    try
+    {
+        for (int i=1; i<argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (i+1 >= argc)
+            {
+                std::cerr << "missing value for " << arg << std::endl;
+                return false;
+            }
+            const std::string value = argv[++i];
+
+            if (arg == "--output")
+            {
+                options._output = value;
+            }
+            else if ( !handler(arg, value) )
+            {
+                std::cerr << "unknown argument " << arg << std::endl;
+                return false;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "bad argument: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Parse a comma separated list value
+ *
+ * \param value The argument value
+ * \param convert The conversion of one element
+ * \return The list of converted elements
+ */
+template<class T, class TConvert>
+std::vector<T> ParseList(const std::string& value, const TConvert& convert)
+{
+    std::vector<T> result;
+    std::size_t start = 0;
+    while (start < value.size())
+    {
+        auto end = value.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = value.size();
+        }
+        result.push_back(convert(value.substr(start, end-start)));
+        start = end+1;
+    }
+    return result;
+}
+
+/**
+ * \brief Write the report
+ *
+ * \param report The JSON report
+ * \param options The shared options
+ * \return The exit code of the benchmark
+ */
+inline int WriteReport(const nlohmann::json& report, const fge::benchmark::Options& options)
+{
+    if (options._output.empty())
+    {
+        std::cout << report.dump(4) << std::endl;
+        return 0;
+    }
+
+    std::ofstream outFile(options._output);
+    if (!outFile)
+    {
+        std::cerr << "unable to write " << options._output << std::endl;
+        return 1;
+    }
+    outFile << report.dump(4) << std::endl;
+    return 0;
+}
+
+}//end fge::benchmark
+
+#endif // _FGE_BENCHMARK_COMMON_HPP_INCLUDED
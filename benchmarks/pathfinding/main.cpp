@@ -0,0 +1,474 @@
+/*
+ * Path finding benchmark
+ *
+ * Compare fge::AStar::Generator with the previous implementation (linear open list scan,
+ * linear membership test and one allocation per node) on generated mazes.
+ *
+ * The previous implementation is quadratic in explored nodes, so it's only run on mazes
+ * up to --legacy-max-size.
+ *
+ * The Jump Point Search (only with --diagonal 1) and hierarchical strategies are also measured.
+ * A flow field is compared with one findPath() per agent when every query share the same target.
+ *
+ * usage: fgePathFindingBenchmark [--sizes 64,128,256,512] [--queries N] [--legacy-max-size N]
+ *                                [--cluster-size N] [--seed N] [--diagonal 0|1] [--output FILE]
+ *
+ * The report is written as JSON on the standard output or in the provided file.
+ */
+
+#include "FastEngine/extra/extra_pathFinding.hpp"
+#include "FastEngine/extra/extra_flowField.hpp"
+#include "benchmark_common.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+namespace
+{
+
+struct Options : fge::benchmark::Options
+{
+    std::vector<int32_t> _sizes{64, 128, 256, 512};
+    unsigned int _queries{20};
+    int32_t _legacyMaxSize{256};
+    int32_t _clusterSize{16};
+    unsigned int _seed{42};
+    bool _diagonal{false};
+};
+
+//The previous A* implementation, kept as the reference
+namespace legacy
+{
+
+struct Node
+{
+    explicit Node(fge::AStar::Vector2i coord, Node* parent = nullptr) :
+            _g(0),
+            _h(0),
+            _coord(coord),
+            _parent(parent)
+    {}
+    [[nodiscard]] unsigned int getScore() const
+    {
+        return this->_g + this->_h;
+    }
+
+    unsigned int _g, _h;
+    fge::AStar::Vector2i _coord;
+    Node* _parent;
+};
+
+using NodeList = std::vector<Node*>;
+
+class Generator
+{
+public:
+    void setWorldSize(fge::AStar::Vector2i worldSize)
+    {
+        this->g_worldSize = worldSize;
+    }
+    void setDiagonalMovement(bool enable)
+    {
+        this->g_directionsCount = enable ? 8 : 4;
+    }
+    void setHeuristic(fge::AStar::HeuristicFunction heuristic)
+    {
+        this->g_heuristic = std::move(heuristic);
+    }
+    void addCollision(fge::AStar::Vector2i coord)
+    {
+        this->g_walls.insert(coord);
+    }
+
+    fge::AStar::CoordinateList findPath(fge::AStar::Vector2i source, fge::AStar::Vector2i target)
+    {
+        Node* current = nullptr;
+        NodeList openNodes;
+        NodeList closeNodes;
+
+        openNodes.reserve(100);
+        closeNodes.reserve(100);
+        openNodes.push_back(new Node(source));
+
+        bool validPath = false;
+
+        while (!openNodes.empty())
+        {
+            auto itCurrent = openNodes.begin();
+            current = *itCurrent;
+
+            for (auto it = ++openNodes.begin(); it != openNodes.end(); ++it)
+            {
+                auto* node = *it;
+                if (node->getScore() <= current->getScore())
+                {
+                    current = node;
+                    itCurrent = it;
+                }
+            }
+
+            if (current->_coord == target)
+            {
+                validPath = true;
+                break;
+            }
+
+            closeNodes.push_back(current);
+            openNodes.erase(itCurrent);
+
+            for (std::size_t i = 0; i < this->g_directionsCount; ++i)
+            {
+                fge::AStar::Vector2i newCoordinates{current->_coord + this->g_directions[i]};
+                if (this->detectCollision(newCoordinates) ||
+                    this->findNodeOnList(closeNodes, newCoordinates) != nullptr)
+                {
+                    continue;
+                }
+
+                unsigned int totalCost = current->_g + ((i < 4) ? 10 : 14);
+
+                Node* successor = this->findNodeOnList(openNodes, newCoordinates);
+                if (successor == nullptr)
+                {
+                    successor = new Node(newCoordinates, current);
+                    successor->_g = totalCost;
+                    successor->_h = this->g_heuristic(successor->_coord, target);
+                    openNodes.push_back(successor);
+                }
+                else if (totalCost < successor->_g)
+                {
+                    successor->_parent = current;
+                    successor->_g = totalCost;
+                }
+            }
+        }
+
+        fge::AStar::CoordinateList path;
+        if (validPath)
+        {
+            while (current != nullptr)
+            {
+                path.push_back(current->_coord);
+                current = current->_parent;
+            }
+            std::reverse(path.begin(), path.end());
+        }
+
+        for (auto* node : openNodes)
+        {
+            delete node;
+        }
+        for (auto* node : closeNodes)
+        {
+            delete node;
+        }
+        return path;
+    }
+
+private:
+    [[nodiscard]] Node* findNodeOnList(const NodeList& nodes, fge::AStar::Vector2i coord) const
+    {
+        for (auto* node : nodes)
+        {
+            if (node->_coord == coord)
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+    [[nodiscard]] bool detectCollision(fge::AStar::Vector2i coord) const
+    {
+        return this->g_walls.find(coord) != this->g_walls.end() ||
+               coord.x < 0 || coord.x >= this->g_worldSize.x ||
+               coord.y < 0 || coord.y >= this->g_worldSize.y;
+    }
+
+    fge::AStar::HeuristicFunction g_heuristic{&fge::AStar::Heuristic::manhattan};
+    fge::AStar::CoordinateSet g_walls;
+    fge::AStar::Vector2i g_worldSize;
+    const std::array<fge::AStar::Vector2i, 8> g_directions{{
+        {0, 1}, {1, 0}, {0, -1}, {-1, 0},
+        {-1, -1}, {1, 1}, {-1, 1}, {1, -1}
+    }};
+    std::size_t g_directionsCount{4};
+};
+
+}//end legacy
+
+//Maze generated with a randomized depth first search, cells are on odd coordinates
+std::vector<uint8_t> GenerateMaze(int32_t size, std::mt19937& generator)
+{
+    std::vector<uint8_t> walls(static_cast<std::size_t>(size)*static_cast<std::size_t>(size), 1);
+    auto at = [&](int32_t x, int32_t y) -> uint8_t& {
+        return walls[static_cast<std::size_t>(y)*static_cast<std::size_t>(size) + static_cast<std::size_t>(x)];
+    };
+
+    const std::array<fge::AStar::Vector2i, 4> directions{{{0, 2}, {2, 0}, {0, -2}, {-2, 0}}};
+    std::vector<fge::AStar::Vector2i> stack{{1, 1}};
+    at(1, 1) = 0;
+
+    while (!stack.empty())
+    {
+        const fge::AStar::Vector2i current = stack.back();
+
+        std::array<fge::AStar::Vector2i, 4> candidates{};
+        std::size_t candidateCount = 0;
+        for (const auto& direction : directions)
+        {
+            const fge::AStar::Vector2i next = current + direction;
+            if (next.x > 0 && next.x < size-1 && next.y > 0 && next.y < size-1 && at(next.x, next.y) == 1)
+            {
+                candidates[candidateCount++] = next;
+            }
+        }
+
+        if (candidateCount == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const fge::AStar::Vector2i next = candidates[generator() % candidateCount];
+        at((current.x+next.x)/2, (current.y+next.y)/2) = 0;
+        at(next.x, next.y) = 0;
+        stack.push_back(next);
+    }
+
+    //Open some extra walls so there is more than one path
+    std::uniform_int_distribution<int32_t> randCoord{1, size-2};
+    for (int32_t i=0; i<size*size/64; ++i)
+    {
+        at(randCoord(generator), randCoord(generator)) = 0;
+    }
+    return walls;
+}
+
+//Cost of a path with the generator costs (10 for a straight move, 14 for a diagonal one), -1 if not found
+int64_t GetPathCost(const fge::AStar::CoordinateList& path)
+{
+    if (path.empty())
+    {
+        return -1;
+    }
+    int64_t cost = 0;
+    for (std::size_t i=1; i<path.size(); ++i)
+    {
+        cost += (path[i].x != path[i-1].x && path[i].y != path[i-1].y) ? 14 : 10;
+    }
+    return cost;
+}
+
+template<class TGenerator>
+double RunQueries(TGenerator& generator, const std::vector<std::pair<fge::AStar::Vector2i, fge::AStar::Vector2i> >& queries,
+                  std::vector<int64_t>& pathCosts)
+{
+    pathCosts.clear();
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& query : queries)
+    {
+        pathCosts.push_back(GetPathCost(generator.findPath(query.first, query.second)));
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end-start).count();
+}
+
+template<class TGenerator>
+void SetupGenerator(TGenerator& generator, const std::vector<uint8_t>& walls, int32_t size, bool diagonal)
+{
+    generator.setWorldSize({size, size});
+    generator.setDiagonalMovement(diagonal);
+    //Manhattan overestimate diagonal moves, the octagonal heuristic keep the paths optimal
+    generator.setHeuristic(diagonal ? &fge::AStar::Heuristic::octagonal : &fge::AStar::Heuristic::manhattan);
+    for (int32_t y=0; y<size; ++y)
+    {
+        for (int32_t x=0; x<size; ++x)
+        {
+            if (walls[static_cast<std::size_t>(y)*static_cast<std::size_t>(size) + static_cast<std::size_t>(x)] != 0)
+            {
+                generator.addCollision({x, y});
+            }
+        }
+    }
+}
+
+nlohmann::json RunSize(int32_t size, const Options& options)
+{
+    std::mt19937 generator{options._seed};
+    const auto walls = GenerateMaze(size, generator);
+
+    //Random queries between free cells
+    std::vector<fge::AStar::Vector2i> freeCells;
+    for (int32_t y=0; y<size; ++y)
+    {
+        for (int32_t x=0; x<size; ++x)
+        {
+            if (walls[static_cast<std::size_t>(y)*static_cast<std::size_t>(size) + static_cast<std::size_t>(x)] == 0)
+            {
+                freeCells.emplace_back(x, y);
+            }
+        }
+    }
+    std::vector<std::pair<fge::AStar::Vector2i, fge::AStar::Vector2i> > queries;
+    for (unsigned int i=0; i<options._queries; ++i)
+    {
+        queries.emplace_back(freeCells[generator() % freeCells.size()], freeCells[generator() % freeCells.size()]);
+    }
+
+    nlohmann::json result;
+    result["size"] = size;
+    result["queries"] = options._queries;
+
+    fge::AStar::Generator pathGenerator;
+    SetupGenerator(pathGenerator, walls, size, options._diagonal);
+    std::vector<int64_t> pathCosts;
+    const double time = RunQueries(pathGenerator, queries, pathCosts);
+    result["generator_ms"] = time;
+    result["generator_ms_per_query"] = time / static_cast<double>(std::max(options._queries, 1u));
+
+    //Other strategies, costs are compared with the plain A*
+    if (options._diagonal)
+    {
+        fge::AStar::Generator jumpPointGenerator;
+        SetupGenerator(jumpPointGenerator, walls, size, options._diagonal);
+        jumpPointGenerator.setStrategy(fge::AStar::Generator::Strategies::STRATEGY_JUMP_POINT);
+        std::vector<int64_t> jumpPointCosts;
+        const double jumpPointTime = RunQueries(jumpPointGenerator, queries, jumpPointCosts);
+        result["jump_point_ms"] = jumpPointTime;
+        result["jump_point_ms_per_query"] = jumpPointTime / static_cast<double>(std::max(options._queries, 1u));
+        result["jump_point_same_costs"] = jumpPointCosts == pathCosts;
+    }
+    else
+    {
+        result["jump_point_ms"] = nullptr;
+    }
+
+    fge::AStar::Generator hierarchicalGenerator;
+    SetupGenerator(hierarchicalGenerator, walls, size, options._diagonal);
+    hierarchicalGenerator.setStrategy(fge::AStar::Generator::Strategies::STRATEGY_HIERARCHICAL);
+    hierarchicalGenerator.setClusterSize(options._clusterSize);
+    {//The first query build the clusters
+        const auto start = std::chrono::steady_clock::now();
+        [[maybe_unused]] auto path = hierarchicalGenerator.findPath(freeCells.front(), freeCells.front());
+        const auto end = std::chrono::steady_clock::now();
+        result["hierarchical_build_ms"] = std::chrono::duration<double, std::milli>(end-start).count();
+    }
+    std::vector<int64_t> hierarchicalCosts;
+    const double hierarchicalTime = RunQueries(hierarchicalGenerator, queries, hierarchicalCosts);
+    result["hierarchical_ms"] = hierarchicalTime;
+    result["hierarchical_ms_per_query"] = hierarchicalTime / static_cast<double>(std::max(options._queries, 1u));
+    //Paths are near optimal, report the mean extra cost
+    double extraCost = 0.0;
+    std::size_t foundCount = 0;
+    for (std::size_t i=0; i<pathCosts.size(); ++i)
+    {
+        if (pathCosts[i] > 0 && hierarchicalCosts[i] > 0)
+        {
+            extraCost += static_cast<double>(hierarchicalCosts[i]) / static_cast<double>(pathCosts[i]) - 1.0;
+            ++foundCount;
+        }
+    }
+    result["hierarchical_extra_cost_ratio"] = foundCount > 0 ? extraCost / static_cast<double>(foundCount) : 0.0;
+
+    //Every agent going to the same target
+    {
+        std::vector<std::pair<fge::AStar::Vector2i, fge::AStar::Vector2i> > sharedQueries;
+        for (const auto& query : queries)
+        {
+            sharedQueries.emplace_back(query.first, queries.front().second);
+        }
+        std::vector<int64_t> sharedCosts;
+        const double sharedTime = RunQueries(pathGenerator, sharedQueries, sharedCosts);
+        result["shared_target_generator_ms"] = sharedTime;
+
+        fge::AStar::FlowField flowField;
+        std::vector<int64_t> flowFieldCosts;
+        const auto start = std::chrono::steady_clock::now();
+        flowField.compute(pathGenerator, {queries.front().second});
+        for (const auto& query : sharedQueries)
+        {
+            flowFieldCosts.push_back(GetPathCost(flowField.getPath(query.first)));
+        }
+        const auto end = std::chrono::steady_clock::now();
+        result["shared_target_flow_field_ms"] = std::chrono::duration<double, std::milli>(end-start).count();
+        result["shared_target_same_costs"] = flowFieldCosts == sharedCosts;
+    }
+
+    if (size <= options._legacyMaxSize)
+    {
+        legacy::Generator legacyGenerator;
+        SetupGenerator(legacyGenerator, walls, size, options._diagonal);
+        std::vector<int64_t> legacyPathCosts;
+        const double legacyTime = RunQueries(legacyGenerator, queries, legacyPathCosts);
+        result["legacy_ms"] = legacyTime;
+        result["legacy_ms_per_query"] = legacyTime / static_cast<double>(std::max(options._queries, 1u));
+        result["speedup"] = time > 0.0 ? legacyTime / time : 0.0;
+        //Both can choose a different path, but the cost must be the same
+        result["same_costs"] = pathCosts == legacyPathCosts;
+    }
+    else
+    {
+        result["legacy_ms"] = nullptr;
+    }
+    return result;
+}
+
+//Handle an argument of the benchmark, return false if it's unknown
+bool ParseOption(const std::string& arg, const std::string& value, Options& options)
+{
+    if (arg == "--sizes")
+    {
+        options._sizes = fge::benchmark::ParseList<int32_t>(value, [](const std::string& element){
+            return std::max(3, std::stoi(element));
+        });
+    }
+    else if (arg == "--queries")
+    {
+        options._queries = static_cast<unsigned int>(std::stoul(value));
+    }
+    else if (arg == "--legacy-max-size")
+    {
+        options._legacyMaxSize = std::stoi(value);
+    }
+    else if (arg == "--cluster-size")
+    {
+        options._clusterSize = std::stoi(value);
+    }
+    else if (arg == "--seed")
+    {
+        options._seed = static_cast<unsigned int>(std::stoul(value));
+    }
+    else if (arg == "--diagonal")
+    {
+        options._diagonal = value != "0";
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+}//end
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if ( !fge::benchmark::ParseArguments(argc, argv, options, [&](const std::string& arg, const std::string& value){
+        return ParseOption(arg, value, options);
+    }) )
+    {
+        return 1;
+    }
+
+    nlohmann::json report;
+    report["diagonal"] = options._diagonal;
+    report["results"] = nlohmann::json::array();
+    for (int32_t size : options._sizes)
+    {
+        report["results"].push_back(RunSize(size, options));
+    }
+
+    return fge::benchmark::WriteReport(report, options);
+}
@@ -0,0 +1,479 @@
+/*
+ * Headless render benchmark
+ *
+ * Replay the example scenes scaled up by parameters, the Scene is updated and drawn in an offscreen
+ * sf::RenderTexture (a software GL like Mesa llvmpipe is enough). A hidden window is only created
+ * to be passed to Scene::update(), some objects (like ObjRenderMap) take their size from it.
+ *
+ * The draw calls, vertices and texture binds are taken from the Scene SpriteBatch statistics,
+ * so they are only reported when the batching is enabled. Objects that don't implement drawBatched
+ * are counted as a single draw call and the offscreen targets of the objects (ObjRenderMap,
+ * ObjWindow, ObjLight ...) are not counted.
+ *
+ * usage: fgeRenderBenchmark [--scene all|tilemap|light|gui] [--scale N] [--frames N] [--warmup N]
+ *                           [--size WxH] [--batching on|off] [--resources PATH] [--output FILE]
+ *
+ * The report is written as JSON on the standard output or in the provided file.
+ */
+
+#include <FastEngine/C_scene.hpp>
+#include "FastEngine/extra/extra_function.hpp"
+#include "FastEngine/manager/texture_manager.hpp"
+#include "FastEngine/manager/font_manager.hpp"
+#include "FastEngine/object/C_objTilemap.hpp"
+#include "FastEngine/object/C_objLight.hpp"
+#include "FastEngine/object/C_objRenderMap.hpp"
+#include "FastEngine/object/C_objText.hpp"
+#include "FastEngine/object/C_objTextList.hpp"
+#include "FastEngine/object/C_objWindow.hpp"
+#include <SFML/Graphics/RenderTexture.hpp>
+#include "benchmark_common.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+struct Options : fge::benchmark::Options
+{
+    std::string _scene{"all"};
+    unsigned int _scale{1};
+    unsigned int _frames{300};
+    unsigned int _warmup{30};
+    sf::Vector2u _size{1280, 720};
+    bool _batching{true};
+    std::filesystem::path _resources{"resources"};
+};
+
+//Static rectangle obstacle
+class Obstacle : public fge::Object, public fge::LightObstacle
+{
+public:
+    Obstacle() = default;
+
+    FGE_OBJ_DEFAULT_COPYMETHOD(Obstacle)
+
+    void first(fge::Scene* scene) override
+    {
+        this->setDefaultLightSystem(scene);
+
+        this->g_vertices.clear();
+        this->g_vertices.append(sf::Vertex{{0.0f,0.0f}, sf::Color::Green});
+        this->g_vertices.append(sf::Vertex{{0.0f,40.0f}, sf::Color::Green});
+        this->g_vertices.append(sf::Vertex{{40.0f,0.0f}, sf::Color::Green});
+        this->g_vertices.append(sf::Vertex{{40.0f,40.0f}, sf::Color::Green});
+
+        this->updatePoints();
+    }
+
+    void moveObstacle(const sf::Vector2f& offset)
+    {
+        this->move(offset);
+        this->updatePoints();
+        this->invalidateObstacle();
+    }
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override
+    {
+        states.transform *= this->getTransform();
+        target.draw(this->g_vertices, states);
+    }
+
+    sf::FloatRect getGlobalBounds() const override
+    {
+        return this->getTransform().transformRect(this->g_vertices.getBounds());
+    }
+
+    const char* getClassName() const override
+    {
+        return "OBSTACLE";
+    }
+    const char* getReadableClassName() const override
+    {
+        return "obstacle";
+    }
+
+private:
+    void updatePoints()
+    {
+        this->_g_myPoints.resize(this->g_vertices.getVertexCount());
+        for (std::size_t i=0; i<this->g_vertices.getVertexCount(); ++i)
+        {
+            this->_g_myPoints[i] = this->getTransform().transformPoint(this->g_vertices[i].position);
+        }
+    }
+
+    sf::VertexArray g_vertices{sf::PrimitiveType::TriangleStrip};
+};
+
+//A benchmarked scene with its per frame animation
+struct BenchScene
+{
+    explicit BenchScene(const sf::RenderTarget& target) :
+            _event(target.getSize()),
+            _guiElementHandler(_event, target)
+    {
+        this->_guiElementHandler.setEventCallback(this->_event);
+        this->_scene.setCallbackContext({&this->_event, &this->_guiElementHandler});
+    }
+
+    fge::Event _event;
+    fge::GuiElementHandler _guiElementHandler;
+    fge::LightSystem _lightSystem;
+    fge::Scene _scene;
+    std::function<void(unsigned int frame)> _animate;
+};
+
+bool BuildTileMapScene(BenchScene& bench, const Options& options)
+{
+    nlohmann::json json;
+    if ( !fge::LoadJsonFromFile(options._resources / "tilemaps/tilemap_basic_1.json", json) )
+    {
+        return false;
+    }
+
+    //The tilemap is repeated on a scale*scale grid
+    auto tileMap = bench._scene.newObject(FGE_NEWOBJECT(fge::ObjTileMap), FGE_SCENE_PLAN_BACK);
+    tileMap->getObject()->_drawMode = fge::Object::DrawModes::DRAW_ALWAYS_DRAWN;
+    tileMap->getObject()->load(json, &bench._scene);
+    const sf::FloatRect bounds = tileMap->getObject()->getGlobalBounds();
+
+    for (unsigned int y=0; y<options._scale; ++y)
+    {
+        for (unsigned int x=0; x<options._scale; ++x)
+        {
+            if (x == 0 && y == 0)
+            {
+                continue;
+            }
+            auto copy = bench._scene.duplicateObject(tileMap->getSid());
+            copy->getObject()->setPosition(bounds.width*static_cast<float>(x), bounds.height*static_cast<float>(y));
+        }
+    }
+
+    //Scroll the view over the whole map
+    const sf::Vector2f mapSize{bounds.width*static_cast<float>(options._scale), bounds.height*static_cast<float>(options._scale)};
+    auto view = std::make_shared<sf::View>(sf::FloatRect{0.0f, 0.0f, static_cast<float>(options._size.x), static_cast<float>(options._size.y)});
+    bench._scene.setCustomView(view);
+    bench._animate = [view, mapSize](unsigned int frame){
+        const float t = static_cast<float>(frame) * 0.01f;
+        view->setCenter((0.5f + 0.5f*std::sin(t)) * mapSize.x, (0.5f + 0.5f*std::cos(t)) * mapSize.y);
+    };
+    return true;
+}
+
+bool BuildLightScene(BenchScene& bench, const Options& options)
+{
+    if ( !fge::texture::LoadFromFile("light_test", options._resources / "images/light_test.png") )
+    {
+        return false;
+    }
+    bench._scene._properties[FGE_LIGHT_PROPERTY_DEFAULT_LS] = &bench._lightSystem;
+
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<float> randX{0.0f, static_cast<float>(options._size.x)};
+    std::uniform_real_distribution<float> randY{0.0f, static_cast<float>(options._size.y)};
+
+    //The render map is drawn on top of the scene
+    auto renderMap = bench._scene.newObject(FGE_NEWOBJECT(fge::ObjRenderMap), FGE_SCENE_PLAN_HIGH_TOP);
+    renderMap->getObject<fge::ObjRenderMap>()->setClearColor(sf::Color{10,10,10,240});
+
+    std::vector<Obstacle*> movingObstacles;
+    for (unsigned int i=0; i<options._scale*8; ++i)
+    {
+        //The position must be set before first() is called
+        auto* obstacle = new Obstacle();
+        obstacle->setPosition(randX(generator), randY(generator));
+        bench._scene.newObject(FGE_NEWOBJECT_PTR(obstacle), FGE_SCENE_PLAN_MIDDLE);
+
+        if (i%4 == 0)
+        {
+            movingObstacles.push_back(obstacle);
+        }
+    }
+
+    std::vector<fge::ObjLight*> lights;
+    for (unsigned int i=0; i<options._scale; ++i)
+    {
+        auto light = bench._scene.newObject(FGE_NEWOBJECT(fge::ObjLight, "light_test", {randX(generator), randY(generator)}), FGE_SCENE_PLAN_MIDDLE);
+        light->getObject<fge::ObjLight>()->setColor(sf::Color{static_cast<sf::Uint8>(generator()), static_cast<sf::Uint8>(generator()), static_cast<sf::Uint8>(generator())});
+        light->getObject<fge::ObjLight>()->setScale(3.0f, 3.0f);
+        lights.push_back(light->getObject<fge::ObjLight>());
+    }
+
+    //Lights and a quarter of the obstacles are moving, so the shadows are computed every frames
+    bench._animate = [lights, movingObstacles](unsigned int frame){
+        const float t = static_cast<float>(frame) * 0.05f;
+        for (std::size_t i=0; i<lights.size(); ++i)
+        {
+            lights[i]->move(2.0f*std::cos(t + static_cast<float>(i)), 2.0f*std::sin(t + static_cast<float>(i)));
+        }
+        for (std::size_t i=0; i<movingObstacles.size(); ++i)
+        {
+            movingObstacles[i]->moveObstacle({std::sin(t + static_cast<float>(i)), std::cos(t + static_cast<float>(i))});
+        }
+    };
+    return true;
+}
+
+bool BuildGuiScene(BenchScene& bench, const Options& options, sf::RenderTarget& target)
+{
+    if ( !fge::texture::LoadFromFile("close", options._resources / "images/window/close.png") ||
+         !fge::texture::LoadFromFile("minimize", options._resources / "images/window/minimize.png") ||
+         !fge::texture::LoadFromFile("resize", options._resources / "images/window/resize.png") ||
+         !fge::texture::LoadFromFile("window", options._resources / "images/window/window.png") )
+    {
+        return false;
+    }
+
+    bench._scene.setLinkedRenderTarget(&target);
+
+    auto explainText = bench._scene.newObject(FGE_NEWOBJECT(fge::ObjText, "Render benchmark\n", "base", {}, 18), FGE_SCENE_PLAN_HIGH_TOP+1);
+    explainText->getObject<fge::ObjText>()->setFillColor(sf::Color::Black);
+
+    for (unsigned int i=0; i<options._scale; ++i)
+    {
+        auto* objWindow = bench._scene.newObject(FGE_NEWOBJECT(fge::ObjWindow), FGE_SCENE_PLAN_HIGH_TOP)->getObject<fge::ObjWindow>();
+        objWindow->setTextureClose("close");
+        objWindow->setTextureMinimize("minimize");
+        objWindow->setTextureResize("resize");
+        objWindow->getTileSet().setTexture("window");
+        objWindow->setPosition(static_cast<float>((i*40) % options._size.x), static_cast<float>((i*30) % options._size.y));
+
+        auto* objTextList = objWindow->_windowScene.newObject(FGE_NEWOBJECT(fge::ObjTextList))->getObject<fge::ObjTextList>();
+        for (unsigned int s=0; s<20; ++s)
+        {
+            objTextList->addString("line " + std::to_string(s) + " of the window " + std::to_string(i));
+        }
+        objTextList->setFont("base");
+        objTextList->move(20.0f, 20.0f);
+        objTextList->setTextScrollRatio(0.0f);
+    }
+
+    bench._animate = [](unsigned int){};
+    return true;
+}
+
+double Percentile(std::vector<double> values, double ratio)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<std::size_t>(ratio * static_cast<double>(values.size()-1));
+    return values[index];
+}
+
+nlohmann::json RunScene(const std::string& name, const Options& options, sf::RenderWindow& screen, sf::RenderTexture& target)
+{
+    nlohmann::json result;
+    result["scene"] = name;
+    result["scale"] = options._scale;
+    result["batching"] = options._batching;
+
+    BenchScene bench{target};
+    bool built = false;
+    if (name == "tilemap")
+    {
+        built = BuildTileMapScene(bench, options);
+    }
+    else if (name == "light")
+    {
+        built = BuildLightScene(bench, options);
+    }
+    else if (name == "gui")
+    {
+        built = BuildGuiScene(bench, options, target);
+    }
+
+    if (!built)
+    {
+        result["error"] = "unable to build the scene (check the resources path)";
+        return result;
+    }
+
+    bench._scene.setBatching(options._batching);
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(options._frames);
+    std::vector<double> updateTimes;
+    updateTimes.reserve(options._frames);
+    fge::SpriteBatch::Stats total;
+
+    for (unsigned int frame=0; frame<options._warmup+options._frames; ++frame)
+    {
+        bench._animate(frame);
+        bench._scene.getSpriteBatch().resetStats();
+
+        const auto start = std::chrono::steady_clock::now();
+        bench._scene.update(screen, bench._event, std::chrono::milliseconds{16});
+        const auto updated = std::chrono::steady_clock::now();
+
+        bench._scene.draw(target, true, sf::Color::White);
+        target.display();
+        const auto end = std::chrono::steady_clock::now();
+
+        if (frame < options._warmup)
+        {
+            continue;
+        }
+
+        updateTimes.push_back(std::chrono::duration<double, std::milli>(updated-start).count());
+        frameTimes.push_back(std::chrono::duration<double, std::milli>(end-start).count());
+
+        const auto& stats = bench._scene.getSpriteBatch().getStats();
+        total._drawCalls += stats._drawCalls;
+        total._vertexCount += stats._vertexCount;
+        total._textureBinds += stats._textureBinds;
+        total._batchedCount += stats._batchedCount;
+        total._fallbackCount += stats._fallbackCount;
+    }
+
+    const double frames = static_cast<double>(std::max(options._frames, 1u));
+    double sum = 0.0;
+    for (double time : frameTimes)
+    {
+        sum += time;
+    }
+    double updateSum = 0.0;
+    for (double time : updateTimes)
+    {
+        updateSum += time;
+    }
+
+    result["objects"] = bench._scene.getObjectSize();
+    result["frames"] = options._frames;
+    result["frame_time_ms"] = {
+        {"mean", sum / frames},
+        {"min", frameTimes.empty() ? 0.0 : *std::min_element(frameTimes.begin(), frameTimes.end())},
+        {"max", frameTimes.empty() ? 0.0 : *std::max_element(frameTimes.begin(), frameTimes.end())},
+        {"p50", Percentile(frameTimes, 0.50)},
+        {"p95", Percentile(frameTimes, 0.95)},
+        {"p99", Percentile(frameTimes, 0.99)}
+    };
+    result["update_time_ms"] = {
+        {"mean", updateSum / frames},
+        {"p95", Percentile(updateTimes, 0.95)}
+    };
+    if (options._batching)
+    {
+        result["per_frame"] = {
+            {"draw_calls", static_cast<double>(total._drawCalls) / frames},
+            {"vertices", static_cast<double>(total._vertexCount) / frames},
+            {"texture_binds", static_cast<double>(total._textureBinds) / frames},
+            {"batched_submissions", static_cast<double>(total._batchedCount) / frames},
+            {"fallback_submissions", static_cast<double>(total._fallbackCount) / frames}
+        };
+    }
+    else
+    {
+        //The Scene don't use the SpriteBatch
+        result["per_frame"] = nullptr;
+    }
+    return result;
+}
+
+//Handle an argument of the benchmark, return false if it's unknown
+bool ParseOption(const std::string& arg, const std::string& value, Options& options)
+{
+    if (arg == "--scene")
+    {
+        options._scene = value;
+    }
+    else if (arg == "--scale")
+    {
+        options._scale = std::max(1u, static_cast<unsigned int>(std::stoul(value)));
+    }
+    else if (arg == "--frames")
+    {
+        options._frames = static_cast<unsigned int>(std::stoul(value));
+    }
+    else if (arg == "--warmup")
+    {
+        options._warmup = static_cast<unsigned int>(std::stoul(value));
+    }
+    else if (arg == "--size")
+    {
+        const auto separator = value.find('x');
+        if (separator == std::string::npos)
+        {
+            throw std::invalid_argument("bad size format, expected WxH");
+        }
+        options._size.x = static_cast<unsigned int>(std::stoul(value.substr(0, separator)));
+        options._size.y = static_cast<unsigned int>(std::stoul(value.substr(separator+1)));
+    }
+    else if (arg == "--batching")
+    {
+        if (value != "on" && value != "off")
+        {
+            throw std::invalid_argument("bad batching value, expected on or off");
+        }
+        options._batching = value == "on";
+    }
+    else if (arg == "--resources")
+    {
+        options._resources = value;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+}//end
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if ( !fge::benchmark::ParseArguments(argc, argv, options, [&](const std::string& arg, const std::string& value){
+        return ParseOption(arg, value, options);
+    }) )
+    {
+        return 1;
+    }
+
+    sf::RenderWindow screen{sf::VideoMode{options._size.x, options._size.y}, "fgeRenderBenchmark", sf::Style::None};
+    screen.setVisible(false);
+
+    sf::RenderTexture target;
+    if ( !target.create(options._size.x, options._size.y) )
+    {
+        std::cerr << "unable to create the offscreen render target" << std::endl;
+        return 1;
+    }
+
+    fge::texture::Init();
+    fge::font::Init();
+    fge::font::LoadFromFile("base", options._resources / "fonts/SourceSansPro-Regular.ttf");
+
+    std::vector<std::string> scenes;
+    if (options._scene == "all")
+    {
+        scenes = {"tilemap", "light", "gui"};
+    }
+    else
+    {
+        scenes = {options._scene};
+    }
+
+    nlohmann::json report;
+    report["size"] = {options._size.x, options._size.y};
+    report["results"] = nlohmann::json::array();
+    for (const auto& scene : scenes)
+    {
+        report["results"].push_back(RunScene(scene, options, screen, target));
+    }
+
+    fge::texture::Uninit();
+    fge::font::Uninit();
+
+    return fge::benchmark::WriteReport(report, options);
+}
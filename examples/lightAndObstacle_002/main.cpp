@@ -41,10 +41,15 @@ public:
             this->setPosition( screen.mapPixelToCoords(event.getMousePixelPos()) );
         }
 
-        this->_g_myPoints.resize(this->g_vertices.getVertexCount());
+        fge::ListOfPoints points(this->g_vertices.getVertexCount());
         for (std::size_t i=0; i<this->g_vertices.getVertexCount(); ++i)
         {
-            this->_g_myPoints[i] = this->getTransform().transformPoint(this->g_vertices[i].position);
+            points[i] = this->getTransform().transformPoint(this->g_vertices[i].position);
+        }
+        if (points != this->_g_myPoints)
+        {//Only notify the light system when the obstacle have moved
+            this->_g_myPoints = std::move(points);
+            this->invalidateObstacle();
         }
     }
 
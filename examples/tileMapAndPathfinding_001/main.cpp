@@ -7,7 +7,7 @@
 #include "FastEngine/object/C_objText.hpp"
 
 //Create a pathFinder class object
-class PathFinder : public fge::Object
+class PathFinder : public fge::Object, public fge::Subscriber
 {
 public:
     PathFinder() = default;
@@ -41,27 +41,23 @@ public:
     }
     void setObstacle(fge::ObjTileMap* tileMap)
     {
-        //Clear the collisions list
-        this->g_pathGenerator.clearCollisions();
-
         //Get the front tile layer
         auto tileLayer = tileMap->getTileLayers().front();
 
-        //For every tiles
-        for (std::size_t x=0; x<tileLayer->getTiles().getSizeX(); ++x)
-        {
-            for (std::size_t y=0; y<tileLayer->getTiles().getSizeY(); ++y)
-            {
-                const auto& tile = tileLayer->getTiles().get(x, y);
-                auto tileSet = tile.getTileSet();
+        //Red tiles are the solid ones
+        tileLayer->setCollisionProperty("isred");
 
-                //Add every red tiles to the collisions list
-                if ( tileSet && tileSet->getTile(tileSet->getLocalId(tile.getGid()))->_properties["isred"].get<bool>().value_or(false) )
-                {
-                    this->g_pathGenerator.addCollision(static_cast<fge::AStar::Vector2i>(sf::Vector2<std::size_t>{x, y}));
-                }
-            }
-        }
+        //Use the collision bitmap of the layer directly
+        this->g_pathGenerator.setCollisions(static_cast<fge::AStar::Vector2i>(tileLayer->getTiles().getSize()),
+                                            tileLayer->getCollisions());
+
+        //Then follow the modified tiles one by one
+        tileLayer->_onCollisionChanged.add(new fge::CallbackFunctorObject(&PathFinder::onCollisionChanged, this), this);
+    }
+    void onCollisionChanged([[maybe_unused]] fge::TileLayer& tileLayer, std::size_t x, std::size_t y, bool solid)
+    {
+        this->g_pathGenerator.setCollision({static_cast<int32_t>(x), static_cast<int32_t>(y)}, solid);
+        this->generatePath();
     }
     void setGoal(const sf::Vector2f& globalPos)
     {
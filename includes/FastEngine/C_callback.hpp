@@ -19,13 +19,42 @@
 
 #include <FastEngine/fastengine_extern.hpp>
 #include <FastEngine/C_subscription.hpp>
-#include <forward_list>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
 #include <mutex>
 #include <memory>
+#include <new>
+#include <vector>
+
+#define FGE_CALLBACK_LAMBDA_BUFFER_SIZE (sizeof(void*)*4)
 
 namespace fge
 {
 
+namespace priv
+{
+
+///A CallbackHandler::call() in progress on the current thread
+struct CallbackCallFrame
+{
+    const void* _handler;
+    const fge::priv::CallbackCallFrame* _previous;
+};
+
+/**
+ * \brief Get the last CallbackHandler::call() in progress on the current thread
+ *
+ * The call stack is defined once in the library, so it's shared by every module
+ * (a callback called from a DLL can remove a callback from the executable).
+ *
+ * \return A reference to the call stack of the current thread
+ */
+FGE_API const fge::priv::CallbackCallFrame*& GetCallbackCallStack();
+
+}//end priv
+
 /**
  * \class CallbackFunctorBase
  * \ingroup callback
@@ -87,6 +116,9 @@ protected:
  * \ingroup callback
  * \brief Callback lambda (with/without capture)
  *
+ * A lambda that fit in FGE_CALLBACK_LAMBDA_BUFFER_SIZE bytes is stored inside the functor,
+ * bigger ones are allocated.
+ *
  * \tparam Types The list of arguments types passed to the lambda
  */
 template <class ... Types>
@@ -101,8 +133,11 @@ public:
      */
     template<typename TLambda>
     explicit CallbackLambda(const TLambda& lambda);
+    CallbackLambda(const fge::CallbackLambda<Types ...>& r) = delete;
     ~CallbackLambda() override;
 
+    fge::CallbackLambda<Types ...>& operator =(const fge::CallbackLambda<Types ...>& r) = delete;
+
     /**
      * \brief Call the callback function with the given arguments
      *
@@ -118,6 +153,7 @@ public:
     inline bool check(void* ptr) override;
 
 protected:
+    alignas(std::max_align_t) unsigned char g_buffer[FGE_CALLBACK_LAMBDA_BUFFER_SIZE];
     void* g_lambda;
     void (*g_executeLambda)(void *, Types...);
     void (*g_deleteLambda)(void *);
@@ -173,6 +209,14 @@ protected:
  * Every callback muse use the same template parameters Types than a handler.
  * This class is thread-safe.
  *
+ * The callbacks are stored in an immutable list that is replaced on every modification (copy-on-write),
+ * so call() never lock and never allocate. Old lists are released once no call() can use them anymore.
+ * A callback that is removed while a call() is in progress is not called anymore, and the removal
+ * blocks until the callback is not running in another thread (except if the removal is done from
+ * a callback of the same handler, in this case only the current thread is guaranteed).
+ * Removing a callback of another handler from a callback waits like any other removal, so two handlers
+ * must not remove callbacks of each other from their callbacks at the same time in different threads.
+ *
  * This class inherits from Subscription to be able to subscribe to it. When a subscriber is
  * added to a handler and is destroyed, all the callbacks related to this subscriber are automatically removed.
  *
@@ -245,6 +289,8 @@ public:
     /**
      * \brief Call all the callbacks with the given arguments
      *
+     * This method is lock-free, callbacks added during the call will be called by the next one.
+     *
      * \param args The list of arguments
      */
     void call(Types ... args);
@@ -263,14 +309,86 @@ private:
     using CalleePtr = std::unique_ptr<fge::CallbackFunctorBase<Types ...> >;
     struct CalleeData
     {
+        CalleeData(fge::CallbackHandler<Types ...>::CalleePtr&& f, fge::Subscriber* subscriber) :
+                _f(std::move(f)),
+                _subscriber(subscriber)
+        {}
+
         fge::CallbackHandler<Types ...>::CalleePtr _f;
         fge::Subscriber* _subscriber = nullptr;
+        std::atomic<bool> _active{true};
+    };
+    using CalleeDataPtr = std::unique_ptr<fge::CallbackHandler<Types ...>::CalleeData>;
+    using CalleeList = std::vector<fge::CallbackHandler<Types ...>::CalleeData*>;
+    using CalleeListPtr = std::unique_ptr<const fge::CallbackHandler<Types ...>::CalleeList>;
+
+    /**
+     * \brief Register a call() in the current epoch until destroyed
+     */
+    class CallGuard
+    {
+    public:
+        explicit CallGuard(fge::CallbackHandler<Types ...>& handler);
+        ~CallGuard();
+
+        CallGuard(const CallGuard& r) = delete;
+        CallGuard& operator =(const CallGuard& r) = delete;
+
+    private:
+        fge::CallbackHandler<Types ...>& g_handler;
+        uint32_t g_index;
+        fge::priv::CallbackCallFrame g_frame;
+        const fge::priv::CallbackCallFrame*& g_callStack;
     };
-    using CalleeList = std::forward_list<fge::CallbackHandler<Types ...>::CalleeData>;
 
-    fge::CallbackHandler<Types ...>::CalleeList g_callees;
+    /**
+     * \brief Remove the callbacks that match the predicate, the mutex must be locked
+     *
+     * The predicate is called in the calling order.
+     *
+     * \param predicate A function that return \b true if the callback must be removed
+     * \return \b true if at least one callback was removed
+     */
+    template<class TPredicate>
+    bool remove(TPredicate&& predicate);
+    /**
+     * \brief Replace the list used by call() with the current callbacks, the mutex must be locked
+     */
+    void publish();
+    /**
+     * \brief Release the old lists and removed callbacks when no call() can use them anymore
+     *
+     * \param wait If \b false, give up instead of waiting for the calls in progress
+     */
+    void synchronize(bool wait);
+    /**
+     * \brief Unregister a call() from an epoch and wake up the waiting synchronize() if it was the last one
+     *
+     * \param index The epoch index
+     */
+    void releaseReader(uint32_t index);
+    /**
+     * \brief Check if a call() of this handler is in progress on the current thread
+     *
+     * \return \b true if the current thread is in a callback of this handler
+     */
+    [[nodiscard]] bool isCalledByCurrentThread() const;
+
+    std::vector<fge::CallbackHandler<Types ...>::CalleeDataPtr> g_callees;
+    fge::CallbackHandler<Types ...>::CalleeListPtr g_calleesList;
+    std::atomic<const fge::CallbackHandler<Types ...>::CalleeList*> g_calleesSnapshot{nullptr};
+
+    std::vector<fge::CallbackHandler<Types ...>::CalleeDataPtr> g_retiredCallees;
+    std::vector<fge::CallbackHandler<Types ...>::CalleeListPtr> g_retiredCalleesLists;
+
+    std::atomic<uint32_t> g_epoch{0};
+    std::atomic<uint32_t> g_readers[2]{};
+    std::atomic<uint32_t> g_readersWaiting{0};
+    std::mutex g_readersMutex;
+    std::condition_variable g_readersCondition;
 
     mutable std::recursive_mutex g_mutex;
+    std::mutex g_synchronizeMutex;
 };
 
 }//end fge
@@ -61,17 +61,28 @@ bool CallbackFunctorObject<TObject, Types ...>::check(void* ptr)
 
 template <class ... Types>
 template<typename TLambda>
-CallbackLambda<Types ...>::CallbackLambda(const TLambda& lambda) :
-        g_lambda(new TLambda(lambda))
+CallbackLambda<Types ...>::CallbackLambda(const TLambda& lambda)
 {
+    if constexpr (sizeof(TLambda) <= FGE_CALLBACK_LAMBDA_BUFFER_SIZE && alignof(TLambda) <= alignof(std::max_align_t))
+    {
+        this->g_lambda = new (this->g_buffer) TLambda(lambda);
+        this->g_deleteLambda = [](void* lambdaPtr)
+        {
+            reinterpret_cast<TLambda*>(lambdaPtr)->~TLambda();
+        };
+    }
+    else
+    {
+        this->g_lambda = new TLambda(lambda);
+        this->g_deleteLambda = [](void* lambdaPtr)
+        {
+            delete reinterpret_cast<TLambda*>(lambdaPtr);
+        };
+    }
     this->g_executeLambda = [](void* lambdaPtr, Types... arguments)
     {
         return (*reinterpret_cast<TLambda*>(lambdaPtr))(arguments...);
     };
-    this->g_deleteLambda = [](void* lambdaPtr)
-    {
-        delete reinterpret_cast<TLambda*>(lambdaPtr);
-    };
 }
 template <class ... Types>
 CallbackLambda<Types ...>::~CallbackLambda()
@@ -95,94 +106,262 @@ bool CallbackLambda<Types ...>::check([[maybe_unused]] void* ptr)
 template <class ... Types>
 void CallbackHandler<Types ...>::clear()
 {
-    std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
-    this->detachAll();
-    this->g_callees.clear();
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        this->detachAll();
+        this->remove([]([[maybe_unused]] const typename fge::CallbackHandler<Types ...>::CalleeData& callee){
+            return true;
+        });
+    }
+    this->synchronize(true);
 }
 
 template <class ... Types>
 void CallbackHandler<Types ...>::add(fge::CallbackFunctorBase<Types ...>* callback, fge::Subscriber* subscriber)
 {
-    std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
-    this->attach(subscriber);
-    this->g_callees.push_front({typename fge::CallbackHandler<Types ...>::CalleePtr(callback), subscriber});
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        this->attach(subscriber);
+        //New callbacks are called first
+        this->g_callees.insert(this->g_callees.begin(),
+                               std::make_unique<typename fge::CallbackHandler<Types ...>::CalleeData>(typename fge::CallbackHandler<Types ...>::CalleePtr(callback), subscriber));
+        this->publish();
+    }
+    this->synchronize(false);
 }
 template <class ... Types>
 void CallbackHandler<Types ...>::delPtr(void* ptr)
 {
-    std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
-    typename fge::CallbackHandler<Types ...>::CalleeList::iterator prev = this->g_callees.before_begin();
-    for (typename fge::CallbackHandler<Types ...>::CalleeList::iterator it=this->g_callees.begin(); it!=this->g_callees.end(); ++it)
+    bool removed;
     {
-        if ( (*it)._f->check(ptr) )
-        {
-            if ( this->detachOnce( (*it)._subscriber ) == 0 )
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        bool done = false;
+        removed = this->remove([&](const typename fge::CallbackHandler<Types ...>::CalleeData& callee){
+            if ( done || !callee._f->check(ptr) )
             {
-                this->g_callees.erase_after(prev);
-                break;
+                return false;
             }
-            this->g_callees.erase_after(prev);
-            it = prev;
-        }
-        else
-        {
-            prev = it;
-        }
+            done = this->detachOnce(callee._subscriber) == 0;
+            return true;
+        });
+    }
+    if (removed)
+    {
+        this->synchronize(true);
     }
 }
 template <class ... Types>
 void CallbackHandler<Types ...>::del(fge::Subscriber* subscriber)
 {
-    std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
-    typename fge::CallbackHandler<Types ...>::CalleeList::iterator prev = this->g_callees.before_begin();
-    for (typename fge::CallbackHandler<Types ...>::CalleeList::iterator it=this->g_callees.begin(); it!=this->g_callees.end(); ++it)
+    bool removed;
     {
-        if ( (*it)._subscriber == subscriber )
-        {
-            if ( this->detachOnce( (*it)._subscriber ) == 0 )
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        bool done = false;
+        removed = this->remove([&](const typename fge::CallbackHandler<Types ...>::CalleeData& callee){
+            if ( done || callee._subscriber != subscriber )
             {
-                this->g_callees.erase_after(prev);
-                break;
+                return false;
             }
-            this->g_callees.erase_after(prev);
-            it = prev;
+            done = this->detachOnce(callee._subscriber) == 0;
+            return true;
+        });
+    }
+    if (removed)
+    {
+        this->synchronize(true);
+    }
+}
+
+template <class ... Types>
+void CallbackHandler<Types ...>::call(Types ... args)
+{
+    if (this->g_calleesSnapshot.load(std::memory_order_relaxed) == nullptr)
+    {
+        return;
+    }
+
+    typename fge::CallbackHandler<Types ...>::CallGuard guard(*this);
+    const auto* callees = this->g_calleesSnapshot.load(std::memory_order_acquire);
+    if (callees == nullptr)
+    {
+        return;
+    }
+
+    for (const auto* callee : *callees)
+    {
+        if ( callee->_active.load(std::memory_order_acquire) )
+        {
+            callee->_f->call(args ...);
         }
-        else
+    }
+}
+
+template <class ... Types>
+void CallbackHandler<Types ...>::onDetach(fge::Subscriber* subscriber)
+{
+    bool removed;
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        removed = this->remove([&](const typename fge::CallbackHandler<Types ...>::CalleeData& callee){
+            return callee._subscriber == subscriber;
+        });
+    }
+    if (removed)
+    {
+        this->synchronize(true);
+    }
+}
+
+template <class ... Types>
+template<class TPredicate>
+bool CallbackHandler<Types ...>::remove(TPredicate&& predicate)
+{
+    const std::size_t size = this->g_callees.size();
+    for (auto& callee : this->g_callees)
+    {
+        if ( predicate(*callee) )
+        {
+            callee->_active.store(false, std::memory_order_release);
+            this->g_retiredCallees.push_back(std::move(callee));
+        }
+    }
+    std::erase(this->g_callees, nullptr);
+
+    if (this->g_callees.size() == size)
+    {
+        return false;
+    }
+    this->publish();
+    return true;
+}
+template <class ... Types>
+void CallbackHandler<Types ...>::publish()
+{
+    if (this->g_calleesList)
+    {
+        this->g_retiredCalleesLists.push_back(std::move(this->g_calleesList));
+    }
+    if ( !this->g_callees.empty() )
+    {
+        auto callees = std::make_unique<typename fge::CallbackHandler<Types ...>::CalleeList>();
+        callees->reserve(this->g_callees.size());
+        for (const auto& callee : this->g_callees)
         {
-            prev = it;
+            callees->push_back(callee.get());
         }
+        this->g_calleesList = std::move(callees);
     }
+    this->g_calleesSnapshot.store(this->g_calleesList.get(), std::memory_order_release);
 }
+template <class ... Types>
+void CallbackHandler<Types ...>::synchronize(bool wait)
+{
+    if ( this->isCalledByCurrentThread() )
+    {//Waiting for our own call() would deadlock, the old lists are released later
+        return;
+    }
+
+    std::unique_lock<std::mutex> lckSynchronize(this->g_synchronizeMutex, std::defer_lock);
+    if (wait)
+    {
+        lckSynchronize.lock();
+    }
+    else if ( !lckSynchronize.try_lock() )
+    {
+        return;
+    }
+
+    std::vector<typename fge::CallbackHandler<Types ...>::CalleeDataPtr> retiredCallees;
+    std::vector<typename fge::CallbackHandler<Types ...>::CalleeListPtr> retiredCalleesLists;
+    {
+        std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+        retiredCallees.swap(this->g_retiredCallees);
+        retiredCalleesLists.swap(this->g_retiredCalleesLists);
+    }
 
+    //A call() can register in the old epoch just before the switch, so every call in progress
+    //is only guaranteed to be done after two switches
+    for (int i=0; i<2; ++i)
+    {
+        const uint32_t index = this->g_epoch.fetch_add(1) & 1;
+        if (this->g_readers[index].load() != 0)
+        {
+            if (!wait)
+            {
+                std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
+                this->g_retiredCallees.insert(this->g_retiredCallees.end(),
+                                              std::make_move_iterator(retiredCallees.begin()),
+                                              std::make_move_iterator(retiredCallees.end()));
+                this->g_retiredCalleesLists.insert(this->g_retiredCalleesLists.end(),
+                                                   std::make_move_iterator(retiredCalleesLists.begin()),
+                                                   std::make_move_iterator(retiredCalleesLists.end()));
+                return;
+            }
+
+            //The last reader notify only when a synchronize() is waiting
+            this->g_readersWaiting.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lckReaders(this->g_readersMutex);
+                this->g_readersCondition.wait(lckReaders, [&](){
+                    return this->g_readers[index].load() == 0;
+                });
+            }
+            this->g_readersWaiting.fetch_sub(1);
+        }
+    }
+}
 template <class ... Types>
-void CallbackHandler<Types ...>::call(Types ... args)
+void CallbackHandler<Types ...>::releaseReader(uint32_t index)
 {
-    std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
-    auto itCalleeNext = this->g_callees.begin();
-    for (auto itCallee=this->g_callees.begin(); itCallee!=this->g_callees.end(); itCallee=itCalleeNext)
+    if (this->g_readers[index].fetch_sub(1) == 1 && this->g_readersWaiting.load() != 0)
     {
-        ++itCalleeNext;
-        itCallee->_f->call(args ...);
+        //Locking the mutex ensures that the waiting thread is either before its check or sleeping
+        std::lock_guard<std::mutex> lckReaders(this->g_readersMutex);
+        this->g_readersCondition.notify_all();
     }
 }
 
 template <class ... Types>
-void CallbackHandler<Types ...>::onDetach(fge::Subscriber* subscriber)
+bool CallbackHandler<Types ...>::isCalledByCurrentThread() const
 {
-    std::lock_guard<std::recursive_mutex> lck(this->g_mutex);
-    typename fge::CallbackHandler<Types ...>::CalleeList::iterator prev = this->g_callees.before_begin();
-    for (typename fge::CallbackHandler<Types ...>::CalleeList::iterator it=this->g_callees.begin(); it!=this->g_callees.end(); ++it)
+    for (const auto* frame=fge::priv::GetCallbackCallStack(); frame!=nullptr; frame=frame->_previous)
     {
-        if ( (*it)._subscriber == subscriber )
+        if (frame->_handler == this)
         {
-            this->g_callees.erase_after(prev);
-            it = prev;
+            return true;
         }
-        else
+    }
+    return false;
+}
+
+//CallbackHandler::CallGuard
+
+template <class ... Types>
+CallbackHandler<Types ...>::CallGuard::CallGuard(fge::CallbackHandler<Types ...>& handler) :
+        g_handler(handler),
+        g_frame{&handler, nullptr},
+        g_callStack(fge::priv::GetCallbackCallStack())
+{
+    this->g_frame._previous = this->g_callStack;
+
+    for (;;)
+    {
+        const uint32_t epoch = handler.g_epoch.load();
+        this->g_index = epoch & 1;
+        handler.g_readers[this->g_index].fetch_add(1);
+        if (handler.g_epoch.load() == epoch)
         {
-            prev = it;
+            break;
         }
+        handler.releaseReader(this->g_index);
     }
+    this->g_callStack = &this->g_frame;
+}
+template <class ... Types>
+CallbackHandler<Types ...>::CallGuard::~CallGuard()
+{
+    this->g_callStack = this->g_frame._previous;
+    this->g_handler.releaseReader(this->g_index);
 }
 
 }//end fge
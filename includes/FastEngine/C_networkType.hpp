@@ -23,6 +23,7 @@
 #include <FastEngine/C_callback.hpp>
 #include <FastEngine/C_identity.hpp>
 #include <FastEngine/C_dataAccessor.hpp>
+#include <FastEngine/manager/tag_manager.hpp>
 #include <string>
 #include <memory>
 #include <vector>
@@ -246,6 +247,8 @@ private:
  * \class NetworkTypeTag
  * \ingroup network
  * \brief The network type for a tag
+ *
+ * The tag is interned at construction, only its presence is transmitted.
  */
 class FGE_API NetworkTypeTag : public NetworkTypeBase
 {
@@ -265,7 +268,7 @@ public:
 
 private:
     fge::TagList* g_typeSource;
-    std::string g_tag;
+    fge::tag::TagId g_tag;
 };
 
 /**
@@ -335,6 +338,10 @@ private:
  * \ingroup network
  * \brief The network type for a property
  *
+ * \warning The Property pointer is kept, so the source must not be stored in a PropertyList
+ * that can still change (adding or removing a property can move the others).
+ * Use the PropertyList overload in this case, the property is then looked up on every access.
+ *
  * \tparam T The type of the property
  */
 template <class T>
@@ -342,6 +349,15 @@ class NetworkTypeProperty : public NetworkTypeBase
 {
 public:
     NetworkTypeProperty(fge::Property* source);
+    /**
+     * \brief Constructor with a property inside a list
+     *
+     * The property is created if it doesn't exist.
+     *
+     * \param source The property list
+     * \param key The property key
+     */
+    NetworkTypeProperty(fge::PropertyList* source, const fge::PropertyKey& key);
     ~NetworkTypeProperty() override = default;
 
     const void* getSource() const override;
@@ -355,7 +371,11 @@ public:
     void forceUncheck() override;
 
 private:
+    fge::Property& getProperty() const;
+
     fge::Property* g_typeSource;
+    fge::PropertyList* g_typeSourceList;
+    fge::PropertyKey g_key;
 };
 
 /**
@@ -370,6 +390,7 @@ class NetworkTypePropertyList : public NetworkTypeBase
 {
 public:
     NetworkTypePropertyList(fge::PropertyList* source, const std::string& vname);
+    NetworkTypePropertyList(fge::PropertyList* source, const fge::PropertyKey& key);
     ~NetworkTypePropertyList() override = default;
 
     const void* getSource() const override;
@@ -386,7 +407,7 @@ public:
 
 private:
     fge::PropertyList* g_typeSource;
-    std::string g_vname;
+    fge::PropertyKey g_key;
 };
 
 /**
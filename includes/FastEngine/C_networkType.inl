@@ -80,19 +80,32 @@ template<class T>
 NetworkTypeProperty<T>::NetworkTypeProperty(fge::Property* source)
 {
     this->g_typeSource = source;
+    this->g_typeSourceList = nullptr;
     source->setType<T>();
 }
+template<class T>
+NetworkTypeProperty<T>::NetworkTypeProperty(fge::PropertyList* source, const fge::PropertyKey& key)
+{
+    this->g_typeSource = nullptr;
+    this->g_typeSourceList = source;
+    this->g_key = key;
+    source->getProperty(key).setType<T>();
+}
 
 template<class T>
 const void* NetworkTypeProperty<T>::getSource() const
 {
+    if (this->g_typeSourceList != nullptr)
+    {
+        return this->g_typeSourceList;
+    }
     return this->g_typeSource;
 }
 
 template <class T>
 bool NetworkTypeProperty<T>::applyData(fge::net::Packet& pck)
 {
-    pck >> this->g_typeSource->template setType<T>();
+    pck >> this->getProperty().template setType<T>();
 
     this->_onApplied.call();
     return true;
@@ -103,7 +116,7 @@ void NetworkTypeProperty<T>::packData(fge::net::Packet& pck, const fge::net::Ide
     auto it = this->_g_tableId.find(id);
     if (it != this->_g_tableId.end())
     {
-        pck << this->g_typeSource->template setType<T>();
+        pck << this->getProperty().template setType<T>();
 
         it->second &=~ fge::net::NetworkPerClientConfigByteMasks::CONFIG_BYTE_MODIFIED_CHECK;
     }
@@ -111,32 +124,46 @@ void NetworkTypeProperty<T>::packData(fge::net::Packet& pck, const fge::net::Ide
 template <class T>
 void NetworkTypeProperty<T>::packData(fge::net::Packet& pck)
 {
-    pck << this->g_typeSource->template setType<T>();
+    pck << this->getProperty().template setType<T>();
 }
 
 template <class T>
 bool NetworkTypeProperty<T>::check() const
 {
-    return this->g_typeSource->isModified();
+    return this->getProperty().isModified();
 }
 template <class T>
 void NetworkTypeProperty<T>::forceCheck()
 {
-    this->g_typeSource->setModifiedFlag(true);
+    this->getProperty().setModifiedFlag(true);
 }
 template <class T>
 void NetworkTypeProperty<T>::forceUncheck()
 {
-    this->g_typeSource->setModifiedFlag(false);
+    this->getProperty().setModifiedFlag(false);
+}
+
+template <class T>
+fge::Property& NetworkTypeProperty<T>::getProperty() const
+{
+    if (this->g_typeSourceList != nullptr)
+    {
+        return this->g_typeSourceList->getProperty(this->g_key);
+    }
+    return *this->g_typeSource;
 }
 
 ///NetworkTypePropertyList
 template <class T>
-NetworkTypePropertyList<T>::NetworkTypePropertyList(fge::PropertyList* source, const std::string& vname)
+NetworkTypePropertyList<T>::NetworkTypePropertyList(fge::PropertyList* source, const std::string& vname) :
+        NetworkTypePropertyList(source, fge::PropertyKey{vname})
+{}
+template <class T>
+NetworkTypePropertyList<T>::NetworkTypePropertyList(fge::PropertyList* source, const fge::PropertyKey& key)
 {
     this->g_typeSource = source;
-    this->g_vname = vname;
-    fge::Property& property = source->getProperty(vname);
+    this->g_key = key;
+    fge::Property& property = source->getProperty(this->g_key);
 
     property.setType<T>();
 }
@@ -150,7 +177,7 @@ const void* NetworkTypePropertyList<T>::getSource() const
 template <class T>
 bool NetworkTypePropertyList<T>::applyData(fge::net::Packet& pck)
 {
-    fge::Property& property = this->g_typeSource->getProperty(this->g_vname);
+    fge::Property& property = this->g_typeSource->getProperty(this->g_key);
 
     pck >> property.setType<T>();
 
@@ -163,7 +190,7 @@ void NetworkTypePropertyList<T>::packData(fge::net::Packet& pck, const fge::net:
     auto it = this->_g_tableId.find(id);
     if (it != this->_g_tableId.end())
     {
-        fge::Property& property = this->g_typeSource->getProperty(this->g_vname);
+        fge::Property& property = this->g_typeSource->getProperty(this->g_key);
 
         pck << property.setType<T>();
 
@@ -173,7 +200,7 @@ void NetworkTypePropertyList<T>::packData(fge::net::Packet& pck, const fge::net:
 template <class T>
 void NetworkTypePropertyList<T>::packData(fge::net::Packet& pck)
 {
-    fge::Property& property = this->g_typeSource->getProperty(this->g_vname);
+    fge::Property& property = this->g_typeSource->getProperty(this->g_key);
 
     pck << property.setType<T>();
 }
@@ -181,23 +208,23 @@ void NetworkTypePropertyList<T>::packData(fge::net::Packet& pck)
 template <class T>
 bool NetworkTypePropertyList<T>::check() const
 {
-    return this->g_typeSource->getProperty(this->g_vname).isModified();
+    return this->g_typeSource->getProperty(this->g_key).isModified();
 }
 template <class T>
 void NetworkTypePropertyList<T>::forceCheck()
 {
-    this->g_typeSource->getProperty(this->g_vname).setModifiedFlag(true);
+    this->g_typeSource->getProperty(this->g_key).setModifiedFlag(true);
 }
 template <class T>
 void NetworkTypePropertyList<T>::forceUncheck()
 {
-    this->g_typeSource->getProperty(this->g_vname).setModifiedFlag(false);
+    this->g_typeSource->getProperty(this->g_key).setModifiedFlag(false);
 }
 
 template <class T>
 const std::string& NetworkTypePropertyList<T>::getValueName() const
 {
-    return this->g_vname;
+    return this->g_key.getName();
 }
 
 ///NetworkTypeManual
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_C_NINESLICEMESH_HPP_INCLUDED
+#define _FGE_C_NINESLICEMESH_HPP_INCLUDED
+
+#include <FastEngine/fastengine_extern.hpp>
+#include <FastEngine/C_texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <array>
+#include <vector>
+
+namespace fge
+{
+
+class SpriteBatch;
+
+/**
+ * \class NineSliceMesh
+ * \ingroup graphics
+ * \brief A nine-slice frame built in one vertex array
+ *
+ * Corners keep their texture size, edges are stretched along the frame and the center
+ * fill the remaining area. Extra pieces can be added (like a title separator), they are
+ * drawn over the center and under the borders.
+ *
+ * The geometry is only rebuilt when the size, the texture or a slice change, or when the
+ * texture is moved in an atlas page (the texture coordinates are baked in the vertices).
+ * The whole frame is then drawn with one draw call.
+ */
+class FGE_API NineSliceMesh
+{
+public:
+    enum Slices : uint8_t
+    {
+        SLICE_TOP_LEFT,
+        SLICE_TOP,
+        SLICE_TOP_RIGHT,
+        SLICE_LEFT,
+        SLICE_CENTER,
+        SLICE_RIGHT,
+        SLICE_BOTTOM_LEFT,
+        SLICE_BOTTOM,
+        SLICE_BOTTOM_RIGHT,
+
+        SLICE_COUNT
+    };
+
+    NineSliceMesh() = default;
+
+    void setTexture(fge::Texture texture);
+    [[nodiscard]] const fge::Texture& getTexture() const;
+
+    /**
+     * \brief Set the texture rectangle of a slice
+     *
+     * \param slice The slice
+     * \param textureRect The texture rectangle
+     */
+    void setSlice(fge::NineSliceMesh::Slices slice, const sf::IntRect& textureRect);
+    [[nodiscard]] const sf::IntRect& getSlice(fge::NineSliceMesh::Slices slice) const;
+
+    void setSize(const sf::Vector2f& size);
+    [[nodiscard]] const sf::Vector2f& getSize() const;
+
+    /**
+     * \brief Set the distance between the center and the edges of the frame
+     *
+     * By default (a negative margin) the center exactly fill the area inside the borders.
+     *
+     * \param margin The margin or a negative value for the default behavior
+     */
+    void setCenterMargin(float margin);
+    [[nodiscard]] float getCenterMargin() const;
+
+    void setColor(const sf::Color& color);
+    [[nodiscard]] const sf::Color& getColor() const;
+
+    /**
+     * \brief Add a stretched piece drawn between the center and the borders
+     *
+     * \param textureRect The texture rectangle
+     * \param area The area of the piece in local coordinates
+     */
+    void addExtraPiece(const sf::IntRect& textureRect, const sf::FloatRect& area);
+    void clearExtraPieces();
+
+    /**
+     * \brief Get the number of vertices, the geometry is rebuilt if needed
+     *
+     * \return The number of vertices (6 by piece)
+     */
+    [[nodiscard]] std::size_t getVertexCount() const;
+    /**
+     * \brief Get the vertices as a triangle list, the geometry is rebuilt if needed
+     *
+     * \return The vertices
+     */
+    [[nodiscard]] const std::vector<sf::Vertex>& getVertices() const;
+
+#ifndef FGE_DEF_SERVER
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+    void drawBatched(fge::SpriteBatch& batch, sf::RenderStates states) const;
+#endif //FGE_DEF_SERVER
+
+private:
+    struct Piece
+    {
+        sf::IntRect _textureRect;
+        sf::FloatRect _area;
+    };
+
+    void ensureGeometryUpdate() const;
+    void addPiece(const sf::IntRect& textureRect, const sf::FloatRect& area) const;
+
+    fge::Texture g_texture;
+    std::array<sf::IntRect, fge::NineSliceMesh::SLICE_COUNT> g_slices{};
+    std::vector<fge::NineSliceMesh::Piece> g_extraPieces;
+    sf::Vector2f g_size;
+    float g_centerMargin{-1.0f};
+    sf::Color g_color{sf::Color::White};
+
+    mutable std::vector<sf::Vertex> g_vertices;
+    mutable sf::IntRect g_textureRect; ///< The area of the texture in its atlas page when the geometry was built
+    mutable bool g_geometryNeedUpdate{true};
+};
+
+}//end fge
+
+#endif // _FGE_C_NINESLICEMESH_HPP_INCLUDED
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_C_PROFILER_HPP_INCLUDED
+#define _FGE_C_PROFILER_HPP_INCLUDED
+
+#include <FastEngine/fastengine_extern.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define FGE_PROF_DEFAULT_BUFFER_CAPACITY 65536
+#define FGE_PROF_DEFAULT_TRACE_CAPACITY 1000000
+
+/**
+ * \ingroup time
+ * \brief Scene instrumentation macros
+ *
+ * These macros are only active when the engine is built with FGE_DEF_PROFILING
+ * (debug builds or the FGE_PROFILING CMake option), otherwise they compile out completely.
+ */
+#ifdef FGE_DEF_PROFILING
+    #define _FGE_PROF_CAT2(a_, b_) a_##b_
+    #define _FGE_PROF_CAT(a_, b_) _FGE_PROF_CAT2(a_, b_)
+    #define FGE_PROF_SCOPE(type_, name_) fge::prof::ScopedEvent _FGE_PROF_CAT(fgeProfScope_, __LINE__){type_, name_}
+    #define FGE_PROF_MARK(type_, name_) fge::prof::PushEvent(type_, name_)
+#else
+    #define FGE_PROF_SCOPE(type_, name_) ((void)0)
+    #define FGE_PROF_MARK(type_, name_) ((void)0)
+#endif //FGE_DEF_PROFILING
+
+namespace fge::prof
+{
+
+using Clock = std::chrono::steady_clock;
+
+enum class EventTypes : uint8_t
+{
+    EVENT_SCENE_UPDATE,
+    EVENT_SCENE_DRAW,
+    EVENT_OBJECT_UPDATE,
+    EVENT_OBJECT_DRAW,
+    EVENT_OBJECT_CULLED
+};
+
+/**
+ * \struct Event
+ * \ingroup time
+ * \brief A raw profiling event
+ *
+ * The name must point to a string with a static lifetime like the one returned by Object::getClassName().
+ */
+struct Event
+{
+    const char* _name{nullptr};
+    Clock::time_point _begin;
+    Clock::duration _duration{0};
+    fge::prof::EventTypes _type{fge::prof::EventTypes::EVENT_OBJECT_UPDATE};
+    uint32_t _threadIndex{0};
+};
+
+/**
+ * \struct ClassReport
+ * \ingroup time
+ * \brief Accumulated timings of every Object sharing a class name
+ */
+struct ClassReport
+{
+    std::string _className;
+    std::chrono::nanoseconds _updateTime{0};
+    std::chrono::nanoseconds _drawTime{0};
+    std::size_t _updateCount{0};
+    std::size_t _drawCount{0};
+    std::size_t _culledCount{0};
+};
+
+/**
+ * \struct Report
+ * \ingroup time
+ * \brief Accumulated timings since the last call to Collect()
+ *
+ * Classes are sorted by decreasing total time (update + draw).
+ */
+struct Report
+{
+    std::size_t _updateFrameCount{0};
+    std::size_t _drawFrameCount{0};
+    std::chrono::nanoseconds _updateTime{0};
+    std::chrono::nanoseconds _drawTime{0};
+    std::size_t _droppedEventCount{0};
+    std::vector<fge::prof::ClassReport> _classes;
+};
+
+/**
+ * \brief Enable or disable the recording of events at runtime
+ *
+ * Disabled by default, a disabled profiler only cost an atomic load per event.
+ *
+ * \param enabled \b true to enable the profiler
+ */
+FGE_API void SetEnabled(bool enabled);
+FGE_API bool IsEnabled();
+/**
+ * \brief Check if the engine was built with the Scene instrumentation
+ *
+ * \return \b true if FGE_DEF_PROFILING was defined when building the engine
+ */
+FGE_API bool IsCompiledIn();
+
+/**
+ * \brief Set the event capacity of the per-thread buffers
+ *
+ * Only affect threads that record their first event after this call.
+ * When a buffer is full, new events are dropped until the next Collect().
+ *
+ * \param capacity The capacity, rounded up to a power of two
+ */
+FGE_API void SetBufferCapacity(std::size_t capacity);
+/**
+ * \brief Set the maximum number of events kept for the Chrome trace
+ *
+ * \param capacity The number of events, 0 to disable the trace history
+ */
+FGE_API void SetTraceCapacity(std::size_t capacity);
+
+/**
+ * \brief Record an event in the buffer of the calling thread
+ *
+ * This function is lock-free, every thread own a single producer/single consumer ring buffer.
+ *
+ * \param event The event
+ */
+FGE_API void PushEvent(const fge::prof::Event& event);
+/**
+ * \brief Record an event without duration (like a culled Object)
+ *
+ * \param type The type of the event
+ * \param name The static name of the event
+ */
+FGE_API void PushEvent(fge::prof::EventTypes type, const char* name);
+
+/**
+ * \brief Drain every thread buffer and build a report
+ *
+ * Drained events are appended to the trace history.
+ * This function should be called by a single thread, typically once per frame.
+ *
+ * \return The report of the events recorded since the last call
+ */
+FGE_API fge::prof::Report Collect();
+
+/**
+ * \brief Dump the trace history as a Chrome trace JSON file
+ *
+ * The file can be opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * \param path The path of the file
+ * \return \b true if the file was written
+ */
+FGE_API bool DumpChromeTrace(const std::filesystem::path& path);
+FGE_API void ClearTrace();
+
+/**
+ * \class ScopedEvent
+ * \ingroup time
+ * \brief Record an event with the duration of its scope
+ */
+class ScopedEvent
+{
+public:
+    ScopedEvent(fge::prof::EventTypes type, const char* name) :
+            g_enabled(fge::prof::IsEnabled())
+    {
+        if (this->g_enabled)
+        {
+            this->g_event._type = type;
+            this->g_event._name = name;
+            this->g_event._begin = Clock::now();
+        }
+    }
+    ~ScopedEvent()
+    {
+        if (this->g_enabled)
+        {
+            this->g_event._duration = Clock::now() - this->g_event._begin;
+            fge::prof::PushEvent(this->g_event);
+        }
+    }
+
+    ScopedEvent(const ScopedEvent& r) = delete;
+    ScopedEvent& operator=(const ScopedEvent& r) = delete;
+
+private:
+    fge::prof::Event g_event;
+    bool g_enabled;
+};
+
+}//end fge::prof
+
+#endif // _FGE_C_PROFILER_HPP_INCLUDED
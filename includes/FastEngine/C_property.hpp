@@ -19,11 +19,16 @@
 
 #include "FastEngine/fastengine_extern.hpp"
 #include "FastEngine/extra/extra_string.hpp"
+#include <new>
 #include <string>
 #include <vector>
 #include <typeinfo>
+#include <type_traits>
 #include <optional>
 
+//Inline storage of a Property, always big enough for a std::string
+#define FGE_PROPERTY_BUFFER_SIZE (sizeof(std::string) > 24 ? sizeof(std::string) : 24)
+
 namespace fge
 {
 
@@ -35,6 +40,10 @@ using PdoubleType = double;
 class Property;
 using ParrayType = std::vector<fge::Property>;
 
+class PropertyClassWrapper;
+template<class T>
+class PropertyClassWrapperType;
+
 class FGE_API Property
 {
 public:
@@ -169,8 +178,26 @@ public:
     void setModifiedFlag(bool flag);
 
 private:
-    Property::Types g_type{Property::Types::PTYPE_NULL};
+    /*
+     * Strings are always stored in g_buffer (short strings don't allocate thanks to std::string SSO),
+     * trivially copyable classes are stored in g_buffer if they fit, other classes are allocated.
+     * In every case g_data._ptr points to the stored object.
+     */
+    template<class T>
+    static constexpr bool IsClassInline = std::is_trivially_copyable<T>::value &&
+                                          sizeof(fge::PropertyClassWrapperType<T>) <= FGE_PROPERTY_BUFFER_SIZE &&
+                                          alignof(fge::PropertyClassWrapperType<T>) <= alignof(std::string);
+
+    template<class T, class ... TArgs>
+    fge::PropertyClassWrapper* createClass(TArgs&& ... args);
+
+    [[nodiscard]] bool isInline() const;
+    void copyFrom(const fge::Property& val);
+    void moveFrom(fge::Property&& val) noexcept;
+
     Property::Data g_data{};
+    alignas(std::string) unsigned char g_buffer[FGE_PROPERTY_BUFFER_SIZE];
+    Property::Types g_type{Property::Types::PTYPE_NULL};
     bool g_isSigned{};
     bool g_isModified{false};
 };
@@ -186,6 +213,8 @@ public:
     [[nodiscard]] virtual std::string toString() const = 0;
 
     [[nodiscard]] virtual fge::PropertyClassWrapper* copy() const = 0;
+    //Copy in the provided storage with a placement new
+    virtual fge::PropertyClassWrapper* copyTo(void* buffer) const = 0;
 
     virtual bool tryToCopy(const fge::PropertyClassWrapper* val) = 0;
 
@@ -221,6 +250,7 @@ public:
     [[nodiscard]] std::string toString() const override;
 
     [[nodiscard]] fge::PropertyClassWrapper* copy() const override;
+    fge::PropertyClassWrapper* copyTo(void* buffer) const override;
 
     bool tryToCopy(const fge::PropertyClassWrapper* val) override;
 
@@ -55,7 +55,7 @@ Property::Property(const T& val) :
     else if constexpr ( std::is_same<std::remove_reference_t<T>, std::string>::value )
     {
         this->g_type = fge::Property::Types::PTYPE_STRING;
-        this->g_data._ptr = new std::string(val);
+        this->g_data._ptr = new (this->g_buffer) std::string(val);
     }
     else if constexpr ( std::is_pointer<std::remove_reference_t<T> >::value )
     {
@@ -65,7 +65,7 @@ Property::Property(const T& val) :
     else
     {
         this->g_type = fge::Property::Types::PTYPE_CLASS;
-        this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<std::remove_reference_t<T> >(val));
+        this->g_data._ptr = this->createClass<std::remove_reference_t<T>>(val);
     }
 }
 template<class T,
@@ -104,7 +104,7 @@ Property::Property(T&& val) :
     else if constexpr ( std::is_same<std::remove_reference_t<T>, std::string>::value )
     {
         this->g_type = fge::Property::Types::PTYPE_STRING;
-        this->g_data._ptr = new std::string(std::forward<T>(val));
+        this->g_data._ptr = new (this->g_buffer) std::string(std::forward<T>(val));
     }
     else if constexpr ( std::is_pointer<std::remove_reference_t<T> >::value )
     {
@@ -114,7 +114,7 @@ Property::Property(T&& val) :
     else
     {
         this->g_type = fge::Property::Types::PTYPE_CLASS;
-        this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<std::remove_reference_t<T> >(std::forward<T>(val)));
+        this->g_data._ptr = this->createClass<std::remove_reference_t<T>>(std::forward<T>(val));
     }
 }
 
@@ -133,6 +133,19 @@ fge::Property& Property::operator= (T&& val)
     return *this;
 }
 
+template<class T, class ... TArgs>
+fge::PropertyClassWrapper* Property::createClass(TArgs&& ... args)
+{
+    if constexpr (fge::Property::IsClassInline<T>)
+    {
+        return static_cast<fge::PropertyClassWrapper*>(new (this->g_buffer) fge::PropertyClassWrapperType<T>(std::forward<TArgs>(args) ...));
+    }
+    else
+    {
+        return static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<T>(std::forward<TArgs>(args) ...));
+    }
+}
+
 template<class T>
 T& Property::setType()
 {
@@ -184,7 +197,7 @@ T& Property::setType()
         {
             this->clear();
             this->g_type = fge::Property::Types::PTYPE_STRING;
-            this->g_data._ptr = new std::string();
+            this->g_data._ptr = new (this->g_buffer) std::string();
         }
 
         return *reinterpret_cast<std::string*>(this->g_data._ptr);
@@ -205,7 +218,7 @@ T& Property::setType()
         {
             this->clear();
             this->g_type = fge::Property::Types::PTYPE_CLASS;
-            this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<std::remove_reference_t<T> >());
+            this->g_data._ptr = this->createClass<std::remove_reference_t<T>>();
             return reinterpret_cast<fge::PropertyClassWrapperType<std::remove_reference_t<T>>* >(this->g_data._ptr)->_data;
         }
         else
@@ -218,7 +231,7 @@ T& Property::setType()
             {
                 this->clear();
                 this->g_type = fge::Property::Types::PTYPE_CLASS;
-                this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<std::remove_reference_t<T>>());
+                this->g_data._ptr = this->createClass<std::remove_reference_t<T>>();
                 return reinterpret_cast<fge::PropertyClassWrapperType<std::remove_reference_t<T>>*>(this->g_data._ptr)->_data;
             }
         }
@@ -339,7 +352,7 @@ bool Property::set(const T& val)
             if (this->g_type == fge::Property::Types::PTYPE_NULL)
             {
                 this->g_type = fge::Property::Types::PTYPE_STRING;
-                this->g_data._ptr = new std::string(val);
+                this->g_data._ptr = new (this->g_buffer) std::string(val);
                 return true;
             }
             else
@@ -377,7 +390,7 @@ bool Property::set(const T& val)
             if (this->g_type == fge::Property::Types::PTYPE_NULL)
             {
                 this->g_type = fge::Property::Types::PTYPE_CLASS;
-                this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<std::remove_reference_t<T> >(val));
+                this->g_data._ptr = this->createClass<std::remove_reference_t<T>>(val);
                 return true;
             }
             else
@@ -471,7 +484,7 @@ bool Property::set(T&& val)
             if (this->g_type == fge::Property::Types::PTYPE_NULL)
             {
                 this->g_type = fge::Property::Types::PTYPE_STRING;
-                this->g_data._ptr = new std::string( std::forward<T>(val) );
+                this->g_data._ptr = new (this->g_buffer) std::string( std::forward<T>(val) );
                 return true;
             }
             else
@@ -509,7 +522,7 @@ bool Property::set(T&& val)
             if (this->g_type == fge::Property::Types::PTYPE_NULL)
             {
                 this->g_type = fge::Property::Types::PTYPE_CLASS;
-                this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<std::remove_reference_t<T>>(std::forward<T>(val)));
+                this->g_data._ptr = this->createClass<std::remove_reference_t<T>>(std::forward<T>(val));
                 return true;
             }
             else
@@ -1030,6 +1043,11 @@ fge::PropertyClassWrapper* PropertyClassWrapperType<T>::copy() const
 {
     return static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<T>(this->_data));
 }
+template<class T>
+fge::PropertyClassWrapper* PropertyClassWrapperType<T>::copyTo(void* buffer) const
+{
+    return static_cast<fge::PropertyClassWrapper*>(new (buffer) fge::PropertyClassWrapperType<T>(this->_data));
+}
 
 template<class T>
 bool PropertyClassWrapperType<T>::tryToCopy(const fge::PropertyClassWrapper* val)
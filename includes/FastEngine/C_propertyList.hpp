@@ -17,18 +17,90 @@
 #ifndef _FGE_C_PROPERTYLIST_HPP_INCLUDED
 #define _FGE_C_PROPERTYLIST_HPP_INCLUDED
 
+#include <FastEngine/fastengine_extern.hpp>
 #include <FastEngine/C_property.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <stdexcept>
 
+#define FGE_PROPERTY_KEY_BAD_ID std::numeric_limits<fge::PropertyKey::Id>::max()
+
 namespace fge
 {
 
+/**
+ * \class PropertyKey
+ * \ingroup utility
+ * \brief An interned property name
+ *
+ * Every name is registered once in a global table and get a unique id, comparing or
+ * looking up a key is then done without hashing the string.
+ * Keys used on a hot path should be created once, like a static variable :
+ * \code
+ * static const fge::PropertyKey key{"myProperty"};
+ * list.getProperty(key);
+ * \endcode
+ *
+ * The global table is thread-safe and names are never removed.
+ */
+class FGE_API PropertyKey
+{
+public:
+    using Id = uint32_t;
+
+    PropertyKey() = default;
+    /**
+     * \brief Get (or register) the key of a name
+     *
+     * \param name The property name
+     */
+    explicit PropertyKey(const std::string& name);
+    explicit PropertyKey(const char* name);
+
+    /**
+     * \brief Get the key of a name without registering it
+     *
+     * \param name The property name
+     * \return The key or an invalid key if the name was never registered
+     */
+    [[nodiscard]] static fge::PropertyKey find(const std::string& name);
+
+    [[nodiscard]] inline fge::PropertyKey::Id getId() const { return this->g_id; }
+    [[nodiscard]] inline bool isValid() const { return this->g_id != FGE_PROPERTY_KEY_BAD_ID; }
+    /**
+     * \brief Get the name of the key
+     *
+     * \return The name or an empty string if the key is invalid
+     */
+    [[nodiscard]] const std::string& getName() const;
+
+    [[nodiscard]] inline bool operator==(const fge::PropertyKey& r) const { return this->g_id == r.g_id; }
+    [[nodiscard]] inline bool operator!=(const fge::PropertyKey& r) const { return this->g_id != r.g_id; }
+    [[nodiscard]] inline bool operator<(const fge::PropertyKey& r) const { return this->g_id < r.g_id; }
+
+private:
+    fge::PropertyKey::Id g_id{FGE_PROPERTY_KEY_BAD_ID};
+};
+
+/**
+ * \class PropertyList
+ * \ingroup utility
+ * \brief A list of named properties
+ *
+ * Properties are stored in a vector sorted by key id, so a lookup is a binary search
+ * on integers and a copy doesn't copy any string.
+ *
+ * \warning Adding or removing a property invalidate the references and iterators of the list.
+ * \see NetworkTypeProperty
+ */
 class PropertyList
 {
 public:
-    using PropertyListType = std::unordered_map<std::string, fge::Property>;
+    using PropertyListType = std::vector<std::pair<fge::PropertyKey, fge::Property> >;
 
     inline PropertyList() = default;
     inline PropertyList(const PropertyList& r) = default;
@@ -39,21 +111,33 @@ public:
     inline PropertyList& operator=(PropertyList&& r) noexcept = default;
 
     inline void delAllProperties();
+    inline void delProperty(const fge::PropertyKey& key);
     inline void delProperty(const std::string& key);
 
+    inline bool checkProperty(const fge::PropertyKey& key) const;
     inline bool checkProperty(const std::string& key) const;
 
+    inline void setProperty(const fge::PropertyKey& key, const fge::Property& value);
+    inline void setProperty(const fge::PropertyKey& key, fge::Property&& value);
     inline void setProperty(const std::string& key, const fge::Property& value);
     inline void setProperty(const std::string& key, fge::Property&& value);
 
+    template <typename T>
+    inline T* getPropertyType(const fge::PropertyKey& key);
+    template <typename T>
+    inline const T* getPropertyType(const fge::PropertyKey& key) const;
     template <typename T>
     inline T* getPropertyType(const std::string& key);
     template <typename T>
     inline const T* getPropertyType(const std::string& key) const;
 
+    inline fge::Property& getProperty(const fge::PropertyKey& key);
+    inline const fge::Property& getProperty(const fge::PropertyKey& key) const;
     inline fge::Property& getProperty(const std::string& key);
     inline const fge::Property& getProperty(const std::string& key) const;
 
+    inline fge::Property& operator[] (const fge::PropertyKey& key);
+    inline const fge::Property& operator[] (const fge::PropertyKey& key) const;
     inline fge::Property& operator[] (const std::string& key);
     inline const fge::Property& operator[] (const std::string& key) const;
 
@@ -64,6 +148,8 @@ public:
     inline fge::PropertyList::PropertyListType::const_iterator begin() const;
     inline fge::PropertyList::PropertyListType::const_iterator end() const;
 
+    inline fge::PropertyList::PropertyListType::const_iterator find(const fge::PropertyKey& key) const;
+    inline fge::PropertyList::PropertyListType::iterator find(const fge::PropertyKey& key);
     inline fge::PropertyList::PropertyListType::const_iterator find(const std::string& key) const;
     inline fge::PropertyList::PropertyListType::iterator find(const std::string& key);
 
@@ -71,6 +157,9 @@ public:
     inline std::size_t countAllModificationFlags() const;
 
 private:
+    inline fge::PropertyList::PropertyListType::iterator lowerBound(const fge::PropertyKey& key);
+    inline fge::PropertyList::PropertyListType::const_iterator lowerBound(const fge::PropertyKey& key) const;
+
     fge::PropertyList::PropertyListType g_data;
 };
 
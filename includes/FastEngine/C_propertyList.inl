@@ -21,67 +21,118 @@ void PropertyList::delAllProperties()
 {
     this->g_data.clear();
 }
+void PropertyList::delProperty(const fge::PropertyKey& key)
+{
+    auto it = this->lowerBound(key);
+    if (it != this->g_data.end() && it->first == key)
+    {
+        this->g_data.erase(it);
+    }
+}
 void PropertyList::delProperty(const std::string& key)
 {
-    this->g_data.erase(key);
+    this->delProperty(fge::PropertyKey::find(key));
 }
 
+bool PropertyList::checkProperty(const fge::PropertyKey& key) const
+{
+    return this->find(key) != this->g_data.cend();
+}
 bool PropertyList::checkProperty(const std::string& key) const
 {
-    return this->g_data.find(key) != this->g_data.cend();
+    return this->find(key) != this->g_data.cend();
 }
 
+void PropertyList::setProperty(const fge::PropertyKey& key, const fge::Property& value)
+{
+    (*this)[key] = value;
+}
+void PropertyList::setProperty(const fge::PropertyKey& key, fge::Property&& value)
+{
+    (*this)[key] = std::move(value);
+}
 void PropertyList::setProperty(const std::string& key, const fge::Property& value)
 {
-    this->g_data[key] = value;
+    (*this)[fge::PropertyKey{key}] = value;
 }
 void PropertyList::setProperty(const std::string& key, fge::Property&& value)
 {
-    this->g_data[key] = std::move(value);
+    (*this)[fge::PropertyKey{key}] = std::move(value);
 }
 
 template <typename T>
-T* PropertyList::getPropertyType(const std::string& key)
+T* PropertyList::getPropertyType(const fge::PropertyKey& key)
 {
-    return this->g_data[key].getPtr<T>();
+    return (*this)[key].getPtr<T>();
 }
 template <typename T>
-const T* PropertyList::getPropertyType(const std::string& key) const
+const T* PropertyList::getPropertyType(const fge::PropertyKey& key) const
 {
-    auto it = this->g_data.find(key);
+    auto it = this->find(key);
     if (it != this->g_data.cend())
     {
         return it->second.getPtr<T>();
     }
     return nullptr;
 }
+template <typename T>
+T* PropertyList::getPropertyType(const std::string& key)
+{
+    return (*this)[fge::PropertyKey{key}].getPtr<T>();
+}
+template <typename T>
+const T* PropertyList::getPropertyType(const std::string& key) const
+{
+    return this->getPropertyType<T>(fge::PropertyKey::find(key));
+}
 
+fge::Property& PropertyList::getProperty(const fge::PropertyKey& key)
+{
+    return (*this)[key];
+}
+const fge::Property& PropertyList::getProperty(const fge::PropertyKey& key) const
+{
+    return (*this)[key];
+}
 fge::Property& PropertyList::getProperty(const std::string& key)
 {
-    return this->g_data[key];
+    return (*this)[fge::PropertyKey{key}];
 }
 const fge::Property& PropertyList::getProperty(const std::string& key) const
 {
-    auto it = this->g_data.find(key);
+    return (*this)[fge::PropertyKey::find(key)];
+}
+
+fge::Property& PropertyList::operator[] (const fge::PropertyKey& key)
+{
+    if ( !key.isValid() )
+    {
+        throw std::logic_error("invalid key !");
+    }
+
+    auto it = this->lowerBound(key);
+    if (it != this->g_data.end() && it->first == key)
+    {
+        return it->second;
+    }
+    return this->g_data.emplace(it, key, fge::Property{})->second;
+}
+const fge::Property& PropertyList::operator[] (const fge::PropertyKey& key) const
+{
+    auto it = this->find(key);
     if (it != this->g_data.cend())
     {
         return it->second;
     }
     throw std::logic_error("key not found !");
 }
-
 fge::Property& PropertyList::operator[] (const std::string& key)
 {
-    return this->g_data[key];
+    return (*this)[fge::PropertyKey{key}];
 }
 const fge::Property& PropertyList::operator[] (const std::string& key) const
 {
-    auto it = this->g_data.find(key);
-    if (it != this->g_data.cend())
-    {
-        return it->second;
-    }
-    throw std::logic_error("key not found !");
+    return (*this)[fge::PropertyKey::find(key)];
 }
 
 std::size_t PropertyList::getPropertiesSize() const
@@ -106,13 +157,31 @@ fge::PropertyList::PropertyListType::const_iterator PropertyList::end() const
     return this->g_data.end();
 }
 
+fge::PropertyList::PropertyListType::const_iterator PropertyList::find(const fge::PropertyKey& key) const
+{
+    auto it = this->lowerBound(key);
+    if (it != this->g_data.cend() && it->first == key)
+    {
+        return it;
+    }
+    return this->g_data.cend();
+}
+fge::PropertyList::PropertyListType::iterator PropertyList::find(const fge::PropertyKey& key)
+{
+    auto it = this->lowerBound(key);
+    if (it != this->g_data.end() && it->first == key)
+    {
+        return it;
+    }
+    return this->g_data.end();
+}
 fge::PropertyList::PropertyListType::const_iterator PropertyList::find(const std::string& key) const
 {
-    return this->g_data.find(key);
+    return this->find(fge::PropertyKey::find(key));
 }
 fge::PropertyList::PropertyListType::iterator PropertyList::find(const std::string& key)
 {
-    return this->g_data.find(key);
+    return this->find(fge::PropertyKey::find(key));
 }
 
 void PropertyList::clearAllModificationFlags()
@@ -137,4 +206,15 @@ std::size_t PropertyList::countAllModificationFlags() const
     return counter;
 }
 
+fge::PropertyList::PropertyListType::iterator PropertyList::lowerBound(const fge::PropertyKey& key)
+{
+    return std::lower_bound(this->g_data.begin(), this->g_data.end(), key,
+                            [](const auto& data, const fge::PropertyKey& k){ return data.first < k; });
+}
+fge::PropertyList::PropertyListType::const_iterator PropertyList::lowerBound(const fge::PropertyKey& key) const
+{
+    return std::lower_bound(this->g_data.cbegin(), this->g_data.cend(), key,
+                            [](const auto& data, const fge::PropertyKey& k){ return data.first < k; });
+}
+
 }//end fge
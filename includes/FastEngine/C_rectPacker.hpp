@@ -0,0 +1,93 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_C_RECTPACKER_HPP_INCLUDED
+#define _FGE_C_RECTPACKER_HPP_INCLUDED
+
+#include <FastEngine/fastengine_extern.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <optional>
+#include <vector>
+
+namespace fge
+{
+
+/**
+ * \class RectPacker
+ * \ingroup graphics
+ * \brief A skyline bottom-left rectangle bin packer
+ *
+ * Used to pack many small images in a bigger one, like texture atlas pages.
+ */
+class FGE_API RectPacker
+{
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param size The size of the bin
+     * \param padding The number of empty pixels kept on the right and bottom of every rectangle
+     */
+    explicit RectPacker(const sf::Vector2u& size={0,0}, unsigned int padding=0);
+
+    /**
+     * \brief Reset the bin with a new size and padding
+     *
+     * \param size The size of the bin
+     * \param padding The padding of every rectangle
+     */
+    void reset(const sf::Vector2u& size, unsigned int padding=0);
+    /**
+     * \brief Remove every rectangle from the bin
+     */
+    void clear();
+
+    /**
+     * \brief Insert a rectangle in the bin
+     *
+     * \param size The size of the rectangle
+     * \return The area of the rectangle in the bin or std::nullopt if there is no more room
+     */
+    [[nodiscard]] std::optional<sf::IntRect> insert(const sf::Vector2u& size);
+
+    [[nodiscard]] const sf::Vector2u& getSize() const;
+    [[nodiscard]] unsigned int getPadding() const;
+    /**
+     * \brief Get the ratio of the bin area used by the inserted rectangles
+     *
+     * \return The ratio between 0 and 1
+     */
+    [[nodiscard]] float getOccupancy() const;
+
+private:
+    struct SkylineNode
+    {
+        unsigned int _x;
+        unsigned int _y;
+        unsigned int _width;
+    };
+
+    [[nodiscard]] std::optional<unsigned int> fit(std::size_t index, unsigned int width, unsigned int height) const;
+
+    sf::Vector2u g_size;
+    unsigned int g_padding;
+    std::vector<fge::RectPacker::SkylineNode> g_skyline;
+    std::size_t g_usedArea{0};
+};
+
+}//end fge
+
+#endif // _FGE_C_RECTPACKER_HPP_INCLUDED
@@ -25,9 +25,14 @@
 #include <FastEngine/C_commandHandler.hpp>
 #include <FastEngine/C_callback.hpp>
 #include <FastEngine/C_identity.hpp>
+#include <FastEngine/manager/reg_manager.hpp>
+#include <FastEngine/C_spriteBatch.hpp>
 #include <string>
+#include <functional>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <memory>
 
 #define FGE_SCENE_PLAN_HIDE_BACK (FGE_SCENE_PLAN_MIDDLE-4)
@@ -42,6 +47,19 @@
 #define FGE_SCENE_BAD_PLANDEPTH std::numeric_limits<fge::ObjectPlanDepth>::max()
 #define FGE_SCENE_BAD_PLAN std::numeric_limits<fge::ObjectPlan>::max()
 
+#define FGE_SCENE_NETWORK_SID_BEGIN fge::ObjectSid{0}
+#define FGE_SCENE_NETWORK_SID_END fge::ObjectSid{0x80000000}
+#define FGE_SCENE_LOCAL_SID_BEGIN FGE_SCENE_NETWORK_SID_END
+#define FGE_SCENE_LOCAL_SID_END FGE_SCENE_BAD_SID
+
+#ifdef FGE_DEF_SERVER
+    #define FGE_SCENE_DEFAULT_SID_BEGIN FGE_SCENE_NETWORK_SID_BEGIN
+    #define FGE_SCENE_DEFAULT_SID_END FGE_SCENE_NETWORK_SID_END
+#else
+    #define FGE_SCENE_DEFAULT_SID_BEGIN FGE_SCENE_LOCAL_SID_BEGIN
+    #define FGE_SCENE_DEFAULT_SID_END FGE_SCENE_LOCAL_SID_END
+#endif //FGE_DEF_SERVER
+
 #define FGE_SCENE_LIMIT_NAMESIZE 200
 
 #define FGE_NEWOBJECT(objectType_, ...) fge::ObjectPtr{new objectType_{__VA_ARGS__}}
@@ -123,8 +141,10 @@ enum ObjectType : uint8_t
  * - the plan of the object
  * - the type of the object
  * - the plan depth of the object
+ *
+ * The ObjectData listen to the TagList of its Object in order to keep the tag index of the linked Scene updated.
  */
-class FGE_API ObjectData
+class FGE_API ObjectData : private fge::TagList::Listener
 {
 public:
     ObjectData() :
@@ -364,6 +384,9 @@ public:
     }
 
 private:
+    void onTagAdded(const fge::TagList& tagList, fge::tag::TagId tagId) override;
+    void onTagRemoved(const fge::TagList& tagList, fge::tag::TagId tagId) override;
+
     fge::Scene* g_linkedScene;
 
     fge::ObjectPtr g_object;
@@ -378,11 +401,112 @@ private:
     friend class fge::Scene;
 };
 
+/**
+ * \class SidAllocator
+ * \ingroup objectControl
+ * \brief Sequential SID allocator with a free list of recycled SIDs
+ *
+ * This class is used by the Scene to give an SID to every new Object that don't ask for a specific one.
+ * SIDs are given in order from the start of a range, released SIDs are recycled before the counter move on.
+ *
+ * The SID space is split in two disjoint ranges :
+ * - the network range [FGE_SCENE_NETWORK_SID_BEGIN, FGE_SCENE_NETWORK_SID_END[ used by servers,
+ * - the local range [FGE_SCENE_LOCAL_SID_BEGIN, FGE_SCENE_LOCAL_SID_END[ used by clients.
+ *
+ * By default the server library use the network range and the client library use the local range,
+ * so an Object created locally by a client never take the SID of an Object sent by the server.
+ * A server built with the client library should set a network range with Scene::setSidAllocator.
+ *
+ * The network range can also be partitioned between multiple servers (or shards) that share the same clients,
+ * every one of them having its own range of SIDs, so no synchronisation is needed.
+ *
+ * \warning The allocator doesn't know which SIDs are used in the Scene, the Scene is responsible to
+ * skip the proposed SIDs that are already taken.
+ */
+class FGE_API SidAllocator
+{
+public:
+    /**
+     * \brief Create an allocator for the range [rangeBegin, rangeEnd[
+     *
+     * The default range is the network range for the server library and the local range for the client library.
+     *
+     * \param rangeBegin The first SID that can be given
+     * \param rangeEnd The end of the range (excluded)
+     */
+    explicit SidAllocator(fge::ObjectSid rangeBegin=FGE_SCENE_DEFAULT_SID_BEGIN, fge::ObjectSid rangeEnd=FGE_SCENE_DEFAULT_SID_END);
+
+    /**
+     * \brief Propose the next available SID
+     *
+     * A recycled SID is proposed first, if there is none the internal counter is used.
+     *
+     * \return The proposed SID or FGE_SCENE_BAD_SID if the range is exhausted
+     */
+    fge::ObjectSid get();
+    /**
+     * \brief Give back an SID that is not used anymore
+     *
+     * SIDs outside the range are ignored.
+     *
+     * \param sid The SID to recycle
+     */
+    void release(fge::ObjectSid sid);
+    /**
+     * \brief Reset the counter to the start of the range and clear recycled SIDs
+     */
+    void reset();
+
+    /**
+     * \brief Change the range of the allocator
+     *
+     * This reset the allocator.
+     *
+     * \param rangeBegin The first SID that can be given
+     * \param rangeEnd The end of the range (excluded)
+     */
+    void setRange(fge::ObjectSid rangeBegin, fge::ObjectSid rangeEnd);
+
+    [[nodiscard]] inline fge::ObjectSid getRangeBegin() const
+    {
+        return this->g_rangeBegin;
+    }
+    [[nodiscard]] inline fge::ObjectSid getRangeEnd() const
+    {
+        return this->g_rangeEnd;
+    }
+    /**
+     * \brief Get the next SID the counter will give
+     *
+     * \return The next SID of the counter
+     */
+    [[nodiscard]] inline fge::ObjectSid getCounter() const
+    {
+        return this->g_counter;
+    }
+    /**
+     * \brief Get the number of recycled SIDs waiting to be given
+     *
+     * \return The number of recycled SIDs
+     */
+    [[nodiscard]] inline std::size_t getRecycledSize() const
+    {
+        return this->g_recycled.size();
+    }
+
+private:
+    fge::ObjectSid g_rangeBegin;
+    fge::ObjectSid g_rangeEnd;
+    fge::ObjectSid g_counter;
+    std::vector<fge::ObjectSid> g_recycled;
+};
+
 using ObjectDataWeak = std::weak_ptr<fge::ObjectData>;
 using ObjectDataShared = std::shared_ptr<fge::ObjectData>;
 using ObjectContainer = std::list<fge::ObjectDataShared>;
 using ObjectDataMap = std::unordered_map<fge::ObjectSid, fge::ObjectContainer::iterator>;
 using ObjectPlanDataMap = std::map<fge::ObjectPlan, fge::ObjectContainer::iterator>;
+using ObjectIndex = std::unordered_set<fge::ObjectDataShared>;
 
 /**
  * \class Scene
@@ -401,7 +525,7 @@ public:
 
     Scene();
     explicit Scene(std::string sceneName);
-    virtual ~Scene() = default;
+    virtual ~Scene();
 
     // Scene
     /**
@@ -435,6 +559,10 @@ public:
      * the delUpdatedObject and not any others delete methode that will cause
      * undefined behaviour.
      *
+     * If the Scene is deferring changes, every structural change requested during the update
+     * is queued and applied in one pass at the end of this method.
+     * \see deferChanges
+     *
      * \param screen A SFML RenderWindow
      * \param event The FastEngine Event class
      * \param deltaTime The time in milliseconds between two updates
@@ -658,6 +786,52 @@ public:
         return this->g_data.size();
     }
 
+    // Deferred changes
+    /**
+     * \brief Start to defer structural changes during an update or not.
+     *
+     * When \b true, every call to newObject, delObject, delUpdatedObject, setObjectPlan, setObjectPlanTop
+     * and setObjectPlanBot made during the update() method is queued instead of modifying the Scene
+     * in place. The queue is applied in order at the end of the update with a single _onPlanUpdate
+     * call (with FGE_SCENE_BAD_PLAN) and a single _onNewObjectBatch call.
+     *
+     * This is \b false by default.
+     *
+     * A queued new Object get its SID immediately, so the returned ObjectData can be used with delObject,
+     * setObjectPlan, ... during the same update. If no SID can be attributed, newObject return \b nullptr.
+     *
+     * \warning A queued new Object is not linked to the Scene until the changes are applied.
+     *
+     * \param on Start or stop deferring structural changes
+     */
+    void deferChanges(bool on);
+    /**
+     * \brief Check if the Scene is currently deferring structural changes.
+     *
+     * \see deferChanges
+     *
+     * \return Deferring changes stats
+     */
+    bool isDeferringChanges() const;
+    /**
+     * \brief Apply every queued structural changes.
+     *
+     * This is automatically called at the end of the update() method, but can be called
+     * manually if changes are queued elsewhere.
+     *
+     * \return The number of applied changes
+     */
+    std::size_t applyDeferredChanges();
+    /**
+     * \brief Get the number of queued structural changes.
+     *
+     * \return The number of queued changes
+     */
+    inline std::size_t getDeferredChangesSize() const
+    {
+        return this->g_deferredChanges.size();
+    }
+
     // Search function
     /**
      * \brief Get all Object with a position.
@@ -764,6 +938,9 @@ public:
     /**
      * \brief Get all Object with the same class name.
      *
+     * The Scene keep an index of its Objects per class, so this function only
+     * visit the matching Objects. Objects are not returned in the Scene order.
+     *
      * \see Object::getClassName
      *
      * \warning This function do not clear data in the ObjectContainer.
@@ -773,9 +950,24 @@ public:
      * \return The number of Objects added in the container
      */
     std::size_t getAllObj_ByClass(std::string_view class_name, fge::ObjectContainer& buff) const;
+    /**
+     * \brief Get all Object with the same registered class id.
+     *
+     * \see getAllObj_ByClass reg::GetClassId
+     *
+     * \warning This function do not clear data in the ObjectContainer.
+     *
+     * \param class_id The wanted class id
+     * \param buff An ObjectContainer that will receive results
+     * \return The number of Objects added in the container
+     */
+    std::size_t getAllObj_ByClass(fge::reg::ClassId class_id, fge::ObjectContainer& buff) const;
     /**
      * \brief Get all Object that contain the provided tag.
      *
+     * The Scene keep an index of its Objects per tag, so this function only
+     * visit the matching Objects. Objects are not returned in the Scene order.
+     *
      * \see TagList
      *
      * \warning This function do not clear data in the ObjectContainer.
@@ -785,6 +977,18 @@ public:
      * \return The number of Objects added in the container
      */
     std::size_t getAllObj_ByTag(std::string_view tag_name, fge::ObjectContainer& buff) const;
+    /**
+     * \brief Get all Object that contain the provided tag id.
+     *
+     * \see getAllObj_ByTag
+     *
+     * \warning This function do not clear data in the ObjectContainer.
+     *
+     * \param tag_id The wanted tag id
+     * \param buff An ObjectContainer that will receive results
+     * \return The number of Objects added in the container
+     */
+    std::size_t getAllObj_ByTag(fge::tag::TagId tag_id, fge::ObjectContainer& buff) const;
 
     /**
      * \brief Get the first Object with a position.
@@ -849,6 +1053,9 @@ public:
     /**
      * \brief Get the first Object that match a provided class name.
      *
+     * The first Object is the one with the lowest plan, then the first in the Scene order.
+     * Only the Objects of this plan are visited.
+     *
      * \see getAllObj_ByClass
      *
      * \param class_name The class name
@@ -860,12 +1067,24 @@ public:
     /**
      * \brief Get the first Object that match a provided tag.
      *
+     * The first Object is the one with the lowest plan, then the first in the Scene order.
+     * Only the Objects of this plan are visited.
+     *
      * \see getAllObj_ByTag
      *
      * \param tag_name The tag
      * \return The first Object that match the argument
      */
     fge::ObjectDataShared getFirstObj_ByTag(std::string_view tag_name) const;
+    /**
+     * \brief Get the first Object that match a provided tag id.
+     *
+     * \see getAllObj_ByTag
+     *
+     * \param tag_id The tag id
+     * \return The first Object that match the argument
+     */
+    fge::ObjectDataShared getFirstObj_ByTag(fge::tag::TagId tag_id) const;
 
     // Static id
     /**
@@ -891,15 +1110,34 @@ public:
      * \brief Generate an SID based on the provided wanted SID.
      *
      * By default, if the wanted SID is FGE_SCENE_BAD_SID, this function
-     * try to generate one with random value using fge::_random.
+     * take the next free SID from the SidAllocator of the Scene.
+     *
+     * If the wanted SID is already taken, FGE_SCENE_BAD_SID is returned.
      *
-     * If the wanted SID is already taken, this will cause an random SID generation.
+     * This method can be overridden in order to use a custom SID strategy.
+     *
+     * \see setSidAllocator
      *
      * \param wanted_sid The wanted SID
      * \return The SID generated
      */
     virtual fge::ObjectSid generateSid(fge::ObjectSid wanted_sid = FGE_SCENE_BAD_SID) const;
 
+    /**
+     * \brief Set the SID allocator used by generateSid.
+     *
+     * This can be used to give a specific range of SIDs to a Scene (like a server shard).
+     *
+     * \param allocator The new allocator
+     */
+    void setSidAllocator(const fge::SidAllocator& allocator);
+    /**
+     * \brief Get the SID allocator used by generateSid.
+     *
+     * \return The SID allocator
+     */
+    const fge::SidAllocator& getSidAllocator() const;
+
     // Network
     /**
      * \brief Pack all the Scene data in a Packet.
@@ -1133,6 +1371,34 @@ public:
      */
     void delCustomView();
 
+#ifndef FGE_DEF_SERVER
+    // Batching
+    /**
+     * \brief Enable or disable the batching of the draw calls.
+     *
+     * When enabled, the Scene draw its Objects through a SpriteBatch, Objects that implement
+     * Object::drawBatched are merged in a few draw calls while keeping the plan and depth order.
+     *
+     * \param enable \b true to enable the batching
+     */
+    void setBatching(bool enable);
+    /**
+     * \brief Check if the batching is enabled.
+     *
+     * \return \b true if the batching is enabled
+     */
+    [[nodiscard]] bool isBatching() const;
+    /**
+     * \brief Get the SpriteBatch used by the Scene.
+     *
+     * This can be used to retrieve the batching statistics.
+     *
+     * \return The SpriteBatch
+     */
+    [[nodiscard]] const fge::SpriteBatch& getSpriteBatch() const;
+    [[nodiscard]] fge::SpriteBatch& getSpriteBatch();
+#endif //FGE_DEF_SERVER
+
     // Linked renderTarget
     /**
      * \brief Link a SFML RenderTarget to the Scene.
@@ -1269,11 +1535,46 @@ public:
     mutable fge::CallbackHandler<const fge::Scene*, sf::RenderTarget&, const sf::Color&> _onRenderTargetClear;
 
     mutable fge::CallbackHandler<fge::Scene*, fge::ObjectDataShared> _onNewObject;
+    mutable fge::CallbackHandler<fge::Scene*, const fge::ObjectContainer&> _onNewObjectBatch;
     mutable fge::CallbackHandler<fge::Scene*, fge::ObjectDataShared> _onRemoveObject;
 
     mutable fge::CallbackHandler<fge::Scene*, fge::ObjectPlan> _onPlanUpdate;
 
 private:
+    struct DeferredChange
+    {
+        enum class Types : uint8_t
+        {
+            CHANGE_NEWOBJECT,
+            CHANGE_DELOBJECT,
+            CHANGE_PLAN,
+            CHANGE_PLAN_TOP,
+            CHANGE_PLAN_BOT
+        };
+
+        fge::Scene::DeferredChange::Types _type;
+        fge::ObjectSid _sid;
+        fge::ObjectPlan _plan;
+        fge::ObjectDataShared _data;
+    };
+
+    [[nodiscard]] inline bool isDeferringNow() const
+    {
+        return this->g_deferChanges && this->g_updatedObjectIterator != this->g_data.end();
+    }
+    [[nodiscard]] bool isDeferredValid(fge::ObjectSid sid) const;
+
+    [[nodiscard]] fge::ObjectDataShared getFirstObj_InPlan(fge::ObjectPlan plan, const std::function<bool(const fge::ObjectDataShared&)>& predicate) const;
+
+    void indexObject(const fge::ObjectDataShared& objectData);
+    void unindexObject(const fge::ObjectDataShared& objectData);
+
+    fge::ObjectDataShared insertObject(const fge::ObjectDataShared& objectData);
+    void removeObject(fge::ObjectDataMap::iterator it);
+    bool moveObjectPlan(fge::ObjectSid sid, fge::ObjectPlan newPlan);
+    bool moveObjectPlanTop(fge::ObjectSid sid);
+    bool moveObjectPlanBot(fge::ObjectSid sid);
+
     void refreshPlanDataMap(fge::ObjectPlan plan, fge::ObjectContainer::iterator hintIt, bool isLeaving);
     fge::ObjectContainer::iterator getInsertBeginPositionWithPlan(fge::ObjectPlan plan);
 
@@ -1285,14 +1586,30 @@ private:
     std::shared_ptr<sf::View> g_customView;
     sf::RenderTarget* g_linkedRenderTarget;
 
+#ifndef FGE_DEF_SERVER
+    bool g_batching{false};
+    mutable fge::SpriteBatch g_spriteBatch;
+#endif //FGE_DEF_SERVER
+
     bool g_deleteMe; //Delete an object while updating flag
     fge::ObjectContainer::iterator g_updatedObjectIterator; //The iterator of the updated object
 
+    bool g_deferChanges; //Queue structural changes while updating flag
+    std::vector<fge::Scene::DeferredChange> g_deferredChanges;
+
     fge::ObjectContainer g_data;
     fge::ObjectDataMap g_dataMap;
+    std::unordered_set<fge::ObjectSid> g_deferredSids; //SIDs of the queued new objects
     fge::ObjectPlanDataMap g_planDataMap;
 
+    mutable fge::SidAllocator g_sidAllocator;
+
+    std::unordered_map<fge::tag::TagId, fge::ObjectIndex> g_tagIndex;
+    std::unordered_map<fge::reg::ClassId, fge::ObjectIndex> g_classIndex;
+
     fge::CallbackContext g_callbackContext{nullptr, nullptr};
+
+    friend class fge::ObjectData;
 };
 
 }//end fge
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_C_SPRITEBATCH_HPP_INCLUDED
+#define _FGE_C_SPRITEBATCH_HPP_INCLUDED
+
+#include <FastEngine/fastengine_extern.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+
+namespace fge
+{
+
+/**
+ * \class SpriteBatch
+ * \ingroup graphics
+ * \brief Collect textured geometry and flush it as large vertex arrays
+ *
+ * Consecutive submissions that share the same texture and blend mode are merged in a single
+ * draw call. The submission order is kept, so plan and depth order are respected.
+ * Geometry is transformed on the CPU, submissions with a shader can't be batched and are
+ * drawn directly.
+ *
+ * When no target is provided to begin(), nothing is drawn but the statistics are still computed,
+ * this can be used to measure the batching efficiency headlessly.
+ */
+class FGE_API SpriteBatch
+{
+public:
+    /**
+     * \struct Stats
+     * \brief Statistics of the SpriteBatch since the last resetStats()
+     */
+    struct Stats
+    {
+        std::size_t _drawCalls{0};      ///< Total of draw calls issued to the target
+        std::size_t _vertexCount{0};    ///< Total of vertices issued to the target (drawables are not inspected)
+        std::size_t _flushCount{0};     ///< Number of batch flushes
+        std::size_t _batchedCount{0};   ///< Number of batched submissions
+        std::size_t _fallbackCount{0};  ///< Number of submissions that was drawn directly
+        std::size_t _textureBinds{0};   ///< Number of texture changes between the issued draw calls (drawables are not inspected)
+    };
+
+    SpriteBatch() = default;
+
+    /**
+     * \brief Start a batch on a target
+     *
+     * \param target The render target or \b nullptr to only compute statistics
+     */
+    void begin(sf::RenderTarget* target);
+    /**
+     * \brief Flush the remaining geometry and end the batch
+     */
+    void end();
+
+    /**
+     * \brief Add a quad in the batch
+     *
+     * \param vertices 4 vertices in sf::TriangleStrip order
+     * \param states The render states (transform, texture, blend mode)
+     */
+    void addQuad(const sf::Vertex* vertices, const sf::RenderStates& states);
+    /**
+     * \brief Add triangles in the batch
+     *
+     * \param vertices Vertices in sf::Triangles order
+     * \param count The number of vertices
+     * \param states The render states (transform, texture, blend mode)
+     */
+    void addTriangles(const sf::Vertex* vertices, std::size_t count, const sf::RenderStates& states);
+    /**
+     * \brief Flush the batch and draw a drawable directly on the target
+     *
+     * \param drawable The drawable
+     * \param states The render states
+     */
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states);
+
+    /**
+     * \brief Draw the batched geometry on the target
+     */
+    void flush();
+
+    [[nodiscard]] sf::RenderTarget* getTarget() const;
+
+    [[nodiscard]] const fge::SpriteBatch::Stats& getStats() const;
+    void resetStats();
+
+private:
+    [[nodiscard]] bool prepare(const sf::RenderStates& states);
+    void countTexture(const sf::Texture* texture);
+
+    sf::RenderTarget* g_target{nullptr};
+    std::vector<sf::Vertex> g_vertices;
+    const sf::Texture* g_texture{nullptr};
+    sf::BlendMode g_blendMode;
+    const sf::Texture* g_lastTexture{nullptr};
+    bool g_lastTextureKnown{false};
+    fge::SpriteBatch::Stats g_stats;
+};
+
+}//end fge
+
+#endif // _FGE_C_SPRITEBATCH_HPP_INCLUDED
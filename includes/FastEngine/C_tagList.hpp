@@ -18,34 +18,79 @@
 #define _FGE_C_TAGLIST_HPP_INCLUDED
 
 #include <FastEngine/fastengine_extern.hpp>
-#include <string>
-#include <set>
+#include <FastEngine/manager/tag_manager.hpp>
+#include <string_view>
+#include <vector>
 
 namespace fge
 {
 
+/**
+ * \class TagList
+ * \ingroup objectControl
+ * \brief A list of string tags that can be attached to an Object
+ *
+ * Tags are interned with fge::tag::Intern and stored as a sorted list of tag ids,
+ * so copying the list or checking a tag never compare strings.
+ *
+ * A Listener can be attached to the list in order to be notified of every tag modification.
+ * The Listener is never copied with the list.
+ */
 class FGE_API TagList
 {
 public:
-    using TagListType = std::set<std::string, std::less<>>;
+    using TagListType = std::vector<fge::tag::TagId>;
+
+    /**
+     * \class Listener
+     * \brief Interface that receive tag modifications of a TagList
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        virtual void onTagAdded(const fge::TagList& tagList, fge::tag::TagId tagId) = 0;
+        virtual void onTagRemoved(const fge::TagList& tagList, fge::tag::TagId tagId) = 0;
+    };
 
     TagList() = default;
+    TagList(const fge::TagList& r);
     ~TagList() = default;
 
+    fge::TagList& operator =(const fge::TagList& r);
+
     void clear();
 
     void add(std::string_view tag);
+    void add(fge::tag::TagId tagId);
     void del(std::string_view tag);
+    void del(fge::tag::TagId tagId);
 
     [[nodiscard]] bool check(std::string_view tag) const;
+    [[nodiscard]] bool check(fge::tag::TagId tagId) const;
 
     [[nodiscard]] std::size_t getSize() const;
 
+    /**
+     * \brief Set the listener of this list
+     *
+     * \param listener The listener or \b nullptr to remove it
+     */
+    void setListener(fge::TagList::Listener* listener);
+    [[nodiscard]] fge::TagList::Listener* getListener() const;
+
+    /**
+     * \brief Iterate over the sorted tag ids of this list
+     *
+     * Use fge::tag::GetTagName in order to retrieve the name of a tag.
+     */
     [[nodiscard]] fge::TagList::TagListType::const_iterator begin() const;
     [[nodiscard]] fge::TagList::TagListType::const_iterator end() const;
 
 private:
     fge::TagList::TagListType g_tags;
+    fge::TagList::Listener* g_listener{nullptr};
 };
 
 }//end fge
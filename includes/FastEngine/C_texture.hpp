@@ -78,6 +78,15 @@ public:
      * \return The texture size
      */
     [[nodiscard]] sf::Vector2u getTextureSize() const;
+    /**
+     * \brief Get the area of the texture in its underlying texture
+     *
+     * When the texture is packed in an atlas, this is the area inside the atlas page,
+     * otherwise this is the whole texture.
+     *
+     * \return The area of the texture in pixels
+     */
+    [[nodiscard]] sf::IntRect getTextureRect() const;
 
     /**
      * \brief Get the texture data
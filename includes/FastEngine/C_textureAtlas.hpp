@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_C_TEXTUREATLAS_HPP_INCLUDED
+#define _FGE_C_TEXTUREATLAS_HPP_INCLUDED
+
+#include <FastEngine/fastengine_extern.hpp>
+#include <FastEngine/textureType.hpp>
+#include <FastEngine/C_rectPacker.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#define FGE_TEXTURE_ATLAS_DEFAULT_PAGE_SIZE 2048
+#define FGE_TEXTURE_ATLAS_DEFAULT_PADDING 1
+
+namespace fge
+{
+
+/**
+ * \class TextureAtlas
+ * \ingroup graphics
+ * \brief Pack many images in a few big texture pages
+ *
+ * Pages are square textures of the same size that are created when the previous ones are full.
+ * An image that is bigger than a page can't be added.
+ *
+ * The smooth filter is a property of a whole page, so smooth and non-smooth images are packed
+ * in different pages. Repeated textures can't be packed as the repeat would wrap the whole page.
+ */
+class FGE_API TextureAtlas
+{
+public:
+    /**
+     * \struct Location
+     * \brief The location of an image in the atlas
+     */
+    struct Location
+    {
+        std::shared_ptr<fge::TextureType> _page;
+        sf::IntRect _rect;
+    };
+
+    explicit TextureAtlas(unsigned int pageSize=FGE_TEXTURE_ATLAS_DEFAULT_PAGE_SIZE,
+                          unsigned int padding=FGE_TEXTURE_ATLAS_DEFAULT_PADDING);
+
+    /**
+     * \brief Remove every page of the atlas
+     *
+     * Pages that are still used elsewhere stay alive.
+     */
+    void clear();
+    /**
+     * \brief Clear the atlas and change the size of the pages
+     *
+     * \param pageSize The width and height of a page
+     * \param padding The number of empty pixels between images
+     */
+    void reset(unsigned int pageSize, unsigned int padding=FGE_TEXTURE_ATLAS_DEFAULT_PADDING);
+
+    /**
+     * \brief Copy an image in the atlas
+     *
+     * \param image The image
+     * \param smooth \b true to pack the image in a page with the smooth filter enabled
+     * \return The location of the image or std::nullopt if the image is empty or too big
+     */
+    [[nodiscard]] std::optional<fge::TextureAtlas::Location> add(const sf::Image& image, bool smooth=false);
+
+    [[nodiscard]] std::size_t getPageCount() const;
+    [[nodiscard]] const std::shared_ptr<fge::TextureType>& getPage(std::size_t index) const;
+    [[nodiscard]] float getPageOccupancy(std::size_t index) const;
+    [[nodiscard]] bool isPageSmooth(std::size_t index) const;
+
+    [[nodiscard]] unsigned int getPageSize() const;
+    [[nodiscard]] unsigned int getPadding() const;
+
+private:
+    struct Page
+    {
+        std::shared_ptr<fge::TextureType> _texture;
+        fge::RectPacker _packer;
+        bool _smooth{false};
+    };
+
+    std::vector<fge::TextureAtlas::Page> g_pages;
+    unsigned int g_pageSize;
+    unsigned int g_padding;
+};
+
+}//end fge
+
+#endif // _FGE_C_TEXTUREATLAS_HPP_INCLUDED
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_C_THREADPOOL_HPP_INCLUDED
+#define _FGE_C_THREADPOOL_HPP_INCLUDED
+
+#include <FastEngine/fastengine_extern.hpp>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <queue>
+
+namespace fge
+{
+
+/**
+ * \class ThreadPool
+ * \ingroup utility
+ * \brief A fixed amount of worker threads that execute submitted tasks
+ *
+ * The pool is used to split CPU only work (like the shadow geometry of lights)
+ * across the available cores, the tasks must not touch the render target.
+ */
+class FGE_API ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+    /**
+     * \brief Function called by parallelFor()
+     *
+     * The first argument is the index of the element, the second one is the index of
+     * the worker that process it, in the range [0, getThreadCount()], useful to access
+     * a per-worker scratch buffer without any lock.
+     */
+    using ForFunction = std::function<void(std::size_t, std::size_t)>;
+
+    /**
+     * \brief Create the worker threads
+     *
+     * \param threadCount The number of threads, 0 to use the number of hardware threads minus one
+     */
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ThreadPool(const fge::ThreadPool& r) = delete;
+    ThreadPool(fge::ThreadPool&& r) noexcept = delete;
+    /**
+     * \brief Wait for every submitted task and join the threads
+     */
+    ~ThreadPool();
+
+    fge::ThreadPool& operator =(const fge::ThreadPool& r) = delete;
+    fge::ThreadPool& operator =(fge::ThreadPool&& r) noexcept = delete;
+
+    /**
+     * \brief Submit a task that will be executed by one of the workers
+     *
+     * \param task The task
+     */
+    void submit(fge::ThreadPool::Task task);
+    /**
+     * \brief Block until all submitted tasks are done
+     */
+    void wait();
+
+    /**
+     * \brief Call a function for every index in [0, count) and wait for the end
+     *
+     * The calling thread also process elements (with the worker index getThreadCount()),
+     * so this is safe to call from a task of the same pool.
+     *
+     * \param count The number of elements
+     * \param func The function to call for each element
+     */
+    void parallelFor(std::size_t count, const fge::ThreadPool::ForFunction& func);
+
+    /**
+     * \brief Get the number of worker threads
+     *
+     * \return The number of threads
+     */
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+private:
+    void work();
+
+    std::vector<std::thread> g_threads;
+    std::queue<fge::ThreadPool::Task> g_tasks;
+    std::size_t g_runningTasks{0};
+    bool g_stop{false};
+
+    mutable std::mutex g_mutex;
+    std::condition_variable g_cvTask;
+    std::condition_variable g_cvDone;
+};
+
+}//end fge
+
+#endif // _FGE_C_THREADPOOL_HPP_INCLUDED
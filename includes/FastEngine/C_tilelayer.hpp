@@ -20,11 +20,15 @@
 #include <FastEngine/fastengine_extern.hpp>
 #include <FastEngine/C_tileset.hpp>
 #include <FastEngine/C_matrix.hpp>
+#include <FastEngine/C_callback.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <json.hpp>
 
+#define FGE_TILELAYER_CHUNK_SIZE 16
+#define FGE_TILELAYER_DEFAULT_COLLISION_PROPERTY "solid"
+
 namespace fge
 {
 
@@ -37,6 +41,13 @@ using TileSetList = std::vector<std::shared_ptr<fge::TileSet> >;
  * \ingroup graphics
  *
  * This class is compatible with the "Tiled" map editor.
+ *
+ * Tiles are grouped in chunks of FGE_TILELAYER_CHUNK_SIZE x FGE_TILELAYER_CHUNK_SIZE tiles,
+ * every chunk hold one vertex array per tileset texture that is only rebuilt when one of its tiles
+ * is modified. Chunks outside the view are not drawn.
+ *
+ * The layer also keep a packed collision bitmap built from a boolean property of the tiles TileData
+ * (see setCollisionProperty()) that can be used directly by a path finder.
  */
 #ifdef FGE_DEF_SERVER
 class FGE_API TileLayer : public sf::Transformable
@@ -183,6 +194,14 @@ public:
      * \param gid The global tile id
      */
     void setGid(std::size_t x, std::size_t y, TileId gid);
+    /**
+     * \brief Set the color of a tile
+     *
+     * \param x The x position of the tile
+     * \param y The y position of the tile
+     * \param color The color of the tile
+     */
+    void setColor(std::size_t x, std::size_t y, const sf::Color& color);
     /**
      * \brief Set the tiles matrix size
      *
@@ -198,12 +217,97 @@ public:
      */
     void refreshTextures(const TileSetList& tileSets);
 
+    /**
+     * \brief Set the name of the tile property that mark a tile as solid
+     *
+     * A tile is solid when the property of its TileData is a boolean set to \b true.
+     * The collisions are rebuilt with the current tilesets.
+     *
+     * \param property The name of the property (default FGE_TILELAYER_DEFAULT_COLLISION_PROPERTY)
+     */
+    void setCollisionProperty(std::string property);
+    /**
+     * \brief Get the name of the tile property that mark a tile as solid
+     *
+     * \return The name of the property
+     */
+    [[nodiscard]] const std::string& getCollisionProperty() const;
+    /**
+     * \brief Get the packed collision bitmap
+     *
+     * One bit per tile in 64-bit words, row by row (index = y*width + x), a set bit is a solid tile.
+     * The bitmap is updated by setGid() and refreshTextures(). It's copy-on-write: a modification while
+     * the bitmap is still referenced elsewhere create a new bitmap, so the returned one is a stable snapshot
+     * (see fge::AStar::Generator::setCollisions()).
+     *
+     * In order to follow the modifications cell by cell, see _onCollisionChanged.
+     *
+     * \return The collision bitmap
+     */
+    [[nodiscard]] std::shared_ptr<const std::vector<uint64_t> > getCollisions() const;
+    /**
+     * \brief Check if a tile is solid
+     *
+     * \param x The x position of the tile
+     * \param y The y position of the tile
+     * \return \b true if the tile is solid, \b false otherwise or if outside the layer
+     */
+    [[nodiscard]] bool isSolid(std::size_t x, std::size_t y) const;
+
+#ifndef FGE_DEF_SERVER
+    /**
+     * \brief Get the number of chunks of the layer
+     *
+     * \return The number of chunks
+     */
+    [[nodiscard]] std::size_t getChunkCount() const;
+#endif //FGE_DEF_SERVER
+
+    /**
+     * \brief Called by setGid() when a tile become solid or not solid
+     *
+     * The arguments are the layer, the x and y position of the tile and the new state.
+     * A path finder (and its flow fields) can be updated from here, full rebuilds done by
+     * refreshTextures() and setCollisionProperty() are not notified.
+     */
+    fge::CallbackHandler<fge::TileLayer&, std::size_t, std::size_t, bool> _onCollisionChanged;
+
 private:
     static std::shared_ptr<fge::TileSet> retrieveAssociatedTileSet(const TileSetList& tileSets, TileId gid);
 
+    [[nodiscard]] bool isTileSolid(const TileLayer::Tile& tile) const;
+    std::vector<uint64_t>& getWritableCollisions();
+    void updateCollision(std::size_t x, std::size_t y);
+    void refreshCollisions();
+
+#ifndef FGE_DEF_SERVER
+    struct Chunk
+    {
+        struct Batch
+        {
+            const sf::Texture* _texture{nullptr};
+            sf::VertexArray _vertices{sf::Triangles};
+        };
+
+        std::vector<Batch> _batches;
+        sf::FloatRect _bounds;
+        bool _dirty{true};
+    };
+
+    void resizeChunks();
+    void invalidateChunk(std::size_t x, std::size_t y);
+    void invalidateAllChunks();
+    void rebuildChunk(std::size_t chunkX, std::size_t chunkY) const;
+
+    mutable fge::Matrix<TileLayer::Chunk> g_chunks;
+#endif //FGE_DEF_SERVER
+
     TileId g_id{1};
     std::string g_name;
     fge::Matrix<TileLayer::Tile> g_data;
+
+    fge::PropertyKey g_collisionProperty{FGE_TILELAYER_DEFAULT_COLLISION_PROPERTY};
+    std::shared_ptr<const std::vector<uint64_t> > g_collisions{std::make_shared<std::vector<uint64_t> >()};
 };
 
 FGE_API void to_json(nlohmann::json& j, const fge::TileLayer& p);
@@ -26,14 +26,37 @@
 namespace fge
 {
 
+namespace timer
+{
+
+class TimerWheel;
+
+}//end timer
+
 /**
  * \class Timer
  * \ingroup time
  * \brief A timer that can be used with the timer manager to handle time.
+ *
+ * A timer only count time while it's handled by the timer manager (see fge::timer::Create()),
+ * the elapsed time is then computed from the steady clock when requested.
+ * After a modification that bring the goal closer (like subToGoal() or resume()), the manager
+ * must be notified with fge::timer::Notify() for the timer to be rescheduled.
  */
 class FGE_API Timer
 {
 public:
+    /**
+     * \enum DispatchPolicies
+     * \brief Where the _onTimeReached callbacks are called by the timer manager
+     */
+    enum class DispatchPolicies : uint8_t
+    {
+        DISPATCH_INLINE,        ///< Directly on the timer thread (the callbacks must be short)
+        DISPATCH_THREAD_POOL,   ///< On the thread pool of the manager (see fge::timer::SetThreadPool()), inline if there is none
+        DISPATCH_MAIN_LOOP      ///< Queued until fge::timer::ProcessQueuedCallbacks() is called (see fge::timer::SetQueueTimeout())
+    };
+
     Timer(const fge::Timer& timer);
     Timer(fge::Timer&& timer) noexcept;
 
@@ -62,6 +85,9 @@ public:
     /**
      * \brief Set the timer name
      *
+     * The timer manager index the name when the timer is created, use fge::timer::Rename()
+     * to rename a timer that is already handled by the manager.
+     *
      * \param name The name of the timer
      */
     void setName(const std::string& name);
@@ -72,6 +98,22 @@ public:
      */
     const std::string& getName() const;
 
+    /**
+     * \brief Set the dispatch policy of the timer callbacks
+     *
+     * Whatever the policy, the timer is only removed from the manager once its callbacks are done
+     * and if the goal is still reached (so a callback can restart the timer).
+     *
+     * \param policy The dispatch policy (default DISPATCH_INLINE)
+     */
+    void setDispatchPolicy(fge::Timer::DispatchPolicies policy);
+    /**
+     * \brief Get the dispatch policy of the timer callbacks
+     *
+     * \return The dispatch policy
+     */
+    fge::Timer::DispatchPolicies getDispatchPolicy() const;
+
     /**
      * \brief Set the goal duration of the timer
      *
@@ -137,7 +179,7 @@ public:
      *
      * \return The elapsed time of the timer
      */
-    const std::chrono::milliseconds& getElapsedTime() const;
+    std::chrono::milliseconds getElapsedTime() const;
     /**
      * \brief Get the goal time of the timer
      *
@@ -183,16 +225,24 @@ public:
     fge::CallbackHandler<fge::Timer&> _onTimeReached; ///< The callback called when the timer reaches the goal
 
 private:
+    std::chrono::milliseconds computeElapsedTime() const;
+    void foldElapsedTime();
+
     const std::chrono::steady_clock::time_point g_lifeTimePoint;
+    std::chrono::steady_clock::time_point g_updateTimePoint;
+    bool g_isScheduled{false};
 
     std::chrono::milliseconds g_elapsedTime;
     std::chrono::milliseconds g_goalDuration;
 
     bool g_isPaused;
+    fge::Timer::DispatchPolicies g_dispatchPolicy{fge::Timer::DispatchPolicies::DISPATCH_INLINE};
 
     std::string g_name;
 
     mutable std::mutex g_mutex;
+
+    friend class fge::timer::TimerWheel;
 };
 
 }//end fge
@@ -52,6 +52,7 @@ fge::Tunnel<T>& Tunnel<T>::operator =(fge::Tunnel<T>&& r) noexcept
     {
         this->g_anonymousGates[i]->g_tunnel = this;
     }
+    return *this;
 }
 
 template <class T>
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_EXTRA_FLOWFIELD_HPP_INCLUDED
+#define _FGE_EXTRA_FLOWFIELD_HPP_INCLUDED
+
+#include "FastEngine/fastengine_extern.hpp"
+#include "FastEngine/extra/extra_pathFinding.hpp"
+#include "FastEngine/C_matrix.hpp"
+#include <limits>
+
+#define FGE_FLOWFIELD_NO_COST std::numeric_limits<uint32_t>::max()
+#define FGE_FLOWFIELD_NO_DIRECTION 0xFF
+
+namespace fge::AStar
+{
+
+/**
+ * \class FlowField
+ * \brief A direction field toward a set of goals
+ *
+ * The field is computed once with a Dijkstra search from every goal on the collisions of a
+ * Generator, with the same movement rules and step costs. Every reachable cell then know its
+ * next step toward the nearest goal, so any number of agents can share the same destination
+ * for the cost of a single search.
+ *
+ * When a collision change, update() only repair the cells that depended on it.
+ */
+class FGE_API FlowField
+{
+public:
+    FlowField() = default;
+
+    /**
+     * \brief Compute the whole field
+     *
+     * The field take the world size, collisions and diagonal movement of the generator.
+     * Goals that are outside the world or on a collision are ignored.
+     *
+     * \param generator The generator that own the collisions
+     * \param goals The goals
+     */
+    void compute(const fge::AStar::Generator& generator, const fge::AStar::CoordinateList& goals);
+    /**
+     * \brief Update the field after a collision was added or removed
+     *
+     * Only the cells whose path crossed the changed cell (or that can now use it) are recomputed.
+     * If the world size or the diagonal movement of the generator changed, the whole field is recomputed.
+     *
+     * \param generator The generator that own the collisions
+     * \param coord The coordinate of the changed collision
+     */
+    void update(const fge::AStar::Generator& generator, fge::AStar::Vector2i coord);
+
+    /**
+     * \brief Get the next step from a cell
+     *
+     * \param coord The coordinate of the cell
+     * \param next The next cell toward the nearest goal
+     * \return \b true if the cell can reach a goal and is not a goal
+     */
+    bool getNextStep(fge::AStar::Vector2i coord, fge::AStar::Vector2i& next) const;
+    /**
+     * \brief Get the direction from a cell
+     *
+     * \param coord The coordinate of the cell
+     * \return The direction (each component is -1, 0 or 1) or {0,0} if there is no direction
+     */
+    [[nodiscard]] fge::AStar::Vector2i getDirection(fge::AStar::Vector2i coord) const;
+    /**
+     * \brief Get the path cost from a cell to its nearest goal
+     *
+     * \param coord The coordinate of the cell
+     * \return The cost or FGE_FLOWFIELD_NO_COST if no goal can be reached
+     */
+    [[nodiscard]] uint32_t getCost(fge::AStar::Vector2i coord) const;
+    /**
+     * \brief Follow the field from a cell
+     *
+     * \param source The source coordinate
+     * \return The path from the source to the nearest goal (included) or an empty list
+     */
+    [[nodiscard]] fge::AStar::CoordinateList getPath(fge::AStar::Vector2i source) const;
+
+    [[nodiscard]] const fge::AStar::CoordinateList& getGoals() const;
+    [[nodiscard]] const fge::Matrix<uint32_t>& getCosts() const;
+    [[nodiscard]] const fge::Matrix<uint8_t>& getDirections() const;
+
+private:
+    struct HeapEntry
+    {
+        uint32_t _cost;
+        uint32_t _index;
+    };
+
+    [[nodiscard]] bool isInside(fge::AStar::Vector2i coord) const;
+    [[nodiscard]] uint32_t getIndex(fge::AStar::Vector2i coord) const;
+    [[nodiscard]] fge::AStar::Vector2i getCoord(uint32_t index) const;
+    [[nodiscard]] bool isGoal(fge::AStar::Vector2i coord) const;
+
+    void relax(fge::AStar::Vector2i coord, const fge::AStar::Generator& generator);
+    void propagate(const fge::AStar::Generator& generator);
+
+    fge::AStar::CoordinateList g_goals;
+    fge::Matrix<uint32_t> g_costs;
+    fge::Matrix<uint8_t> g_directions;
+    fge::AStar::Vector2i g_worldSize;
+    std::size_t g_directionsCount{4};
+
+    std::vector<HeapEntry> g_openHeap;
+    std::vector<uint32_t> g_openList;
+};
+
+}//end fge::AStar
+
+#endif //_FGE_EXTRA_FLOWFIELD_HPP_INCLUDED
@@ -29,6 +29,7 @@
 #include <vector>
 #include <unordered_set>
 #include <array>
+#include <memory>
 #include <cstdint>
 #include "SFML/System/Vector2.hpp"
 
@@ -51,43 +52,203 @@ struct Vector2int32Hash
 
 using CoordinateSet = std::unordered_set<fge::AStar::Vector2i, fge::AStar::Vector2int32Hash>;
 
-struct FGE_API Node
-{
-    explicit Node(fge::AStar::Vector2i coord, Node* parent = nullptr);
-    [[nodiscard]] unsigned int getScore() const;
-
-    unsigned int _g, _h;
-    fge::AStar::Vector2i _coord;
-    Node* _parent;
-};
-
-using NodeList = std::vector<Node*>;
-
+/**
+ * \class Generator
+ * \brief A* path generator on a 2D grid
+ *
+ * Nodes are stored in a dense table sized from the world size, every cell have its own entry.
+ * A generation counter is used to know if a cell was touched by the current query, so nothing
+ * have to be cleared between queries and no allocation is done once the world is sized
+ * (except for the returned path).
+ * The open list is a binary heap and collisions are stored in a flat bitmap.
+ *
+ * Different search strategies can be selected with setStrategy(), findPath() use the
+ * selected one.
+ */
 class FGE_API Generator
 {
 public:
+    /**
+     * \enum Strategies
+     * \brief The search strategy used by findPath()
+     */
+    enum class Strategies : uint8_t
+    {
+        STRATEGY_ASTAR,         ///< Plain A* on the grid
+        STRATEGY_JUMP_POINT,    ///< Jump Point Search, only with diagonal movement (plain A* is used otherwise)
+        STRATEGY_HIERARCHICAL   ///< Hierarchical A* (HPA*) on clusters of cells, paths are near optimal
+    };
+
     Generator();
     ~Generator() = default;
 
+    /**
+     * \brief Set the size of the world
+     *
+     * Collisions inside the new size are kept.
+     *
+     * \param worldSize The world size in cells
+     */
     void setWorldSize(fge::AStar::Vector2i worldSize);
     [[nodiscard]] const fge::AStar::Vector2i& getWorldSize() const;
 
     void setDiagonalMovement(bool enable);
+    [[nodiscard]] bool isDiagonalMovementEnabled() const;
     void setHeuristic(HeuristicFunction heuristic);
     CoordinateList findPath(fge::AStar::Vector2i source, fge::AStar::Vector2i target);
+    /**
+     * \brief Add a collision
+     *
+     * The coordinate must be inside the world size (see setWorldSize()), it's ignored otherwise.
+     *
+     * \param coord The coordinate of the collision
+     */
     void addCollision(fge::AStar::Vector2i coord);
     void removeCollision(fge::AStar::Vector2i coord);
+    /**
+     * \brief Add or remove a collision
+     *
+     * This can be directly connected to fge::TileLayer::_onCollisionChanged to keep the
+     * generator in sync with a layer cell by cell.
+     *
+     * \param coord The coordinate of the collision
+     * \param solid \b true to add the collision, \b false to remove it
+     */
+    void setCollision(fge::AStar::Vector2i coord, bool solid);
     void clearCollisions();
 
+    [[nodiscard]] bool detectCollision(fge::AStar::Vector2i coord) const;
+
+    /**
+     * \brief Use the world size, collisions and search settings of another generator
+     *
+     * Collisions are shared in a copy-on-write way, the first generator that modify them
+     * make its own copy. This can be used to have a generator per thread on the same
+     * collisions without copying them every time.
+     *
+     * When this generator already shared the collisions of the provided one, only the clusters
+     * touched by the collisions added/removed since then are rebuilt by the hierarchical strategy.
+     *
+     * \param generator The generator to share with
+     */
+    void shareCollisions(const fge::AStar::Generator& generator);
+    /**
+     * \brief Use an external collision bitmap
+     *
+     * The bitmap store one bit per cell in 64-bit words, row by row (index = y*worldSize.x + x),
+     * like fge::TileLayer::getCollisions(). It's never modified, the generator make its own copy
+     * on the first collision change. Passing the same bitmap again is free, a new bitmap with the
+     * same world size is compared with the current one and only the clusters of the changed cells
+     * are rebuilt by the hierarchical strategy.
+     * A bitmap too small for the world size is ignored.
+     *
+     * \param worldSize The world size in cells
+     * \param collisions The collision bitmap
+     */
+    void setCollisions(fge::AStar::Vector2i worldSize, std::shared_ptr<const std::vector<uint64_t> > collisions);
+
+    /**
+     * \brief Set the search strategy
+     *
+     * Jump Point Search expand far less nodes on open areas, it needs the diagonal movement
+     * and an admissible heuristic (like Heuristic::octagonal) to return optimal paths.
+     *
+     * The hierarchical strategy split the world into clusters (see setClusterSize()) and cache
+     * the paths costs between the cluster entrances. A query first search the abstract graph
+     * of entrances and then refine the path inside each crossed cluster.
+     * Collision changes only rebuild the touched clusters on the next query.
+     *
+     * \param strategy The search strategy
+     */
+    void setStrategy(fge::AStar::Generator::Strategies strategy);
+    [[nodiscard]] fge::AStar::Generator::Strategies getStrategy() const;
+
+    /**
+     * \brief Set the size of a cluster for the hierarchical strategy
+     *
+     * \param size The cluster size in cells (minimum 4)
+     */
+    void setClusterSize(int32_t size);
+    [[nodiscard]] int32_t getClusterSize() const;
+
 private:
-    bool detectCollision(fge::AStar::Vector2i coord);
-    [[nodiscard]] Node* findNodeOnList(const NodeList& nodes, fge::AStar::Vector2i coord) const;
-    void releaseNodes(NodeList& nodes);
+    struct NodeData
+    {
+        uint32_t _g;
+        uint32_t _parent;
+        uint32_t _generation{0};
+        bool _closed;
+    };
+    struct HeapEntry
+    {
+        uint32_t _score;
+        uint32_t _h;
+        uint32_t _index;
+    };
+
+    struct Bounds
+    {
+        int32_t _left;
+        int32_t _top;
+        int32_t _right;     ///< Excluded
+        int32_t _bottom;    ///< Excluded
+    };
+    struct Cluster
+    {
+        std::vector<uint32_t> _transitions;             ///< Cells that lead to a neighbor cluster
+        std::vector<std::vector<uint32_t> > _links;     ///< Cells of the neighbor clusters linked to each transition
+        std::vector<uint32_t> _costs;                   ///< Costs between transitions (transitions^2)
+    };
+
+    std::vector<uint64_t>& getWritableWalls();
+    void recordCollisionChange(std::size_t index);
+    void resetCollisionChanges();
+    void resetNodes(fge::AStar::Vector2i worldSize);
+    [[nodiscard]] bool isInside(fge::AStar::Vector2i coord) const;
+    [[nodiscard]] static bool isInside(fge::AStar::Vector2i coord, const Bounds& bounds);
+    [[nodiscard]] std::size_t getIndex(fge::AStar::Vector2i coord) const;
+    [[nodiscard]] fge::AStar::Vector2i getCoord(uint32_t index) const;
+    [[nodiscard]] Bounds getWorldBounds() const;
+
+    uint32_t nextGeneration();
+    bool search(uint32_t source, uint32_t target, const Bounds& bounds);
+    CoordinateList buildPath(uint32_t source, uint32_t target) const;
+
+    CoordinateList findPathJumpPoint(fge::AStar::Vector2i source, fge::AStar::Vector2i target);
+    bool jump(fge::AStar::Vector2i coord, fge::AStar::Vector2i direction, fge::AStar::Vector2i target, fge::AStar::Vector2i& jumpPoint) const;
+
+    CoordinateList findPathHierarchical(fge::AStar::Vector2i source, fge::AStar::Vector2i target);
+    void invalidateHierarchy(fge::AStar::Vector2i coord);
+    void updateHierarchy();
+    void buildBorder(std::size_t border, bool vertical);
+    void buildCluster(std::size_t cluster);
+    [[nodiscard]] std::size_t getClusterIndex(uint32_t index) const;
+    [[nodiscard]] Bounds getClusterBounds(std::size_t cluster) const;
+    void computeCosts(uint32_t source, const Bounds& bounds, const std::vector<uint32_t>& targets, uint32_t* costs);
 
     HeuristicFunction g_heuristic;
-    CoordinateSet g_walls;
+    std::shared_ptr<const std::vector<uint64_t> > g_walls{std::make_shared<std::vector<uint64_t> >()};
+    bool g_wallsOwned{true};                    ///< False when the bitmap was provided by setCollisions()
+    uint64_t g_collisionEpoch;                  ///< Identify the history of the collisions, changed when they are replaced
+    uint64_t g_collisionVersion{0};             ///< Number of changed cells in this history
+    std::vector<uint32_t> g_collisionChanges;   ///< The last changed cells of this history
+    bool g_collisionHistoryOwned{true};         ///< False when the history is the one of a shared generator
     fge::AStar::Vector2i g_worldSize;
 
+    std::vector<NodeData> g_nodes;
+    std::vector<HeapEntry> g_openHeap;
+    uint32_t g_generation{0};
+
+    fge::AStar::Generator::Strategies g_strategy{fge::AStar::Generator::Strategies::STRATEGY_ASTAR};
+
+    int32_t g_clusterSize{16};
+    fge::AStar::Vector2i g_clusterCount;
+    std::vector<Cluster> g_clusters;
+    std::vector<uint8_t> g_clustersDirty;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t> > > g_borders[2];   ///< Transition pairs on vertical [0] and horizontal [1] borders
+    std::vector<uint8_t> g_bordersDirty[2];
+    bool g_hierarchyDirty{true};
+
     const std::array<fge::AStar::Vector2i, 8> g_directions;
     std::size_t g_directionsCount;
 };
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_EXTRA_PATHSERVICE_HPP_INCLUDED
+#define _FGE_EXTRA_PATHSERVICE_HPP_INCLUDED
+
+#include "FastEngine/fastengine_extern.hpp"
+#include "FastEngine/extra/extra_pathFinding.hpp"
+#include "FastEngine/C_callback.hpp"
+#include "FastEngine/C_threadPool.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#define FGE_PATHSERVICE_BAD_QUERY 0
+
+namespace fge::AStar
+{
+
+using QueryId = uint32_t;
+
+/**
+ * \class PathService
+ * \brief Answer path requests by batches on worker threads
+ *
+ * Callers submit requests with request() from any thread. Every call to process() (usually once per tick)
+ * deliver the results of the previous batch and start a new batch with the pending requests, so the
+ * calling thread is never blocked by the searches.
+ *
+ * The searches are done against a snapshot of getGenerator() taken when the batch start, every worker
+ * have its own generator that share the collisions (see Generator::shareCollisions()).
+ * Identical requests in a batch are searched once, nearby ones can also be merged with
+ * setDeduplicationRadius().
+ *
+ * Results are delivered on the thread that call process().
+ * Without a thread pool, the searches are done directly in process().
+ */
+class FGE_API PathService
+{
+public:
+    using Callback = fge::CallbackFunctorBase<fge::AStar::QueryId, const fge::AStar::CoordinateList&>;
+
+    PathService() = default;
+    PathService(const fge::AStar::PathService& r) = delete;
+    PathService(fge::AStar::PathService&& r) noexcept = delete;
+    /**
+     * \brief Wait for the running batch
+     */
+    ~PathService();
+
+    fge::AStar::PathService& operator =(const fge::AStar::PathService& r) = delete;
+    fge::AStar::PathService& operator =(fge::AStar::PathService&& r) noexcept = delete;
+
+    /**
+     * \brief Set the thread pool used to process the batches
+     *
+     * The running batch is waited before changing the pool.
+     *
+     * \param threadPool The thread pool or \b nullptr to search directly in process()
+     */
+    void setThreadPool(fge::ThreadPool* threadPool);
+    [[nodiscard]] fge::ThreadPool* getThreadPool() const;
+
+    /**
+     * \brief Get the reference generator
+     *
+     * The world size, collisions and settings of this generator are used for every new batch.
+     * It must only be modified by the thread that call process().
+     *
+     * \return The reference generator
+     */
+    [[nodiscard]] fge::AStar::Generator& getGenerator();
+    [[nodiscard]] const fge::AStar::Generator& getGenerator() const;
+
+    /**
+     * \brief Set the radius (in cells) used to merge nearby requests
+     *
+     * Requests with the same target and a source in this radius from an already
+     * batched request receive the path of this one, so the path can start a few cells
+     * away from the requested source. The default radius is 0 (only identical requests are merged).
+     *
+     * \param radius The radius in cells
+     */
+    void setDeduplicationRadius(int32_t radius);
+    [[nodiscard]] int32_t getDeduplicationRadius() const;
+
+    /**
+     * \brief Request a path
+     *
+     * This is thread-safe. The result is delivered by process() to the provided callback
+     * and to _onPathFound, an empty path mean that no path was found.
+     *
+     * \param source The source coordinate
+     * \param target The target coordinate
+     * \param callback An optional callback only called for this request (the service take the ownership)
+     * \param subscriber An optional subscriber associated with the callback
+     * \return The id of the request
+     */
+    fge::AStar::QueryId request(fge::AStar::Vector2i source, fge::AStar::Vector2i target,
+                                fge::AStar::PathService::Callback* callback=nullptr, fge::Subscriber* subscriber=nullptr);
+
+    /**
+     * \brief Deliver the finished results and start a new batch
+     *
+     * \return The number of delivered results
+     */
+    std::size_t process();
+    /**
+     * \brief Block until the running batch is done
+     *
+     * The results are delivered on the next process().
+     */
+    void wait();
+
+    [[nodiscard]] std::size_t getPendingCount() const;
+    [[nodiscard]] bool isRunning() const;
+
+    fge::CallbackHandler<fge::AStar::QueryId, const fge::AStar::CoordinateList&> _onPathFound;
+
+private:
+    struct Request
+    {
+        fge::AStar::QueryId _id;
+        fge::AStar::Vector2i _source;
+        fge::AStar::Vector2i _target;
+        std::unique_ptr<fge::CallbackHandler<fge::AStar::QueryId, const fge::AStar::CoordinateList&> > _callback;
+        std::size_t _job;
+    };
+    struct Job
+    {
+        fge::AStar::Vector2i _source;
+        fge::AStar::Vector2i _target;
+        fge::AStar::CoordinateList _path;
+    };
+
+    void prepareBatch();
+    void runBatch();
+    std::size_t deliverBatch();
+
+    fge::AStar::Generator g_generator;
+    std::vector<fge::AStar::Generator> g_workers;
+    fge::ThreadPool* g_threadPool{nullptr};
+    int32_t g_deduplicationRadius{0};
+
+    mutable std::mutex g_mutex;
+    std::vector<Request> g_pending;
+    fge::AStar::QueryId g_lastId{FGE_PATHSERVICE_BAD_QUERY};
+
+    std::vector<Request> g_batch;
+    std::vector<Job> g_jobs;
+    std::shared_ptr<std::atomic<bool> > g_running{std::make_shared<std::atomic<bool> >(false)}; ///< Shared with the running task, so it can notify after the service is destroyed
+};
+
+}//end fge::AStar
+
+#endif //_FGE_EXTRA_PATHSERVICE_HPP_INCLUDED
@@ -0,0 +1,12 @@
+#ifndef _FGE_FASTENGINE_VERSION_HPP_INCLUDED
+#define _FGE_FASTENGINE_VERSION_HPP_INCLUDED
+
+#define FGE_VERSION_MAJOR 0
+#define FGE_VERSION_MINOR 0
+#define FGE_VERSION_REVISION 0
+#define FGE_VERSION_GITTAG "unknown"
+
+#define FGE_VERSION_FULL_WITHTAG_STRING "0.0.0-unknown"
+#define FGE_VERSION_FULL_STRING "0.0.0"
+
+#endif //_FGE_FASTENGINE_VERSION_HPP_INCLUDED
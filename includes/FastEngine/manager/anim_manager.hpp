@@ -20,6 +20,7 @@
 #include "FastEngine/fastengine_extern.hpp"
 
 #include "FastEngine/textureType.hpp"
+#include <SFML/Graphics/Rect.hpp>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -55,6 +56,7 @@ struct AnimationFrame
     std::shared_ptr<fge::TextureType> _texture; ///< The shared pointer texture of the frame
     std::string _path; ///< The file path of the texture
     sf::Vector2u _texturePosition; ///< The tileset grid position, only useful if the type is ANIM_TYPE_TILESET
+    sf::IntRect _textureRect; ///< The area of the frame in the texture when packed in an atlas, empty if the whole texture is used
 
     uint32_t _ticks; ///< The number of ticks that the frame will be displayed, by default 1 tick take 100 ms.
 };
@@ -222,6 +224,17 @@ FGE_API void UnloadAll();
  */
 FGE_API bool Push(const std::string& name, const fge::anim::AnimationDataPtr& data);
 
+/**
+ * \brief Pack the frames of the loaded animations in the texture atlas
+ *
+ * Only the frames of ANIM_TYPE_SEPARATE_FILES animations are packed, every frame is copied
+ * in the atlas of the texture manager (see fge::texture::GetAtlas()) so sprites and animations
+ * can share the same pages. Repeated frames are ignored and smooth frames are packed in smooth pages.
+ *
+ * \return The number of packed frames
+ */
+FGE_API std::size_t PackAtlas();
+
 /**
  * @}
  */
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FGE_TAG_MANAGER_HPP_INCLUDED
+#define _FGE_TAG_MANAGER_HPP_INCLUDED
+
+#include "FastEngine/fastengine_extern.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#define FGE_TAG_BADID std::numeric_limits<fge::tag::TagId>::max()
+
+namespace fge::tag
+{
+
+using TagId = uint16_t;
+
+/**
+ * \ingroup objectControl
+ * \brief Get the id of a tag name, interning it if needed
+ *
+ * Tag ids are attributed sequentially in the order of interning and stay valid
+ * for the whole lifetime of the program, as a consequence they are not stable between
+ * two different processes.
+ *
+ * \param tagName The name of the tag
+ * \return The id of the tag or FGE_TAG_BADID if the table is full
+ */
+FGE_API fge::tag::TagId Intern(std::string_view tagName);
+
+/**
+ * \ingroup objectControl
+ * \brief Get the id of an already interned tag name
+ *
+ * This never intern the name and only take a shared lock on the table.
+ *
+ * \param tagName The name of the tag
+ * \return The id of the tag or FGE_TAG_BADID if the name was never interned
+ */
+FGE_API fge::tag::TagId GetTagId(std::string_view tagName);
+/**
+ * \ingroup objectControl
+ * \brief Get the name of a tag id
+ *
+ * \param tagId The id of the tag
+ * \return The name of the tag or an empty string if the id is not valid
+ */
+FGE_API std::string_view GetTagName(fge::tag::TagId tagId);
+
+FGE_API bool Check(std::string_view tagName);
+FGE_API bool Check(fge::tag::TagId tagId);
+
+FGE_API std::size_t GetInternedSize();
+
+}//end fge::tag
+
+
+#endif // _FGE_TAG_MANAGER_HPP_INCLUDED
@@ -20,7 +20,9 @@
 #include "FastEngine/fastengine_extern.hpp"
 
 #include "FastEngine/textureType.hpp"
+#include "FastEngine/C_textureAtlas.hpp"
 #include <string>
+#include <vector>
 #include <unordered_map>
 #include <mutex>
 #include <memory>
@@ -36,12 +38,16 @@ namespace fge::texture
  * \struct TextureData
  * \ingroup graphics
  * \brief Structure that safely contains the texture data with his path and validity
+ *
+ * When the texture is packed in an atlas, _texture is the atlas page and _rect the area
+ * of the texture inside the page. An empty _rect mean that the whole texture is used.
  */
 struct TextureData
 {
     std::shared_ptr<fge::TextureType> _texture;
     bool _valid;
     std::filesystem::path _path;
+    sf::IntRect _rect;
 };
 
 using TextureDataPtr = std::shared_ptr<fge::texture::TextureData>;
@@ -168,6 +174,35 @@ FGE_API void UnloadAll();
  */
 FGE_API bool Push(std::string_view name, const fge::texture::TextureDataPtr& data);
 
+/**
+ * \brief Pack loaded textures in the texture atlas
+ *
+ * Every packed texture is copied in an atlas page and its TextureData is updated with the page
+ * and the area of the texture in it, fge::Texture handles resolve to the new location automatically.
+ * Textures that are too big for a page, repeated or already packed are ignored.
+ * Smooth textures are packed in their own smooth pages, so the filter of every texture is kept.
+ *
+ * This should be done once the textures are loaded and before creating the Objects that use them.
+ * Only Objects that use fge::Texture::getTextureRect() to compute texture coordinates (like ObjSprite)
+ * support packed textures, so textures drawn by raw SFML objects should not be packed.
+ *
+ * \param names The names of the textures to pack, an empty list mean every loaded texture
+ * \return The number of packed textures
+ */
+FGE_API std::size_t PackAtlas(const std::vector<std::string>& names={});
+/**
+ * \brief Get the texture atlas
+ *
+ * You have to provide a valid reference to a unique lock acquire with
+ * the function AcquireLock().
+ *
+ * \see fge::texture::IteratorBegin()
+ *
+ * \param lock A unique lock bound to this mutex
+ * \return The texture atlas
+ */
+FGE_API fge::TextureAtlas& GetAtlas(const std::unique_lock<std::mutex>& lock);
+
 /**
  * @}
  */
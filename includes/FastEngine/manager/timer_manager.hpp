@@ -20,6 +20,7 @@
 #include "FastEngine/fastengine_extern.hpp"
 #include "FastEngine/C_timer.hpp"
 #include "FastEngine/C_callback.hpp"
+#include "FastEngine/C_threadPool.hpp"
 #include <memory>
 #include <string>
 
@@ -28,6 +29,23 @@ namespace fge::timer
 
 using TimerShared = std::shared_ptr<fge::Timer>;
 
+/**
+ * \struct Stats
+ * \brief Statistics on the timer callbacks
+ * \ingroup time
+ *
+ * The latency is the time between the goal of a timer and the call of its callbacks,
+ * it include the time spent in the thread pool or main loop queue.
+ */
+struct Stats
+{
+    uint64_t _callbackCount{0};                         ///< Number of timers that had their callbacks called
+    std::chrono::milliseconds _totalLatency{0};         ///< Sum of the latencies
+    std::chrono::milliseconds _maxLatency{0};           ///< Highest latency
+    std::size_t _queuedCount{0};                        ///< Callbacks waiting for ProcessQueuedCallbacks()
+    uint64_t _droppedCount{0};                          ///< Queued callbacks dropped after the queue timeout
+};
+
 /**
  * \ingroup time
  * @{
@@ -51,13 +69,83 @@ FGE_API bool IsInit();
 FGE_API void Uninit();
 
 /**
- * \brief Notify the timer manager thread generally used after adding/updating a timer.
+ * \brief Set the thread pool used by timers with the DISPATCH_THREAD_POOL policy
+ *
+ * The thread pool must outlive the timer manager or be replaced before being destroyed.
+ * Without a thread pool, those timers are dispatched inline.
+ *
+ * \param threadPool The thread pool or \b nullptr
+ */
+FGE_API void SetThreadPool(fge::ThreadPool* threadPool);
+/**
+ * \brief Get the thread pool used by timers with the DISPATCH_THREAD_POOL policy
+ *
+ * \return The thread pool or \b nullptr
+ */
+FGE_API fge::ThreadPool* GetThreadPool();
+
+/**
+ * \brief Call the callbacks of the timers with the DISPATCH_MAIN_LOOP policy
+ *
+ * This is usually called once per frame from the main loop (next to fge::Scene::update()).
+ * A queued timer stay handled by the manager until its callbacks are called, so without a
+ * queue timeout (see SetQueueTimeout()) it is never released if this function is not called.
+ *
+ * \return The number of timers that were processed
+ */
+FGE_API std::size_t ProcessQueuedCallbacks();
+/**
+ * \brief Set the maximum time a DISPATCH_MAIN_LOOP timer can wait in the queue
+ *
+ * Once the timeout is reached, the timer is removed from the manager without calling its
+ * callbacks and counted in Stats::_droppedCount. The queue is checked by the timer thread at
+ * least every second.
+ *
+ * \param timeout The timeout, 0 (the default) keep the queued timers until they are processed
+ */
+FGE_API void SetQueueTimeout(const std::chrono::milliseconds& timeout);
+/**
+ * \brief Get the maximum time a DISPATCH_MAIN_LOOP timer can wait in the queue
+ *
+ * \return The timeout, 0 if disabled
+ */
+FGE_API std::chrono::milliseconds GetQueueTimeout();
+
+/**
+ * \brief Get the statistics on the timer callbacks
+ *
+ * \return The statistics
+ */
+FGE_API fge::timer::Stats GetStats();
+/**
+ * \brief Reset the statistics on the timer callbacks (except the queued count)
+ */
+FGE_API void ResetStats();
+
+/**
+ * \brief Notify the timer manager thread generally used after updating timers.
+ *
+ * Every timer is rescheduled by the timer thread, successive calls are merged until the thread wake up.
+ * Prefer Notify(const fge::timer::TimerShared&) when only one timer was modified.
  */
 FGE_API void Notify();
+/**
+ * \brief Reschedule a timer after it was updated.
+ *
+ * This is needed when the timer goal is brought closer (see fge::Timer), the timer is
+ * rescheduled in constant time.
+ *
+ * \param timer The modified timer
+ * \return \b true if the timer is handled by the manager, \b false otherwise
+ */
+FGE_API bool Notify(const fge::timer::TimerShared& timer);
 
 /**
  * \brief Add a new timer to be handled by the thread.
  *
+ * The timer start counting time and is scheduled directly, Notify() is not needed.
+ * Adding a timer that is already handled does nothing.
+ *
  * \param timer The timer to add
  * \return The same timer pointer
  */
@@ -98,6 +186,17 @@ FGE_API bool Check(const fge::timer::TimerShared& timer);
  */
 FGE_API bool Check(const std::string& timerName);
 
+/**
+ * \brief Rename a timer handled by the manager.
+ *
+ * Timers are indexed by name, fge::Timer::setName() should not be used once the timer is created.
+ *
+ * \param timer The timer to rename
+ * \param name The new name
+ * \return \b true if the timer was renamed, \b false if the timer is not handled by the manager
+ */
+FGE_API bool Rename(const fge::timer::TimerShared& timer, const std::string& name);
+
 /**
  * \brief Get the total number of timers
  *
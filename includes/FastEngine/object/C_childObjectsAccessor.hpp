@@ -25,6 +25,8 @@
 #include <limits>
 #include <memory>
 
+#define FGE_CHILDOBJECTS_DEFAULT_CACHE_BUDGET (64*1024*1024)
+
 namespace fge
 {
 
@@ -46,6 +48,11 @@ public:
     ChildObjectsAccessor() = default;
     ChildObjectsAccessor([[maybe_unused]]const ChildObjectsAccessor& r){};
     ChildObjectsAccessor([[maybe_unused]]ChildObjectsAccessor&& r) noexcept {};
+#ifdef FGE_DEF_SERVER
+    ~ChildObjectsAccessor() = default;
+#else
+    ~ChildObjectsAccessor() override = default;
+#endif //FGE_DEF_SERVER
 
     ChildObjectsAccessor& operator=([[maybe_unused]]const ChildObjectsAccessor& r){return *this;};
     ChildObjectsAccessor& operator=([[maybe_unused]]ChildObjectsAccessor&& r) noexcept {return *this;};
@@ -68,6 +75,41 @@ public:
 #else
     void update(sf::RenderWindow& screen, fge::Event& event, const std::chrono::milliseconds& deltaTime, fge::Scene* scene);
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    /**
+     * \brief Enable the render cache of the children
+     *
+     * When enabled, the children are rendered once in an offscreen texture that is then drawn
+     * as a single textured quad. The texture is rendered again when a child (recursively) is
+     * added, removed or reordered, when one of its network values is applied or when a built-in
+     * object change its content (texture, color, text ...).
+     * Moving a child or modifying a custom object must be notified with Object::invalidateParentsCache(),
+     * so this should not be enabled on animated children.
+     *
+     * The texture follow the resolution of the target, a scaled parent is not blurred.
+     *
+     * Caches share a global memory budget, the least recently drawn caches are released first
+     * when it's exceeded.
+     *
+     * \param enable \b true to enable the cache
+     */
+    void setCacheEnabled(bool enable);
+    [[nodiscard]] bool isCacheEnabled() const;
+    /**
+     * \brief Force the children to be rendered again in the cache on the next draw
+     *
+     * Only this cache is invalidated, see Object::invalidateParentsCache() to invalidate every parent.
+     */
+    void invalidateCache();
+
+    /**
+     * \brief Set the total memory (in bytes) that can be used by all the render caches
+     *
+     * \param bytes The memory budget
+     */
+    static void SetCacheMemoryBudget(std::size_t bytes);
+    [[nodiscard]] static std::size_t GetCacheMemoryBudget();
+    [[nodiscard]] static std::size_t GetCacheMemoryUsage();
 #endif //FGE_DEF_SERVER
 
     void putInFront(std::size_t index);
@@ -89,8 +131,24 @@ private:
         fge::ObjectDataShared _objData;
     };
 
+    void onStructureChanged();
+
     std::vector<DataContext> g_data;
     mutable std::size_t g_actualIteratedIndex{std::numeric_limits<std::size_t>::max()};
+    fge::ObjectDataWeak g_parent;
+
+#ifndef FGE_DEF_SERVER
+    struct RenderCache;
+    struct RenderCacheDeleter
+    {
+        void operator()(RenderCache* cache) const;
+    };
+
+    void drawChildren(sf::RenderTarget& target, const sf::RenderStates& states) const;
+    void attachNetwork(RenderCache& cache) const;
+
+    std::unique_ptr<RenderCache, RenderCacheDeleter> g_cache;
+#endif //FGE_DEF_SERVER
 };
 
 }//end fge
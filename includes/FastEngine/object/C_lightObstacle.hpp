@@ -34,6 +34,7 @@ using ListOfPoints = std::vector<sf::Vector2f>;
  * \brief A base class to define an obstacle for the light system
  *
  * An obstacle is a group of points that define the shape of the object.
+ * invalidateObstacle() must be called after the points are modified.
  */
 class LightObstacle : public fge::ObstacleComponent
 {
@@ -53,6 +54,7 @@ public:
         this->_g_lightSystemGate = r._g_lightSystemGate;
         this->_g_myPoints = r._g_myPoints;
         this->_g_lightSystemGate.setData(this);
+        this->invalidateObstacle();
         return *this;
     }
 
@@ -60,6 +62,7 @@ protected:
     fge::ListOfPoints _g_myPoints;
 
     friend class fge::ObjLight;
+    friend class fge::LightSystem;
 };
 
 }//end fge
@@ -17,22 +17,170 @@
 #ifndef _FGE_C_LIGHTSYSTEM_HPP_INCLUDED
 #define _FGE_C_LIGHTSYSTEM_HPP_INCLUDED
 
+#include "FastEngine/fastengine_extern.hpp"
 #include "FastEngine/C_tunnel.hpp"
 #include "FastEngine/C_scene.hpp"
+#include "SFML/Graphics/Rect.hpp"
+#include <unordered_map>
+#include <vector>
 
 #define FGE_LIGHT_PROPERTY_DEFAULT_LS "_fge_def_ls"
+#define FGE_LIGHT_DEFAULT_CELL_SIZE 256.0f
 
 namespace fge
 {
 
 class LightObstacle;
+class LightComponent;
+class ThreadPool;
+
+using LightSystemGate = fge::TunnelGate<fge::LightObstacle>;
+
+/**
+ * \struct ShadowScratch
+ * \ingroup graphics
+ * \brief Temporary buffers used while computing shadow geometry
+ *
+ * There is one scratch by worker thread, so lights can be processed concurrently.
+ */
+struct ShadowScratch
+{
+    std::vector<sf::Vector2f> _hull;
+};
 
 /**
+ * \class LightSystem
  * \ingroup graphics
  * \brief An fge::Tunnel class that regroups all the lights and obstacles as a tunnel.
+ *
+ * The light system also keep a spatial index (a uniform grid) of the obstacles bounds,
+ * so a light can only retrieve the obstacles that are inside its range.
+ *
+ * Obstacles are free to move their points at any time, but they must notify the system
+ * with ObstacleComponent::invalidateObstacle() so only their cells are updated on the next
+ * updateIndex(). The whole index is only rebuilt after a call to invalidate() or when the
+ * number of obstacles change.
+ *
+ * Every light that use this system is registered, so the CPU part of the shadows
+ * (hull projection) can be computed for all visible lights at once with computeShadows(),
+ * in parallel if a thread pool is set. A light is only computed again after it have been
+ * invalidated or after an obstacle have moved.
  */
-using LightSystem = fge::Tunnel<fge::LightObstacle>;
-using LightSystemGate = fge::TunnelGate<fge::LightObstacle>;
+class FGE_API LightSystem : public fge::Tunnel<fge::LightObstacle>
+{
+public:
+    LightSystem() = default;
+    LightSystem(fge::LightSystem&& r) noexcept;
+    ~LightSystem();
+
+    fge::LightSystem& operator =(fge::LightSystem&& r) noexcept;
+
+    /**
+     * \brief Set the size of a cell of the spatial index
+     *
+     * \param size The size of a cell in world coordinates
+     */
+    void setCellSize(float size);
+    [[nodiscard]] float getCellSize() const;
+
+    /**
+     * \brief Set the thread pool used to compute the shadows
+     *
+     * \param threadPool The thread pool or \b nullptr to compute them on the calling thread
+     */
+    void setThreadPool(fge::ThreadPool* threadPool);
+    [[nodiscard]] fge::ThreadPool* getThreadPool() const;
+
+    /**
+     * \brief Mark the whole spatial index and the shadows as outdated
+     */
+    void invalidate();
+    /**
+     * \brief Mark an obstacle as moved
+     *
+     * Only the cells of this obstacle are updated on the next updateIndex().
+     *
+     * \param obstacle The obstacle that have changed its points
+     */
+    void invalidateObstacle(const fge::LightObstacle* obstacle);
+    /**
+     * \brief Rebuild the spatial index if it's outdated
+     */
+    void updateIndex();
+
+    /**
+     * \brief Retrieve all obstacles that can intersect a rectangle
+     *
+     * The buffer is cleared first, every obstacle is present only once.
+     * This function don't modify the light system and is safe to call concurrently,
+     * the index must be up to date (see updateIndex()).
+     *
+     * \param rect The rectangle in world coordinates
+     * \param buff The buffer that receive the obstacles
+     * \return The number of obstacles found
+     */
+    std::size_t getObstacles(const sf::FloatRect& rect, std::vector<fge::LightObstacle*>& buff) const;
+
+    /**
+     * \brief Compute the shadow geometry of every outdated light that is visible
+     *
+     * Only the lights with bounds that intersect the visible area are computed, the others
+     * are computed when needed with computeShadows(fge::LightComponent&).
+     * Nothing is done if nothing have changed since the last call with the same area.
+     *
+     * \param visibleArea The visible area of the target in world coordinates
+     */
+    void computeShadows(const sf::FloatRect& visibleArea);
+    /**
+     * \brief Compute the shadow geometry of one light if it's outdated
+     *
+     * \param light A light registered to this system
+     */
+    void computeShadows(const fge::LightComponent& light);
+
+    [[nodiscard]] std::size_t getLightsSize() const;
+
+private:
+    struct Entry
+    {
+        fge::LightObstacle* _obstacle;
+        sf::FloatRect _bounds;
+        int32_t _cellX;
+        int32_t _cellY;
+        int32_t _cellEndX;
+        int32_t _cellEndY;
+    };
+
+    [[nodiscard]] bool computeEntry(fge::LightObstacle* obstacle, fge::LightSystem::Entry& entry) const;
+    void insertEntry(std::size_t index);
+    void eraseEntry(std::size_t index);
+    void rebuildIndex();
+    void updateObstaclesSystem();
+
+    void addLight(fge::LightComponent* light);
+    void removeLight(fge::LightComponent* light);
+
+    [[nodiscard]] static uint64_t getCellKey(int32_t x, int32_t y);
+
+    float g_cellSize{FGE_LIGHT_DEFAULT_CELL_SIZE};
+    bool g_dirty{true};
+    bool g_shadowsComputed{false};
+    uint64_t g_shadowVersion{1};
+    sf::FloatRect g_visibleArea;
+    std::size_t g_lastGatesSize{0};
+
+    std::vector<fge::LightSystem::Entry> g_entries;
+    std::unordered_map<const fge::LightObstacle*, std::size_t> g_entryIndexes;
+    std::unordered_map<uint64_t, std::vector<std::size_t> > g_cells;
+    std::vector<const fge::LightObstacle*> g_movedObstacles;
+
+    std::vector<fge::LightComponent*> g_lights;
+    std::vector<fge::LightComponent*> g_outdatedLights;
+    fge::ThreadPool* g_threadPool{nullptr};
+    std::vector<fge::ShadowScratch> g_scratches;
+
+    friend class fge::LightComponent;
+};
 
 /**
  * \brief Get the default light system from a scene property
@@ -45,7 +193,8 @@ inline fge::LightSystem* GetDefaultLightSystem(fge::Scene* scene)
 {
     if (scene != nullptr)
     {
-        return scene->_properties.getProperty(FGE_LIGHT_PROPERTY_DEFAULT_LS).get<fge::LightSystem*>().value_or(nullptr);
+        static const fge::PropertyKey key{FGE_LIGHT_PROPERTY_DEFAULT_LS};
+        return scene->_properties.getProperty(key).get<fge::LightSystem*>().value_or(nullptr);
     }
     return nullptr;
 }
@@ -62,6 +211,41 @@ public:
             _g_lightSystemGate(lightObstacle)
     {
     }
+    LightComponent(const fge::LightComponent& r) :
+            _g_lightSystemGate(r._g_lightSystemGate)
+    {
+        if (r.g_lightSystem != nullptr)
+        {
+            r.g_lightSystem->addLight(this);
+        }
+    }
+    virtual ~LightComponent()
+    {
+        if (this->g_lightSystem != nullptr)
+        {
+            this->g_lightSystem->removeLight(this);
+        }
+    }
+
+    fge::LightComponent& operator=(const fge::LightComponent& r)
+    {
+        if (this != &r)
+        {
+            this->_g_lightSystemGate = r._g_lightSystemGate;
+            if (this->g_lightSystem != r.g_lightSystem)
+            {
+                if (this->g_lightSystem != nullptr)
+                {
+                    this->g_lightSystem->removeLight(this);
+                }
+                if (r.g_lightSystem != nullptr)
+                {
+                    r.g_lightSystem->addLight(this);
+                }
+            }
+        }
+        return *this;
+    }
 
     /**
      * \brief Set the light system to be used by this light
@@ -71,6 +255,14 @@ public:
     void setLightSystem(fge::LightSystem& lightSystem)
     {
         this->_g_lightSystemGate.openTo(lightSystem, true);
+        if (this->g_lightSystem != &lightSystem)
+        {
+            if (this->g_lightSystem != nullptr)
+            {
+                this->g_lightSystem->removeLight(this);
+            }
+            lightSystem.addLight(this);
+        }
     }
 
     /**
@@ -88,7 +280,65 @@ public:
     }
 
 protected:
+    /**
+     * \brief Get the light system used by this light
+     *
+     * \return The light system or \b nullptr if the light is not registered to one
+     */
+    [[nodiscard]] fge::LightSystem* getLightSystem() const
+    {
+        return this->g_lightSystem;
+    }
+
+    /**
+     * \brief Mark the shadows of this light as outdated
+     *
+     * Must be called when the light have moved or when its range have changed.
+     */
+    void invalidateLight() const
+    {
+        this->g_shadowVersion = 0;
+        if (this->g_lightSystem != nullptr)
+        {
+            this->g_lightSystem->g_shadowsComputed = false;
+        }
+    }
+    /**
+     * \brief Mark only the shadows of this light as outdated
+     *
+     * Unlike invalidateLight(), the batched pass of the light system is not started again, the light
+     * is computed alone by LightSystem::computeShadows(const fge::LightComponent&).
+     */
+    void invalidateLightOnly() const
+    {
+        this->g_shadowVersion = 0;
+    }
+
+    /**
+     * \brief Get the bounds of the area lit by this light in world coordinates
+     *
+     * Used by the light system to skip the lights that are not visible.
+     */
+    [[nodiscard]] virtual sf::FloatRect getLightBounds() const = 0;
+
+    /**
+     * \brief Compute the CPU part of the shadows of this light
+     *
+     * This function is called by the light system, possibly from a worker thread and
+     * concurrently with other lights, so it must not draw anything.
+     *
+     * \param lightSystem The light system
+     * \param scratch A temporary buffer owned by the current worker
+     */
+    virtual void computeShadows([[maybe_unused]] const fge::LightSystem& lightSystem, [[maybe_unused]] fge::ShadowScratch& scratch) const {}
+
     fge::LightSystemGate _g_lightSystemGate;
+
+private:
+    fge::LightSystem* g_lightSystem{nullptr};
+    mutable uint64_t g_shadowVersion{0};
+
+    friend class fge::LightSystem;
 };
 
 /**
@@ -103,15 +353,28 @@ public:
             _g_lightSystemGate(lightObstacle)
     {
     }
+    ObstacleComponent(const fge::ObstacleComponent& r) = default;
+    ~ObstacleComponent()
+    {//The gate is still open here, the index must not keep this obstacle
+        auto* lightSystem = this->getLightSystem();
+        if (lightSystem != nullptr)
+        {
+            lightSystem->invalidate();
+        }
+    }
+
+    fge::ObstacleComponent& operator=(const fge::ObstacleComponent& r) = default;
 
     /**
-     * \brief Set the light system to be used by this light
+     * \brief Set the light system to be used by this obstacle
      *
      * \param lightSystem The light system to use
      */
     void setLightSystem(fge::LightSystem& lightSystem)
     {
         this->_g_lightSystemGate.openTo(lightSystem, false);
+        this->g_lightSystem = &lightSystem;
+        lightSystem.invalidate();
     }
 
     /**
@@ -128,8 +391,42 @@ public:
         }
     }
 
+    /**
+     * \brief Notify the light system that the points of this obstacle have changed
+     *
+     * This must be called every time the points are modified, or the lights will keep
+     * the old shadows.
+     */
+    void invalidateObstacle()
+    {
+        auto* lightSystem = this->getLightSystem();
+        if (lightSystem != nullptr)
+        {
+            lightSystem->invalidateObstacle(this->_g_lightSystemGate.getData());
+        }
+    }
+
 protected:
+    /**
+     * \brief Get the light system used by this obstacle
+     *
+     * \return The light system or \b nullptr if the gate is not opened to a light system
+     */
+    [[nodiscard]] fge::LightSystem* getLightSystem() const
+    {
+        if (this->_g_lightSystemGate.isOpen() && this->_g_lightSystemGate.getTunnel() == this->g_lightSystem)
+        {
+            return this->g_lightSystem;
+        }
+        return nullptr;
+    }
+
     fge::LightSystemGate _g_lightSystemGate;
+
+private:
+    fge::LightSystem* g_lightSystem{nullptr};
+
+    friend class fge::LightSystem;
 };
 
 }//end fge
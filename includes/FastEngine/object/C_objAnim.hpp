@@ -58,6 +58,7 @@ public:
 
     FGE_OBJ_UPDATE_DECLARE
     FGE_OBJ_DRAW_DECLARE
+    FGE_OBJ_DRAWBATCHED_DECLARE
 
     void save(nlohmann::json& jsonObject, fge::Scene* scene) override;
     void load(nlohmann::json& jsonObject, fge::Scene* scene) override;
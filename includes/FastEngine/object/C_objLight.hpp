@@ -24,6 +24,8 @@
 #include "FastEngine/C_texture.hpp"
 #include "C_lightSystem.hpp"
 #include "C_objRenderMap.hpp"
+#include "SFML/Graphics/VertexArray.hpp"
+#include <vector>
 
 #define FGE_OBJLIGHT_CLASSNAME "FGE:OBJ:LIGHT"
 
@@ -50,6 +52,15 @@ public:
 
     void setColor(const sf::Color& color);
 
+    /**
+     * \brief Force the light map to be rendered again on the next draw
+     *
+     * The light map is only rendered again when the light or a nearby obstacle have changed,
+     * this is useful if the content of the texture has been modified.
+     * The shadows of this light are also computed again.
+     */
+    void invalidateShadowCache();
+
     const fge::Texture& getTexture() const;
     const sf::IntRect& getTextureRect() const;
 
@@ -70,9 +81,34 @@ public:
     sf::FloatRect getGlobalBounds() const override;
     sf::FloatRect getLocalBounds() const override;
 
+protected:
+    sf::FloatRect getLightBounds() const override;
+    void computeShadows(const fge::LightSystem& lightSystem, fge::ShadowScratch& scratch) const override;
+
 private:
     void updatePositions();
     void updateTexCoords();
+#ifndef FGE_DEF_SERVER
+    void computeShadowGeometry(const fge::LightSystem* lightSystem, fge::ShadowScratch& scratch) const;
+    bool updateShadowCache() const;
+    [[nodiscard]] bool hasMoved() const;
+
+    struct ShadowCache
+    {
+        struct ObstacleEntry
+        {
+            const fge::LightObstacle* _obstacle{nullptr};
+            uint64_t _pointsHash{0};
+        };
+
+        bool _valid{false};
+        sf::Transform _transform;
+        sf::Transform _parentTransform;
+        sf::Transform _viewTransform;
+        sf::Vector2u _mapSize;
+        std::vector<ObstacleEntry> _obstacles;
+    };
+#endif //FGE_DEF_SERVER
 
     sf::Vertex g_vertices[4];
     fge::Texture g_texture;
@@ -82,6 +118,12 @@ private:
 
 #ifndef FGE_DEF_SERVER
     fge::ObjRenderMap g_renderMap;
+
+    mutable std::vector<fge::LightObstacle*> g_obstacles;
+    mutable sf::VertexArray g_shadowVertices{sf::PrimitiveType::Triangles};
+    mutable ShadowCache g_shadowCache;
+    mutable bool g_shadowComputed{false};
+    mutable bool g_shadowOutdated{true};
 #endif //FGE_DEF_SERVER
     sf::BlendMode g_blendMode;
 };
@@ -46,6 +46,7 @@ public:
     const sf::Color& getColor() const;
 
     FGE_OBJ_DRAW_DECLARE
+    FGE_OBJ_DRAWBATCHED_DECLARE
 
     void save(nlohmann::json& jsonObject, fge::Scene* scene) override;
     void load(nlohmann::json& jsonObject, fge::Scene* scene) override;
@@ -128,10 +128,20 @@ public:
 
     sf::Vector2f findCharacterPos(std::size_t index) const;
 
+    /**
+     * \brief Get the characters of the text
+     *
+     * The characters can be modified (color, visibility, transform ...), every character
+     * is merged in one vertex array before being drawn, so calling this non-const
+     * function request this array to be rebuilt on the next draw.
+     *
+     * \return The characters
+     */
     std::vector<fge::Character>& getCharacters();
     const std::vector<fge::Character>& getCharacters() const;
 
     FGE_OBJ_DRAW_DECLARE
+    FGE_OBJ_DRAWBATCHED_DECLARE
 
     void save(nlohmann::json& jsonObject, fge::Scene* scene) override;
     void load(nlohmann::json& jsonObject, fge::Scene* scene) override;
@@ -146,6 +156,18 @@ public:
 
 private:
     void ensureGeometryUpdate() const;
+    void ensureRunUpdate() const;
+
+    struct LayoutState
+    {
+        std::size_t _characterCount;
+        sf::Vector2f _position;
+        uint32_t _prevChar;
+        float _minX;
+        float _minY;
+        float _maxX;
+        float _maxY;
+    };
 
     tiny_utf8::string g_string; /// String to display
     fge::Font g_font; /// Font used to display the string
@@ -161,6 +183,11 @@ private:
     mutable sf::FloatRect g_bounds; /// Bounding rectangle of the text (in local coordinates)
     mutable bool g_geometryNeedUpdate{false}; /// Does the geometry need to be recomputed?
     mutable uint64_t g_fontTextureId{0}; /// The font texture id
+
+    mutable std::vector<LayoutState> g_layout; /// Layout state before every code point (and at the end), used to rebuild only a changed tail
+    mutable std::size_t g_validCodePoints{0}; /// Number of code points at the start of the string with a valid geometry
+    mutable sf::VertexArray g_runVertices{sf::PrimitiveType::Triangles}; /// Every visible character merged, drawn in one call
+    mutable bool g_runNeedUpdate{true}; /// Does the merged vertex array need to be recomputed?
 };
 
 }//end fge
@@ -21,6 +21,7 @@
 #include "FastEngine/object/C_object.hpp"
 #include "FastEngine/object/C_objText.hpp"
 #include "FastEngine/C_guiElement.hpp"
+#include "FastEngine/C_spriteBatch.hpp"
 #include <deque>
 
 #define FGE_OBJTEXTLIST_CLASSNAME "FGE:OBJ:TEXTLIST"
@@ -48,8 +49,25 @@ public:
 
     void addString(tiny_utf8::string string);
     std::size_t getStringsSize() const;
+    /**
+     * \brief Get a modifiable string
+     *
+     * The line is marked as modified, so its text is updated on the next draw.
+     *
+     * \param index The index of the string (0 is the last added string)
+     * \return The string
+     */
     tiny_utf8::string& getString(std::size_t index);
     const tiny_utf8::string& getString(std::size_t index) const;
+    /**
+     * \brief Get the text used to draw a string
+     *
+     * The text is updated first if the string or the style have changed.
+     *
+     * \param index The index of the string (0 is the last added string)
+     * \return The text
+     */
+    const fge::ObjText& getText(std::size_t index) const;
     void removeAllStrings();
 
     void setFont(fge::Font font);
@@ -70,7 +88,21 @@ private:
     void onGuiResized(const fge::GuiElementHandler& handler, const sf::Vector2f& size);
     void refreshSize(const sf::Vector2f& targetSize);
 
-    mutable fge::ObjText g_text;
+    void applyTextStyle(fge::ObjText& text) const;
+    void invalidateTexts();
+    fge::ObjText& updateText(std::size_t index) const;
+
+    struct Line
+    {
+        fge::ObjText _text;
+        bool _needUpdate{false};
+    };
+
+    fge::ObjText g_text; ///< The text that hold the style of every line
+    mutable std::deque<Line> g_lines; ///< One text by string, only updated when its string or the style change
+#ifndef FGE_DEF_SERVER
+    mutable fge::SpriteBatch g_batch; ///< Every visible line is drawn in one call
+#endif //FGE_DEF_SERVER
 
     fge::GuiElementHandler* g_guiElementHandler{nullptr};
 
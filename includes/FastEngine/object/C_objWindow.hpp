@@ -22,6 +22,7 @@
 #include "FastEngine/C_scene.hpp"
 
 #include "FastEngine/C_tileset.hpp"
+#include "FastEngine/C_nineSliceMesh.hpp"
 #include "FastEngine/object/C_objSprite.hpp"
 #include "FastEngine/object/C_objText.hpp"
 #include "FastEngine/C_guiElement.hpp"
@@ -115,6 +116,8 @@ private:
 
     void onRefreshGlobalScale(const sf::Vector2f& scale);
 
+    void updateMesh() const;
+
     bool g_movingWindowFlag{false};
     bool g_resizeWindowFlag{false};
     sf::Vector2f g_mouseClickLastPosition;
@@ -144,6 +147,8 @@ private:
     sf::FloatRect g_windowResizeRect;
     
     mutable fge::ObjSprite g_sprite;
+    mutable fge::NineSliceMesh g_mesh;
+    mutable bool g_meshNeedUpdate{true};
 };
 
 }//end fge
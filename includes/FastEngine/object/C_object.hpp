@@ -60,6 +60,14 @@
 
 #define FGE_OBJ_DRAW_BODY(class_) void class_::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
+#ifdef FGE_DEF_SERVER
+    #define FGE_OBJ_DRAWBATCHED_DECLARE
+#else
+    #define FGE_OBJ_DRAWBATCHED_DECLARE bool drawBatched(fge::SpriteBatch& batch, sf::RenderStates states) const override;
+#endif //FGE_DEF_SERVER
+
+#define FGE_OBJ_DRAWBATCHED_BODY(class_) bool class_::drawBatched(fge::SpriteBatch& batch, sf::RenderStates states) const
+
 namespace fge
 {
 
@@ -67,6 +75,7 @@ class GuiElementHandler;
 class GuiElement;
 
 class Scene;
+class SpriteBatch;
 
 class ObjectData;
 using ObjectDataWeak = std::weak_ptr<fge::ObjectData>;
@@ -131,6 +140,19 @@ public:
      */
 #ifndef FGE_DEF_SERVER
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+#endif //FGE_DEF_SERVER
+    /**
+     * \brief Method called instead of draw() when the Scene is batching
+     *
+     * An object that override this method submit its geometry in the batch instead of
+     * drawing it, the default implementation return \b false so the Scene fallback on draw().
+     *
+     * \param batch The batch where the geometry is submitted
+     * \param states The SFML render states
+     * \return \b true if the object was fully submitted in the batch
+     */
+#ifndef FGE_DEF_SERVER
+    virtual bool drawBatched(fge::SpriteBatch& batch, sf::RenderStates states) const;
 #endif //FGE_DEF_SERVER
     /**
      * \brief Register all network types needed by the object
@@ -238,6 +260,14 @@ public:
      * \return Parents scale
      */
     sf::Vector2f getParentsScale() const;
+    /**
+     * \brief Tell every parent that this object have changed
+     *
+     * A parent with a render cache (see ChildObjectsAccessor::setCacheEnabled) will render its children
+     * again on the next draw. This must be called when the content or the transform of a child is
+     * modified, built-in objects already do it when their content change.
+     */
+    void invalidateParentsCache() const;
 
     //Data
 
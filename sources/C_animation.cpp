@@ -481,8 +481,12 @@ Animation::operator sf::IntRect() const
     {
         if ( this->isFrameValid() )
         {
-            auto gridSize = static_cast<sf::Vector2i>(this->g_data->_groups[this->g_groupIndex]._frames[this->g_frameIndex]._texture->getSize());
-            return {{0,0}, gridSize};
+            const auto& frame = this->g_data->_groups[this->g_groupIndex]._frames[this->g_frameIndex];
+            if (frame._textureRect.width != 0)
+            {//Packed in an atlas
+                return frame._textureRect;
+            }
+            return {{0,0}, static_cast<sf::Vector2i>(frame._texture->getSize())};
         }
     }
     return {{0,0}, static_cast<sf::Vector2i>(fge::texture::GetBadTexture()->_texture->getSize())};
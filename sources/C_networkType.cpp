@@ -314,7 +314,7 @@ float NetworkTypeSmoothFloat::getErrorRange() const
 
 NetworkTypeTag::NetworkTypeTag(fge::TagList* source, std::string tag) :
     g_typeSource(source),
-    g_tag(std::move(tag))
+    g_tag(fge::tag::Intern(tag))
 {
 }
 
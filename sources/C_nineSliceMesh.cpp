@@ -0,0 +1,215 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_nineSliceMesh.hpp"
+#ifndef FGE_DEF_SERVER
+    #include "FastEngine/C_spriteBatch.hpp"
+#endif //FGE_DEF_SERVER
+#include <algorithm>
+
+namespace fge
+{
+
+void NineSliceMesh::setTexture(fge::Texture texture)
+{
+    this->g_texture = std::move(texture);
+    this->g_geometryNeedUpdate = true;
+}
+const fge::Texture& NineSliceMesh::getTexture() const
+{
+    return this->g_texture;
+}
+
+void NineSliceMesh::setSlice(fge::NineSliceMesh::Slices slice, const sf::IntRect& textureRect)
+{
+    if (this->g_slices[slice] != textureRect)
+    {
+        this->g_slices[slice] = textureRect;
+        this->g_geometryNeedUpdate = true;
+    }
+}
+const sf::IntRect& NineSliceMesh::getSlice(fge::NineSliceMesh::Slices slice) const
+{
+    return this->g_slices[slice];
+}
+
+void NineSliceMesh::setSize(const sf::Vector2f& size)
+{
+    if (this->g_size != size)
+    {
+        this->g_size = size;
+        this->g_geometryNeedUpdate = true;
+    }
+}
+const sf::Vector2f& NineSliceMesh::getSize() const
+{
+    return this->g_size;
+}
+
+void NineSliceMesh::setCenterMargin(float margin)
+{
+    if (this->g_centerMargin != margin)
+    {
+        this->g_centerMargin = margin;
+        this->g_geometryNeedUpdate = true;
+    }
+}
+float NineSliceMesh::getCenterMargin() const
+{
+    return this->g_centerMargin;
+}
+
+void NineSliceMesh::setColor(const sf::Color& color)
+{
+    this->g_color = color;
+    for (auto& vertex : this->g_vertices)
+    {
+        vertex.color = color;
+    }
+}
+const sf::Color& NineSliceMesh::getColor() const
+{
+    return this->g_color;
+}
+
+void NineSliceMesh::addExtraPiece(const sf::IntRect& textureRect, const sf::FloatRect& area)
+{
+    this->g_extraPieces.push_back({textureRect, area});
+    this->g_geometryNeedUpdate = true;
+}
+void NineSliceMesh::clearExtraPieces()
+{
+    if (!this->g_extraPieces.empty())
+    {
+        this->g_extraPieces.clear();
+        this->g_geometryNeedUpdate = true;
+    }
+}
+
+std::size_t NineSliceMesh::getVertexCount() const
+{
+    this->ensureGeometryUpdate();
+    return this->g_vertices.size();
+}
+const std::vector<sf::Vertex>& NineSliceMesh::getVertices() const
+{
+    this->ensureGeometryUpdate();
+    return this->g_vertices;
+}
+
+#ifndef FGE_DEF_SERVER
+void NineSliceMesh::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    this->ensureGeometryUpdate();
+
+    if (!this->g_vertices.empty())
+    {
+        states.texture = static_cast<const sf::Texture*>(this->g_texture);
+        target.draw(this->g_vertices.data(), this->g_vertices.size(), sf::Triangles, states);
+    }
+}
+void NineSliceMesh::drawBatched(fge::SpriteBatch& batch, sf::RenderStates states) const
+{
+    this->ensureGeometryUpdate();
+
+    if (!this->g_vertices.empty())
+    {
+        states.texture = static_cast<const sf::Texture*>(this->g_texture);
+        batch.addTriangles(this->g_vertices.data(), this->g_vertices.size(), states);
+    }
+}
+#endif //FGE_DEF_SERVER
+
+void NineSliceMesh::ensureGeometryUpdate() const
+{
+    //The texture can be packed in an atlas (or moved in another page) after the geometry was built
+    const sf::IntRect textureRect = this->g_texture.getTextureRect();
+    if (!this->g_geometryNeedUpdate && textureRect == this->g_textureRect)
+    {
+        return;
+    }
+    this->g_geometryNeedUpdate = false;
+    this->g_textureRect = textureRect;
+
+    this->g_vertices.clear();
+
+    const auto left = static_cast<float>(this->g_slices[SLICE_TOP_LEFT].width);
+    const auto right = static_cast<float>(this->g_slices[SLICE_TOP_RIGHT].width);
+    const auto top = static_cast<float>(this->g_slices[SLICE_TOP_LEFT].height);
+    const auto bottom = static_cast<float>(this->g_slices[SLICE_BOTTOM_LEFT].height);
+
+    const float innerWidth = std::max(this->g_size.x - left - right, 0.0f);
+    const float innerHeight = std::max(this->g_size.y - top - bottom, 0.0f);
+
+    //Center
+    if (this->g_centerMargin < 0.0f)
+    {
+        this->addPiece(this->g_slices[SLICE_CENTER], {left, top, innerWidth, innerHeight});
+    }
+    else
+    {
+        this->addPiece(this->g_slices[SLICE_CENTER], {this->g_centerMargin, this->g_centerMargin,
+                                                      std::max(this->g_size.x - this->g_centerMargin*2.0f, 0.0f),
+                                                      std::max(this->g_size.y - this->g_centerMargin*2.0f, 0.0f)});
+    }
+
+    for (const auto& piece : this->g_extraPieces)
+    {
+        this->addPiece(piece._textureRect, piece._area);
+    }
+
+    //Edges
+    this->addPiece(this->g_slices[SLICE_TOP], {left, 0.0f, innerWidth, top});
+    this->addPiece(this->g_slices[SLICE_BOTTOM], {left, this->g_size.y - bottom, innerWidth, bottom});
+    this->addPiece(this->g_slices[SLICE_LEFT], {0.0f, top, left, innerHeight});
+    this->addPiece(this->g_slices[SLICE_RIGHT], {this->g_size.x - right, top, right, innerHeight});
+
+    //Corners
+    this->addPiece(this->g_slices[SLICE_TOP_LEFT], {0.0f, 0.0f, left, top});
+    this->addPiece(this->g_slices[SLICE_TOP_RIGHT], {this->g_size.x - right, 0.0f, right, top});
+    this->addPiece(this->g_slices[SLICE_BOTTOM_LEFT], {0.0f, this->g_size.y - bottom, left, bottom});
+    this->addPiece(this->g_slices[SLICE_BOTTOM_RIGHT], {this->g_size.x - right, this->g_size.y - bottom, right, bottom});
+}
+
+void NineSliceMesh::addPiece(const sf::IntRect& textureRect, const sf::FloatRect& area) const
+{
+    if (textureRect.width == 0 || textureRect.height == 0 || area.width <= 0.0f || area.height <= 0.0f)
+    {
+        return;
+    }
+
+    //The texture can be packed in an atlas page
+    const sf::IntRect& offset = this->g_textureRect;
+
+    const float u1 = static_cast<float>(offset.left + textureRect.left);
+    const float v1 = static_cast<float>(offset.top + textureRect.top);
+    const float u2 = u1 + static_cast<float>(textureRect.width);
+    const float v2 = v1 + static_cast<float>(textureRect.height);
+
+    const float x1 = area.left;
+    const float y1 = area.top;
+    const float x2 = area.left + area.width;
+    const float y2 = area.top + area.height;
+
+    this->g_vertices.emplace_back(sf::Vector2f{x1, y1}, this->g_color, sf::Vector2f{u1, v1});
+    this->g_vertices.emplace_back(sf::Vector2f{x2, y1}, this->g_color, sf::Vector2f{u2, v1});
+    this->g_vertices.emplace_back(sf::Vector2f{x1, y2}, this->g_color, sf::Vector2f{u1, v2});
+    this->g_vertices.emplace_back(sf::Vector2f{x1, y2}, this->g_color, sf::Vector2f{u1, v2});
+    this->g_vertices.emplace_back(sf::Vector2f{x2, y1}, this->g_color, sf::Vector2f{u2, v1});
+    this->g_vertices.emplace_back(sf::Vector2f{x2, y2}, this->g_color, sf::Vector2f{u2, v2});
+}
+
+}//end fge
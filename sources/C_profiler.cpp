@@ -0,0 +1,272 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_profiler.hpp"
+#include "FastEngine/extra/extra_function.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace fge::prof
+{
+
+namespace
+{
+
+struct ThreadBuffer
+{
+    ThreadBuffer(std::size_t capacity, uint32_t index) :
+            _events(capacity),
+            _mask(capacity-1),
+            _index(index)
+    {}
+
+    std::vector<fge::prof::Event> _events;
+    std::size_t _mask;
+    uint32_t _index;
+    std::atomic<std::size_t> _write{0};
+    std::atomic<std::size_t> _read{0};
+    std::atomic<std::size_t> _dropped{0};
+};
+
+std::atomic<bool> _dataEnabled{false};
+std::atomic<std::size_t> _dataBufferCapacity{FGE_PROF_DEFAULT_BUFFER_CAPACITY};
+
+std::mutex _dataBuffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer> > _dataBuffers;
+thread_local std::shared_ptr<ThreadBuffer> _dataLocalBuffer;
+
+std::mutex _dataTraceMutex;
+std::deque<fge::prof::Event> _dataTrace;
+std::size_t _dataTraceCapacity{FGE_PROF_DEFAULT_TRACE_CAPACITY};
+const fge::prof::Clock::time_point _dataEpoch = fge::prof::Clock::now();
+
+ThreadBuffer* GetLocalBuffer()
+{
+    if (!_dataLocalBuffer)
+    {
+        std::size_t capacity = 1;
+        while (capacity < _dataBufferCapacity.load(std::memory_order_relaxed))
+        {
+            capacity <<= 1;
+        }
+
+        std::scoped_lock<std::mutex> lck(_dataBuffersMutex);
+        _dataLocalBuffer = std::make_shared<ThreadBuffer>(capacity, static_cast<uint32_t>(_dataBuffers.size()));
+        _dataBuffers.push_back(_dataLocalBuffer);
+    }
+    return _dataLocalBuffer.get();
+}
+
+const char* GetEventCategory(fge::prof::EventTypes type)
+{
+    switch (type)
+    {
+    case fge::prof::EventTypes::EVENT_SCENE_UPDATE:
+    case fge::prof::EventTypes::EVENT_OBJECT_UPDATE:
+        return "update";
+    case fge::prof::EventTypes::EVENT_SCENE_DRAW:
+    case fge::prof::EventTypes::EVENT_OBJECT_DRAW:
+        return "draw";
+    case fge::prof::EventTypes::EVENT_OBJECT_CULLED:
+        return "culled";
+    }
+    return "unknown";
+}
+
+}//end
+
+void SetEnabled(bool enabled)
+{
+    _dataEnabled.store(enabled, std::memory_order_relaxed);
+}
+bool IsEnabled()
+{
+    return _dataEnabled.load(std::memory_order_relaxed);
+}
+bool IsCompiledIn()
+{
+#ifdef FGE_DEF_PROFILING
+    return true;
+#else
+    return false;
+#endif //FGE_DEF_PROFILING
+}
+
+void SetBufferCapacity(std::size_t capacity)
+{
+    _dataBufferCapacity.store(std::max<std::size_t>(capacity, 1), std::memory_order_relaxed);
+}
+void SetTraceCapacity(std::size_t capacity)
+{
+    std::scoped_lock<std::mutex> lck(_dataTraceMutex);
+    _dataTraceCapacity = capacity;
+    while (_dataTrace.size() > _dataTraceCapacity)
+    {
+        _dataTrace.pop_front();
+    }
+}
+
+void PushEvent(const fge::prof::Event& event)
+{
+    ThreadBuffer* buffer = GetLocalBuffer();
+
+    std::size_t writeIndex = buffer->_write.load(std::memory_order_relaxed);
+    if (writeIndex - buffer->_read.load(std::memory_order_acquire) > buffer->_mask)
+    {
+        buffer->_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    fge::prof::Event& slot = buffer->_events[writeIndex & buffer->_mask];
+    slot = event;
+    slot._threadIndex = buffer->_index;
+    buffer->_write.store(writeIndex+1, std::memory_order_release);
+}
+void PushEvent(fge::prof::EventTypes type, const char* name)
+{
+    if (fge::prof::IsEnabled())
+    {
+        fge::prof::Event event;
+        event._type = type;
+        event._name = name;
+        event._begin = fge::prof::Clock::now();
+        fge::prof::PushEvent(event);
+    }
+}
+
+fge::prof::Report Collect()
+{
+    fge::prof::Report report;
+    std::unordered_map<std::string_view, fge::prof::ClassReport> classes;
+    std::vector<fge::prof::Event> drained;
+
+    {
+        std::scoped_lock<std::mutex> lck(_dataBuffersMutex);
+        for (auto& buffer : _dataBuffers)
+        {
+            std::size_t readIndex = buffer->_read.load(std::memory_order_relaxed);
+            std::size_t writeIndex = buffer->_write.load(std::memory_order_acquire);
+
+            for (; readIndex != writeIndex; ++readIndex)
+            {
+                drained.push_back(buffer->_events[readIndex & buffer->_mask]);
+            }
+            buffer->_read.store(writeIndex, std::memory_order_release);
+
+            report._droppedEventCount += buffer->_dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    for (const auto& event : drained)
+    {
+        switch (event._type)
+        {
+        case fge::prof::EventTypes::EVENT_SCENE_UPDATE:
+            ++report._updateFrameCount;
+            report._updateTime += event._duration;
+            break;
+        case fge::prof::EventTypes::EVENT_SCENE_DRAW:
+            ++report._drawFrameCount;
+            report._drawTime += event._duration;
+            break;
+        case fge::prof::EventTypes::EVENT_OBJECT_UPDATE:
+        {
+            auto& classReport = classes[event._name];
+            ++classReport._updateCount;
+            classReport._updateTime += event._duration;
+        }
+            break;
+        case fge::prof::EventTypes::EVENT_OBJECT_DRAW:
+        {
+            auto& classReport = classes[event._name];
+            ++classReport._drawCount;
+            classReport._drawTime += event._duration;
+        }
+            break;
+        case fge::prof::EventTypes::EVENT_OBJECT_CULLED:
+            ++classes[event._name]._culledCount;
+            break;
+        }
+    }
+
+    report._classes.reserve(classes.size());
+    for (auto& classReport : classes)
+    {
+        classReport.second._className = classReport.first;
+        report._classes.push_back(std::move(classReport.second));
+    }
+    std::sort(report._classes.begin(), report._classes.end(), [](const fge::prof::ClassReport& a, const fge::prof::ClassReport& b){
+        return (a._updateTime + a._drawTime) > (b._updateTime + b._drawTime);
+    });
+
+    std::scoped_lock<std::mutex> lck(_dataTraceMutex);
+    if (_dataTraceCapacity > 0)
+    {
+        _dataTrace.insert(_dataTrace.end(), drained.begin(), drained.end());
+        while (_dataTrace.size() > _dataTraceCapacity)
+        {
+            _dataTrace.pop_front();
+        }
+    }
+
+    return report;
+}
+
+bool DumpChromeTrace(const std::filesystem::path& path)
+{
+    nlohmann::json events = nlohmann::json::array();
+
+    {
+        std::scoped_lock<std::mutex> lck(_dataTraceMutex);
+        for (const auto& event : _dataTrace)
+        {
+            nlohmann::json& jsonEvent = events.emplace_back(nlohmann::json::object());
+            jsonEvent["name"] = event._name != nullptr ? event._name : "";
+            jsonEvent["cat"] = GetEventCategory(event._type);
+            jsonEvent["ts"] = std::chrono::duration<double, std::micro>(event._begin - _dataEpoch).count();
+            jsonEvent["pid"] = 0;
+            jsonEvent["tid"] = event._threadIndex;
+            if (event._type == fge::prof::EventTypes::EVENT_OBJECT_CULLED)
+            {
+                jsonEvent["ph"] = "i";
+                jsonEvent["s"] = "t";
+            }
+            else
+            {
+                jsonEvent["ph"] = "X";
+                jsonEvent["dur"] = std::chrono::duration<double, std::micro>(event._duration).count();
+            }
+        }
+    }
+
+    nlohmann::json trace = nlohmann::json::object();
+    trace["traceEvents"] = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+    return fge::SaveJsonToFile(path, trace, -1);
+}
+void ClearTrace()
+{
+    std::scoped_lock<std::mutex> lck(_dataTraceMutex);
+    _dataTrace.clear();
+}
+
+}//end fge::prof
@@ -15,45 +15,28 @@
  */
 
 #include "FastEngine/C_property.hpp"
+#include <functional>
+#include <memory>
 
 namespace fge
 {
 
 Property::Property(const fge::Property& val) :
-        g_type(val.g_type),
-        g_isSigned(val.g_isSigned),
         g_isModified(true)
 {
-    switch (val.g_type)
-    {
-    case fge::Property::Types::PTYPE_NULL:
-        break;
-    case fge::Property::Types::PTYPE_STRING:
-        this->g_data._ptr = new std::string{ *reinterpret_cast<std::string*>(val.g_data._ptr) };
-        break;
-    case fge::Property::Types::PTYPE_CLASS:
-        this->g_data._ptr = reinterpret_cast<fge::PropertyClassWrapper*>(val.g_data._ptr)->copy();
-        break;
-
-    default:
-        this->g_data = val.g_data;
-        break;
-    }
+    this->copyFrom(val);
 }
 Property::Property(fge::Property&& val) noexcept :
-        g_type(val.g_type),
-        g_data(val.g_data),
-        g_isSigned(val.g_isSigned),
         g_isModified(true)
 {
-    val.g_type = fge::Property::Types::PTYPE_NULL;
+    this->moveFrom(std::move(val));
 }
 
 Property::Property(const char* val) :
         g_type{fge::Property::Types::PTYPE_STRING},
         g_isModified(true)
 {
-    this->g_data._ptr = new std::string{val};
+    this->g_data._ptr = new (this->g_buffer) std::string{val};
 }
 
 Property::~Property()
@@ -65,11 +48,18 @@ void Property::clear()
 {
     if (this->g_type == fge::Property::Types::PTYPE_STRING)
     {
-        delete reinterpret_cast<std::string*>(this->g_data._ptr);
+        std::destroy_at(reinterpret_cast<std::string*>(this->g_data._ptr));
     }
     else if (this->g_type == fge::Property::Types::PTYPE_CLASS)
     {
-        delete reinterpret_cast<fge::PropertyClassWrapper*>(this->g_data._ptr);
+        if ( this->isInline() )
+        {
+            std::destroy_at(reinterpret_cast<fge::PropertyClassWrapper*>(this->g_data._ptr));
+        }
+        else
+        {
+            delete reinterpret_cast<fge::PropertyClassWrapper*>(this->g_data._ptr);
+        }
     }
 
     this->g_type = fge::Property::Types::PTYPE_NULL;
@@ -157,7 +147,7 @@ void Property::setType(fge::Property::Types type)
         this->clear();
         if (type == fge::Property::Types::PTYPE_STRING)
         {
-            this->g_data._ptr = new std::string();
+            this->g_data._ptr = new (this->g_buffer) std::string();
         }
         this->g_type = type;
     }
@@ -253,24 +243,7 @@ bool Property::set(const fge::Property& val)
     else if (this->g_type == fge::Property::Types::PTYPE_NULL)
     {
         this->g_isModified = true;
-        this->g_type = val.g_type;
-        switch (val.g_type)
-        {
-        case fge::Property::Types::PTYPE_NULL:
-            break;
-        case fge::Property::Types::PTYPE_STRING:
-            this->g_data._ptr = new std::string(*reinterpret_cast<std::string*>(val.g_data._ptr));
-            break;
-        case fge::Property::Types::PTYPE_CLASS:
-            this->g_data._ptr = reinterpret_cast<fge::PropertyClassWrapper*>(val.g_data._ptr)->copy();
-            break;
-
-        default:
-            this->g_isSigned = val.g_isSigned;
-            this->g_data = val.g_data;
-            break;
-        }
-
+        this->copyFrom(val);
         return true;
     }
 
@@ -278,6 +251,11 @@ bool Property::set(const fge::Property& val)
 }
 bool Property::set(fge::Property&& val)
 {
+    if (this == &val)
+    {
+        return true;
+    }
+
     if (this->g_type == val.g_type)
     {
         switch (val.g_type)
@@ -285,10 +263,14 @@ bool Property::set(fge::Property&& val)
         case fge::Property::Types::PTYPE_NULL:
             break;
         case fge::Property::Types::PTYPE_STRING:
-        case fge::Property::Types::PTYPE_CLASS:
-            this->g_data._ptr = val.g_data._ptr;
+            *reinterpret_cast<std::string*>(this->g_data._ptr) = std::move(*reinterpret_cast<std::string*>(val.g_data._ptr));
             this->g_isModified = true;
             break;
+        case fge::Property::Types::PTYPE_CLASS:
+            this->clear();
+            this->moveFrom(std::move(val));
+            this->g_isModified = true;
+            return true;
 
         default:
             this->g_isSigned = val.g_isSigned;
@@ -297,29 +279,13 @@ bool Property::set(fge::Property&& val)
             break;
         }
 
-        val.g_type = fge::Property::Types::PTYPE_NULL;
+        val.clear();
         return true;
     }
     else if (this->g_type == fge::Property::Types::PTYPE_NULL)
     {
         this->g_isModified = true;
-        this->g_type = val.g_type;
-        switch (val.g_type)
-        {
-        case fge::Property::Types::PTYPE_NULL:
-            break;
-        case fge::Property::Types::PTYPE_STRING:
-        case fge::Property::Types::PTYPE_CLASS:
-            this->g_data._ptr = val.g_data._ptr;
-            break;
-
-        default:
-            this->g_isSigned = val.g_isSigned;
-            this->g_data = val.g_data;
-            break;
-        }
-
-        val.g_type = fge::Property::Types::PTYPE_NULL;
+        this->moveFrom(std::move(val));
         return true;
     }
 
@@ -333,7 +299,7 @@ bool Property::set(const char* val)
         if (this->g_type == fge::Property::Types::PTYPE_NULL)
         {
             this->g_type = fge::Property::Types::PTYPE_STRING;
-            this->g_data._ptr = new std::string(val);
+            this->g_data._ptr = new (this->g_buffer) std::string(val);
             return true;
         }
         else
@@ -354,7 +320,7 @@ fge::ParrayType& Property::setArrayType()
     {
         this->clear();
         this->g_type = fge::Property::Types::PTYPE_CLASS;
-        this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<fge::ParrayType>());
+        this->g_data._ptr = this->createClass<fge::ParrayType>();
     }
     else
     {
@@ -362,7 +328,7 @@ fge::ParrayType& Property::setArrayType()
         {
             this->clear();
             this->g_type = fge::Property::Types::PTYPE_CLASS;
-            this->g_data._ptr = static_cast<fge::PropertyClassWrapper*>(new fge::PropertyClassWrapperType<fge::ParrayType>());
+            this->g_data._ptr = this->createClass<fge::ParrayType>();
         }
     }
 
@@ -503,4 +469,69 @@ void Property::setModifiedFlag(bool flag)
     this->g_isModified = flag;
 }
 
+bool Property::isInline() const
+{
+    //Relational operators on unrelated pointers are unspecified, std::less give a total order
+    const std::less<const void*> less;
+    const void* ptr = this->g_data._ptr;
+    return !less(ptr, this->g_buffer) && less(ptr, this->g_buffer + FGE_PROPERTY_BUFFER_SIZE);
+}
+void Property::copyFrom(const fge::Property& val)
+{
+    this->g_type = val.g_type;
+    this->g_isSigned = val.g_isSigned;
+    switch (val.g_type)
+    {
+    case fge::Property::Types::PTYPE_NULL:
+        break;
+    case fge::Property::Types::PTYPE_STRING:
+        this->g_data._ptr = new (this->g_buffer) std::string{ *reinterpret_cast<const std::string*>(val.g_data._ptr) };
+        break;
+    case fge::Property::Types::PTYPE_CLASS:
+        if ( val.isInline() )
+        {
+            this->g_data._ptr = reinterpret_cast<const fge::PropertyClassWrapper*>(val.g_data._ptr)->copyTo(this->g_buffer);
+        }
+        else
+        {
+            this->g_data._ptr = reinterpret_cast<const fge::PropertyClassWrapper*>(val.g_data._ptr)->copy();
+        }
+        break;
+
+    default:
+        this->g_data = val.g_data;
+        break;
+    }
+}
+void Property::moveFrom(fge::Property&& val) noexcept
+{
+    this->g_type = val.g_type;
+    this->g_isSigned = val.g_isSigned;
+    switch (val.g_type)
+    {
+    case fge::Property::Types::PTYPE_NULL:
+        break;
+    case fge::Property::Types::PTYPE_STRING:
+        this->g_data._ptr = new (this->g_buffer) std::string{ std::move(*reinterpret_cast<std::string*>(val.g_data._ptr)) };
+        break;
+    case fge::Property::Types::PTYPE_CLASS:
+        if ( val.isInline() )
+        {//Only trivially copyable classes are inline, so the copy can't throw
+            this->g_data._ptr = reinterpret_cast<const fge::PropertyClassWrapper*>(val.g_data._ptr)->copyTo(this->g_buffer);
+        }
+        else
+        {//The allocated class is stolen
+            this->g_data._ptr = val.g_data._ptr;
+            val.g_type = fge::Property::Types::PTYPE_NULL;
+            return;
+        }
+        break;
+
+    default:
+        this->g_data = val.g_data;
+        break;
+    }
+    val.clear();
+}
+
 }//end fge
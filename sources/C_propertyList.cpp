@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_propertyList.hpp"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace fge
+{
+
+namespace
+{
+
+struct KeyRegistry
+{
+    //A deque never move its elements, names can be referenced by the map and getName()
+    std::deque<std::string> _names;
+    std::unordered_map<std::string_view, fge::PropertyKey::Id> _ids;
+    std::shared_mutex _mutex;
+    const std::string _emptyName;
+};
+
+KeyRegistry& GetKeyRegistry()
+{
+    static KeyRegistry registry;
+    return registry;
+}
+
+}//end
+
+PropertyKey::PropertyKey(const std::string& name)
+{
+    auto& registry = GetKeyRegistry();
+
+    {
+        std::shared_lock<std::shared_mutex> lck(registry._mutex);
+        auto it = registry._ids.find(name);
+        if (it != registry._ids.end())
+        {
+            this->g_id = it->second;
+            return;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lck(registry._mutex);
+    auto it = registry._ids.find(name);
+    if (it != registry._ids.end())
+    {
+        this->g_id = it->second;
+        return;
+    }
+
+    if (registry._names.size() >= FGE_PROPERTY_KEY_BAD_ID)
+    {
+        throw std::length_error("too many property keys !");
+    }
+
+    this->g_id = static_cast<fge::PropertyKey::Id>(registry._names.size());
+    const std::string& storedName = registry._names.emplace_back(name);
+    registry._ids.emplace(storedName, this->g_id);
+}
+PropertyKey::PropertyKey(const char* name) :
+        PropertyKey(std::string{name})
+{}
+
+fge::PropertyKey PropertyKey::find(const std::string& name)
+{
+    auto& registry = GetKeyRegistry();
+
+    fge::PropertyKey key;
+    std::shared_lock<std::shared_mutex> lck(registry._mutex);
+    auto it = registry._ids.find(name);
+    if (it != registry._ids.end())
+    {
+        key.g_id = it->second;
+    }
+    return key;
+}
+
+const std::string& PropertyKey::getName() const
+{
+    auto& registry = GetKeyRegistry();
+    if ( !this->isValid() )
+    {
+        return registry._emptyName;
+    }
+
+    std::shared_lock<std::shared_mutex> lck(registry._mutex);
+    return registry._names[this->g_id];
+}
+
+}//end fge
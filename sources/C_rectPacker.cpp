@@ -0,0 +1,161 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_rectPacker.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace fge
+{
+
+RectPacker::RectPacker(const sf::Vector2u& size, unsigned int padding)
+{
+    this->reset(size, padding);
+}
+
+void RectPacker::reset(const sf::Vector2u& size, unsigned int padding)
+{
+    this->g_size = size;
+    this->g_padding = padding;
+    this->clear();
+}
+void RectPacker::clear()
+{
+    this->g_skyline.clear();
+    this->g_skyline.push_back({0, 0, this->g_size.x});
+    this->g_usedArea = 0;
+}
+
+std::optional<sf::IntRect> RectPacker::insert(const sf::Vector2u& size)
+{
+    if (size.x == 0 || size.y == 0)
+    {
+        return std::nullopt;
+    }
+
+    const unsigned int width = size.x + this->g_padding;
+    const unsigned int height = size.y + this->g_padding;
+
+    std::size_t bestIndex = this->g_skyline.size();
+    unsigned int bestTop = std::numeric_limits<unsigned int>::max();
+    unsigned int bestWidth = std::numeric_limits<unsigned int>::max();
+    unsigned int bestY = 0;
+
+    for (std::size_t i=0; i<this->g_skyline.size(); ++i)
+    {
+        auto y = this->fit(i, width, height);
+        if (y)
+        {
+            const unsigned int top = *y + height;
+            if (top < bestTop || (top == bestTop && this->g_skyline[i]._width < bestWidth))
+            {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = this->g_skyline[i]._width;
+                bestY = *y;
+            }
+        }
+    }
+
+    if (bestIndex == this->g_skyline.size())
+    {
+        return std::nullopt;
+    }
+
+    const unsigned int x = this->g_skyline[bestIndex]._x;
+    this->g_skyline.insert(this->g_skyline.begin()+static_cast<std::ptrdiff_t>(bestIndex), {x, bestY+height, width});
+
+    //Shrink or remove the nodes that are now under the new one
+    for (std::size_t i=bestIndex+1; i<this->g_skyline.size(); )
+    {
+        const auto& previous = this->g_skyline[i-1];
+        auto& node = this->g_skyline[i];
+
+        const unsigned int previousRight = previous._x + previous._width;
+        if (node._x >= previousRight)
+        {
+            break;
+        }
+
+        const unsigned int shrink = previousRight - node._x;
+        if (node._width <= shrink)
+        {
+            this->g_skyline.erase(this->g_skyline.begin()+static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        node._x += shrink;
+        node._width -= shrink;
+        break;
+    }
+
+    //Merge neighbours at the same height
+    for (std::size_t i=0; i+1<this->g_skyline.size(); )
+    {
+        if (this->g_skyline[i]._y == this->g_skyline[i+1]._y)
+        {
+            this->g_skyline[i]._width += this->g_skyline[i+1]._width;
+            this->g_skyline.erase(this->g_skyline.begin()+static_cast<std::ptrdiff_t>(i+1));
+            continue;
+        }
+        ++i;
+    }
+
+    this->g_usedArea += static_cast<std::size_t>(size.x) * size.y;
+    return sf::IntRect{static_cast<int>(x), static_cast<int>(bestY), static_cast<int>(size.x), static_cast<int>(size.y)};
+}
+
+const sf::Vector2u& RectPacker::getSize() const
+{
+    return this->g_size;
+}
+unsigned int RectPacker::getPadding() const
+{
+    return this->g_padding;
+}
+float RectPacker::getOccupancy() const
+{
+    const std::size_t totalArea = static_cast<std::size_t>(this->g_size.x) * this->g_size.y;
+    if (totalArea == 0)
+    {
+        return 0.0f;
+    }
+    return static_cast<float>(this->g_usedArea) / static_cast<float>(totalArea);
+}
+
+std::optional<unsigned int> RectPacker::fit(std::size_t index, unsigned int width, unsigned int height) const
+{
+    const unsigned int x = this->g_skyline[index]._x;
+    if (x + width > this->g_size.x)
+    {
+        return std::nullopt;
+    }
+
+    unsigned int y = this->g_skyline[index]._y;
+    unsigned int widthLeft = width;
+
+    for (std::size_t i=index; widthLeft > 0; ++i)
+    {
+        y = std::max(y, this->g_skyline[i]._y);
+        if (y + height > this->g_size.y)
+        {
+            return std::nullopt;
+        }
+        widthLeft -= std::min(widthLeft, this->g_skyline[i]._width);
+    }
+    return y;
+}
+
+}//end fge
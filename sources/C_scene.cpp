@@ -15,12 +15,12 @@
  */
 
 #include "FastEngine/C_scene.hpp"
-#include "FastEngine/C_random.hpp"
 #include "FastEngine/manager/reg_manager.hpp"
 #include "FastEngine/manager/network_manager.hpp"
 #include "FastEngine/extra/extra_function.hpp"
 #include "FastEngine/C_clientList.hpp"
 #include "FastEngine/C_guiElement.hpp"
+#include "FastEngine/C_profiler.hpp"
 
 #include <fstream>
 #include <iomanip>
@@ -29,6 +29,77 @@
 namespace fge
 {
 
+///Class ObjectData
+void ObjectData::onTagAdded([[maybe_unused]] const fge::TagList& tagList, fge::tag::TagId tagId)
+{
+    if (this->g_linkedScene != nullptr)
+    {
+        auto objectData = this->g_object->_myObjectData.lock();
+        if (objectData)
+        {
+            this->g_linkedScene->g_tagIndex[tagId].insert(std::move(objectData));
+        }
+    }
+}
+void ObjectData::onTagRemoved([[maybe_unused]] const fge::TagList& tagList, fge::tag::TagId tagId)
+{
+    if (this->g_linkedScene != nullptr)
+    {
+        auto it = this->g_linkedScene->g_tagIndex.find(tagId);
+        if (it != this->g_linkedScene->g_tagIndex.end())
+        {
+            it->second.erase(this->g_object->_myObjectData.lock());
+            if (it->second.empty())
+            {
+                this->g_linkedScene->g_tagIndex.erase(it);
+            }
+        }
+    }
+}
+
+///Class SidAllocator
+SidAllocator::SidAllocator(fge::ObjectSid rangeBegin, fge::ObjectSid rangeEnd) :
+    g_rangeBegin(rangeBegin),
+    g_rangeEnd(rangeEnd),
+    g_counter(rangeBegin),
+    g_recycled()
+{}
+
+fge::ObjectSid SidAllocator::get()
+{
+    if ( !this->g_recycled.empty() )
+    {
+        fge::ObjectSid sid = this->g_recycled.back();
+        this->g_recycled.pop_back();
+        return sid;
+    }
+
+    if (this->g_counter >= this->g_rangeEnd)
+    {
+        return FGE_SCENE_BAD_SID;
+    }
+    return this->g_counter++;
+}
+void SidAllocator::release(fge::ObjectSid sid)
+{
+    if (sid >= this->g_rangeBegin && sid < this->g_counter)
+    {
+        this->g_recycled.push_back(sid);
+    }
+}
+void SidAllocator::reset()
+{
+    this->g_counter = this->g_rangeBegin;
+    this->g_recycled.clear();
+}
+
+void SidAllocator::setRange(fge::ObjectSid rangeBegin, fge::ObjectSid rangeEnd)
+{
+    this->g_rangeBegin = rangeBegin;
+    this->g_rangeEnd = rangeEnd;
+    this->reset();
+}
+
 ///Class Scene
 Scene::Scene() :
     g_name(),
@@ -42,6 +113,9 @@ Scene::Scene() :
     g_deleteMe(false),
     g_updatedObjectIterator(),
 
+    g_deferChanges(false),
+    g_deferredChanges(),
+
     g_data(),
     g_dataMap()
 {
@@ -59,11 +133,23 @@ Scene::Scene(std::string sceneName) :
     g_deleteMe(false),
     g_updatedObjectIterator(),
 
+    g_deferChanges(false),
+    g_deferredChanges(),
+
     g_data(),
     g_dataMap()
 {
     this->g_updatedObjectIterator = this->g_data.end();
 }
+Scene::~Scene()
+{
+    //Objects can still be shared outside of the Scene, they must not reference it anymore
+    for (auto& data : this->g_data)
+    {
+        data->g_object->_tags.setListener(nullptr);
+        data->g_linkedScene = nullptr;
+    }
+}
 
 /** Scene **/
 #ifdef FGE_DEF_SERVER
@@ -72,18 +158,25 @@ void Scene::update(fge::Event& event, const std::chrono::milliseconds& deltaTime
 void Scene::update(sf::RenderWindow& screen, fge::Event& event, const std::chrono::milliseconds& deltaTime)
 #endif //FGE_DEF_SERVER
 {
+    FGE_PROF_SCOPE(fge::prof::EventTypes::EVENT_SCENE_UPDATE, "Scene::update");
+
     for ( this->g_updatedObjectIterator=this->g_data.begin(); this->g_updatedObjectIterator!=this->g_data.end(); ++this->g_updatedObjectIterator )
     {
-        if ((*this->g_updatedObjectIterator)->g_object->isNeedingAnchorUpdate())
         {
-            (*this->g_updatedObjectIterator)->g_object->updateAnchor();
-        }
+            FGE_PROF_SCOPE(fge::prof::EventTypes::EVENT_OBJECT_UPDATE, (*this->g_updatedObjectIterator)->g_object->getClassName());
+
+            if ((*this->g_updatedObjectIterator)->g_object->isNeedingAnchorUpdate())
+            {
+                (*this->g_updatedObjectIterator)->g_object->updateAnchor();
+            }
 
 #ifdef FGE_DEF_SERVER
-        (*this->g_updatedObjectIterator)->g_object->update(event, deltaTime, this);
+            (*this->g_updatedObjectIterator)->g_object->update(event, deltaTime, this);
 #else
-        (*this->g_updatedObjectIterator)->g_object->update(screen, event, deltaTime, this);
+            (*this->g_updatedObjectIterator)->g_object->update(screen, event, deltaTime, this);
 #endif //FGE_DEF_SERVER
+        }
+
         if ( this->g_deleteMe )
         {
             this->g_deleteMe = false;
@@ -94,19 +187,29 @@ void Scene::update(sf::RenderWindow& screen, fge::Event& event, const std::chron
 
             (*this->g_updatedObjectIterator)->g_object->removed(this);
             this->_onRemoveObject.call(this, *this->g_updatedObjectIterator);
+            this->unindexObject(*this->g_updatedObjectIterator);
             (*this->g_updatedObjectIterator)->g_linkedScene = nullptr;
             (*this->g_updatedObjectIterator)->g_object->_myObjectData.reset();
             auto objectPlan = (*this->g_updatedObjectIterator)->g_plan;
             this->refreshPlanDataMap(objectPlan, this->g_updatedObjectIterator, true);
+            this->g_dataMap.erase((*this->g_updatedObjectIterator)->g_sid);
+            this->g_sidAllocator.release((*this->g_updatedObjectIterator)->g_sid);
             this->g_updatedObjectIterator = --this->g_data.erase(this->g_updatedObjectIterator);
 
             this->_onPlanUpdate.call(this, objectPlan);
         }
     }
+
+    if (this->g_deferChanges)
+    {
+        this->applyDeferredChanges();
+    }
 }
 #ifndef FGE_DEF_SERVER
 void Scene::draw(sf::RenderTarget& target, bool clear_target, const sf::Color& clear_color, sf::RenderStates states) const
 {
+    FGE_PROF_SCOPE(fge::prof::EventTypes::EVENT_SCENE_DRAW, "Scene::draw");
+
     if ( clear_target )
     {
         target.clear( clear_color );
@@ -124,6 +227,11 @@ void Scene::draw(sf::RenderTarget& target, bool clear_target, const sf::Color& c
     fge::ObjectPlanDepth depthCount = 0;
     auto planDataMapIt = this->g_planDataMap.begin();
 
+    if (this->g_batching)
+    {
+        this->g_spriteBatch.begin(&target);
+    }
+
     for (auto objectIt = this->g_data.begin(); objectIt != this->g_data.end(); ++objectIt)
     {
         //Check plan depth
@@ -159,12 +267,29 @@ void Scene::draw(sf::RenderTarget& target, bool clear_target, const sf::Color& c
 
             if ( !objectBounds.intersects(screenBounds) )
             {
+                FGE_PROF_MARK(fge::prof::EventTypes::EVENT_OBJECT_CULLED, object->getClassName());
                 continue;
             }
         }
 
+        FGE_PROF_SCOPE(fge::prof::EventTypes::EVENT_OBJECT_DRAW, object->getClassName());
         sf::RenderStates statesCopy = states;
-        target.draw(*object, statesCopy);
+        if (this->g_batching)
+        {
+            if ( !object->drawBatched(this->g_spriteBatch, statesCopy) )
+            {
+                this->g_spriteBatch.draw(*object, statesCopy);
+            }
+        }
+        else
+        {
+            target.draw(*object, statesCopy);
+        }
+    }
+
+    if (this->g_batching)
+    {
+        this->g_spriteBatch.end();
     }
 
     target.setView( backupView );
@@ -173,7 +298,10 @@ void Scene::draw(sf::RenderTarget& target, bool clear_target, const sf::Color& c
 
 void Scene::clear()
 {
+    this->g_deferredChanges.clear();
+    this->g_deferredSids.clear();
     this->delAllObject(false);
+    this->g_sidAllocator.reset();
     this->_properties.delAllProperties();
 }
 
@@ -184,76 +312,36 @@ fge::ObjectDataShared Scene::newObject(fge::ObjectPtr&& newObject, fge::ObjectPl
     {
         return nullptr;
     }
-    fge::ObjectSid generatedSid = this->generateSid(sid);
-    if (generatedSid == FGE_SCENE_BAD_SID)
-    {
-        return nullptr;
-    }
-    if (this->g_enableNetworkEventsFlag)
-    {
-        this->pushEvent({fge::SceneNetEvent::SEVT_NEWOBJECT, generatedSid});
-    }
-
-    auto it = this->getInsertBeginPositionWithPlan(plan);
-
-    it = this->g_data.insert( it, std::make_shared<fge::ObjectData>(this, std::move(newObject), generatedSid, plan, type) );
-    this->g_dataMap[generatedSid] = it;
-    (*it)->g_object->_myObjectData = *it;
-    this->refreshPlanDataMap(plan, it, false);
-    if ((this->g_updatedObjectIterator != this->g_data.end()) && (*it)->g_parent.expired())
-    {//An object is created inside another object and orphan, make it parent
-        (*it)->g_parent = *this->g_updatedObjectIterator;
-    }
-    (*it)->g_object->first(this);
-
-    if ((*it)->g_object->_callbackContextMode == fge::Object::CallbackContextModes::CONTEXT_AUTO &&
-        this->g_callbackContext._event != nullptr)
-    {
-        (*it)->g_object->callbackRegister(*this->g_callbackContext._event, this->g_callbackContext._guiElementHandler);
-    }
-
-    this->_onNewObject.call(this, *it);
-    this->_onPlanUpdate.call(this, plan);
-
-    return *it;
+    return this->newObject( std::make_shared<fge::ObjectData>(nullptr, std::move(newObject), sid, plan, type) );
 }
 fge::ObjectDataShared Scene::newObject(const fge::ObjectDataShared& objectData)
 {
-    fge::ObjectSid generatedSid = this->generateSid( objectData->g_sid );
-    if (generatedSid == FGE_SCENE_BAD_SID)
+    if ( this->isDeferringNow() )
     {
-        return nullptr;
-    }
-    if (this->g_enableNetworkEventsFlag)
-    {
-        this->pushEvent({fge::SceneNetEvent::SEVT_NEWOBJECT, generatedSid});
-    }
-
-    objectData->g_sid = generatedSid;
+        if (objectData->g_parent.expired())
+        {//An object is created inside another object and orphan, make it parent
+            objectData->g_parent = *this->g_updatedObjectIterator;
+        }
 
-    auto it = this->getInsertBeginPositionWithPlan(objectData->g_plan);
+        //The SID is attributed now, so the returned handle can be used before the changes are applied
+        fge::ObjectSid generatedSid = this->generateSid(objectData->g_sid);
+        if (generatedSid == FGE_SCENE_BAD_SID)
+        {
+            return nullptr;
+        }
+        objectData->g_sid = generatedSid;
 
-    it = this->g_data.insert( it, objectData );
-    this->g_dataMap[generatedSid] = it;
-    objectData->g_linkedScene = this;
-    objectData->g_object->_myObjectData = objectData;
-    this->refreshPlanDataMap(objectData->g_plan, it, false);
-    if ((this->g_updatedObjectIterator != this->g_data.end()) && objectData->g_parent.expired())
-    {//An object is created inside another object and orphan, make it parent
-        objectData->g_parent = *this->g_updatedObjectIterator;
+        this->g_deferredChanges.push_back({fge::Scene::DeferredChange::Types::CHANGE_NEWOBJECT, objectData->g_sid, objectData->g_plan, objectData});
+        this->g_deferredSids.insert(objectData->g_sid);
+        return objectData;
     }
-    objectData->g_object->first(this);
 
-    if (objectData->g_object->_callbackContextMode == fge::Object::CallbackContextModes::CONTEXT_AUTO &&
-        this->g_callbackContext._event != nullptr)
+    auto newObjectData = this->insertObject(objectData);
+    if (newObjectData)
     {
-        objectData->g_object->callbackRegister(*this->g_callbackContext._event, this->g_callbackContext._guiElementHandler);
+        this->_onPlanUpdate.call(this, newObjectData->g_plan);
     }
-
-    this->_onNewObject.call(this, objectData);
-    this->_onPlanUpdate.call(this, objectData->g_plan);
-
-    return objectData;
+    return newObjectData;
 }
 
 fge::ObjectDataShared Scene::duplicateObject(fge::ObjectSid sid, fge::ObjectSid newSid)
@@ -286,9 +374,11 @@ fge::ObjectDataShared Scene::transferObject(fge::ObjectSid sid, fge::Scene& newS
             fge::ObjectDataShared buff = std::move(*it->second);
             buff->g_object->removed(this);
             this->_onRemoveObject.call(this, buff);
+            this->unindexObject(buff);
             this->refreshPlanDataMap(buff->g_plan, it->second, true);
             this->g_data.erase(it->second);
             this->g_dataMap.erase(it);
+            this->g_sidAllocator.release(sid);
 
             this->_onPlanUpdate.call(this, buff->g_plan);
 
@@ -305,27 +395,31 @@ fge::ObjectDataShared Scene::transferObject(fge::ObjectSid sid, fge::Scene& newS
 
 void Scene::delUpdatedObject()
 {
+    if ( this->isDeferringNow() )
+    {
+        this->g_deferredChanges.push_back({fge::Scene::DeferredChange::Types::CHANGE_DELOBJECT, (*this->g_updatedObjectIterator)->g_sid, FGE_SCENE_BAD_PLAN, nullptr});
+        return;
+    }
     this->g_deleteMe=true;
 }
 bool Scene::delObject(fge::ObjectSid sid)
 {
-    auto it = this->g_dataMap.find(sid);
-
-    if ( it != this->g_dataMap.end() )
+    if ( this->isDeferringNow() )
     {
-        if (this->g_enableNetworkEventsFlag)
+        if ( !this->isDeferredValid(sid) )
         {
-            this->pushEvent({fge::SceneNetEvent::SEVT_DELOBJECT, (*it->second)->g_sid});
+            return false;
         }
+        this->g_deferredChanges.push_back({fge::Scene::DeferredChange::Types::CHANGE_DELOBJECT, sid, FGE_SCENE_BAD_PLAN, nullptr});
+        return true;
+    }
 
-        (*it->second)->g_object->removed(this);
-        this->_onRemoveObject.call(this, *it->second);
-        (*it->second)->g_linkedScene = nullptr;
-        (*it->second)->g_object->_myObjectData.reset();
+    auto it = this->g_dataMap.find(sid);
+
+    if ( it != this->g_dataMap.end() )
+    {
         auto objectPlan = (*it->second)->g_plan;
-        this->refreshPlanDataMap(objectPlan, it->second, true);
-        this->g_data.erase(it->second);
-        this->g_dataMap.erase(it);
+        this->removeObject(it);
 
         this->_onPlanUpdate.call(this, objectPlan);
 
@@ -355,11 +449,13 @@ std::size_t Scene::delAllObject(bool ignoreGuiObject)
 
         (*it)->g_object->removed(this);
         this->_onRemoveObject.call(this, *it);
+        this->unindexObject(*it);
         (*it)->g_linkedScene = nullptr;
         (*it)->g_object->_myObjectData.reset();
         this->refreshPlanDataMap((*it)->g_plan, it, true);
 
         this->g_dataMap.erase((*it)->g_sid);
+        this->g_sidAllocator.release((*it)->g_sid);
         it = --this->g_data.erase(it);
     }
 
@@ -395,6 +491,7 @@ bool Scene::setObjectSid(fge::ObjectSid sid, fge::ObjectSid newSid)
             (*it->second)->g_sid = newSid;
             this->g_dataMap[newSid] = std::move(it->second);
             this->g_dataMap.erase(it);
+            this->g_sidAllocator.release(sid);
             return true;
         }
     }
@@ -417,11 +514,13 @@ bool Scene::setObject(fge::ObjectSid sid, fge::ObjectPtr&& newObject)
         }
 
         (*it->second)->g_object->removed(this);
+        this->unindexObject(*it->second);
         (*it->second)->g_linkedScene = nullptr;
         (*it->second)->g_object->_myObjectData.reset();
 
         (*it->second) = std::make_shared<fge::ObjectData>( this, std::move(newObject), (*it->second)->g_sid, (*it->second)->g_plan, (*it->second)->g_type );
         (*it->second)->g_object->_myObjectData = *it->second;
+        this->indexObject(*it->second);
         (*it->second)->g_object->first(this);
 
         if ((*it->second)->g_object->_callbackContextMode == fge::Object::CallbackContextModes::CONTEXT_AUTO &&
@@ -435,90 +534,141 @@ bool Scene::setObject(fge::ObjectSid sid, fge::ObjectPtr&& newObject)
 }
 bool Scene::setObjectPlan(fge::ObjectSid sid, fge::ObjectPlan newPlan)
 {
-    auto it = this->g_dataMap.find(sid);
-
-    if ( it != this->g_dataMap.end() )
+    if ( this->isDeferringNow() )
     {
-        this->refreshPlanDataMap((*it->second)->g_plan, it->second, true);
-
-        auto newPosIt = this->getInsertBeginPositionWithPlan(newPlan);
+        if ( !this->isDeferredValid(sid) )
+        {
+            return false;
+        }
+        this->g_deferredChanges.push_back({fge::Scene::DeferredChange::Types::CHANGE_PLAN, sid, newPlan, nullptr});
+        return true;
+    }
 
-        auto oldPlan = (*it->second)->g_plan;
-        (*it->second)->g_plan = newPlan;
+    auto it = this->g_dataMap.find(sid);
+    if ( it == this->g_dataMap.end() )
+    {
+        return false;
+    }
 
-        this->g_data.splice(newPosIt, this->g_data, it->second);
-        this->refreshPlanDataMap(newPlan, it->second, false);
+    auto oldPlan = (*it->second)->g_plan;
+    this->moveObjectPlan(sid, newPlan);
 
-        if (oldPlan != newPlan)
+    if (oldPlan != newPlan)
+    {
+        this->_onPlanUpdate.call(this, oldPlan);
+    }
+    this->_onPlanUpdate.call(this, newPlan);
+    return true;
+}
+bool Scene::setObjectPlanTop(fge::ObjectSid sid)
+{
+    if ( this->isDeferringNow() )
+    {
+        if ( !this->isDeferredValid(sid) )
         {
-            this->_onPlanUpdate.call(this, oldPlan);
+            return false;
         }
-        this->_onPlanUpdate.call(this, newPlan);
+        this->g_deferredChanges.push_back({fge::Scene::DeferredChange::Types::CHANGE_PLAN_TOP, sid, FGE_SCENE_BAD_PLAN, nullptr});
+        return true;
+    }
+
+    if ( this->moveObjectPlanTop(sid) )
+    {
+        this->_onPlanUpdate.call(this, (*this->g_dataMap[sid])->g_plan);
         return true;
     }
     return false;
 }
-bool Scene::setObjectPlanTop(fge::ObjectSid sid)
+bool Scene::setObjectPlanBot(fge::ObjectSid sid)
 {
-    auto it = this->g_dataMap.find(sid);
-
-    if ( it != this->g_dataMap.end() )
+    if ( this->isDeferringNow() )
     {
-        auto newPosIt = this->g_planDataMap.find( (*it->second)->g_plan );
-
-        if (it->second == newPosIt->second)
-        {//already on top
-            return true;
+        if ( !this->isDeferredValid(sid) )
+        {
+            return false;
         }
+        this->g_deferredChanges.push_back({fge::Scene::DeferredChange::Types::CHANGE_PLAN_BOT, sid, FGE_SCENE_BAD_PLAN, nullptr});
+        return true;
+    }
 
-        this->g_data.splice(newPosIt->second, this->g_data, it->second);
-        this->refreshPlanDataMap((*it->second)->g_plan, it->second, false);
-
-        this->_onPlanUpdate.call(this, (*it->second)->g_plan);
+    if ( this->moveObjectPlanBot(sid) )
+    {
+        this->_onPlanUpdate.call(this, (*this->g_dataMap[sid])->g_plan);
         return true;
     }
     return false;
 }
-bool Scene::setObjectPlanBot(fge::ObjectSid sid)
-{
-    auto it = this->g_dataMap.find(sid);
 
-    if ( it != this->g_dataMap.end() )
+/** Deferred changes **/
+void Scene::deferChanges(bool on)
+{
+    if (!on)
     {
-        auto plan = (*it->second)->g_plan;
-        auto planIt = this->g_planDataMap.find(plan);
-        auto planItAfter = planIt;
-        ++planItAfter; //Next plan
+        this->applyDeferredChanges();
+    }
+    this->g_deferChanges = on;
+}
+bool Scene::isDeferringChanges() const
+{
+    return this->g_deferChanges;
+}
+std::size_t Scene::applyDeferredChanges()
+{
+    if (this->g_deferredChanges.empty())
+    {
+        return 0;
+    }
 
-        bool wasOnTop = false;
-        if (it->second == planIt->second)
-        {//is on top
-            wasOnTop = true;
-            this->refreshPlanDataMap(plan, it->second, true);
-        }
+    //Changes queued by a callback during this pass are applied directly
+    std::vector<fge::Scene::DeferredChange> changes;
+    changes.swap(this->g_deferredChanges);
 
-        if (planItAfter == this->g_planDataMap.end())
-        {//object can be pushed at the end
-            this->g_data.splice(this->g_data.end(), this->g_data, it->second);
-            if (wasOnTop)
+    fge::ObjectContainer newObjects;
+    std::size_t appliedCount = 0;
+
+    for (auto& change : changes)
+    {
+        switch (change._type)
+        {
+        case fge::Scene::DeferredChange::Types::CHANGE_NEWOBJECT:
+            this->g_deferredSids.erase(change._sid);
+            if ( this->insertObject(change._data) )
             {
-                this->refreshPlanDataMap(plan, it->second, false);
+                newObjects.push_back(std::move(change._data));
+                ++appliedCount;
             }
-        }
-        else
+            break;
+        case fge::Scene::DeferredChange::Types::CHANGE_DELOBJECT:
         {
-            this->g_data.splice(planItAfter->second, this->g_data, it->second);
-            if (wasOnTop)
+            auto it = this->g_dataMap.find(change._sid);
+            if (it != this->g_dataMap.end())
             {
-                this->refreshPlanDataMap(plan, it->second, false);
+                this->removeObject(it);
+                ++appliedCount;
             }
         }
+            break;
+        case fge::Scene::DeferredChange::Types::CHANGE_PLAN:
+            appliedCount += this->moveObjectPlan(change._sid, change._plan) ? 1 : 0;
+            break;
+        case fge::Scene::DeferredChange::Types::CHANGE_PLAN_TOP:
+            appliedCount += this->moveObjectPlanTop(change._sid) ? 1 : 0;
+            break;
+        case fge::Scene::DeferredChange::Types::CHANGE_PLAN_BOT:
+            appliedCount += this->moveObjectPlanBot(change._sid) ? 1 : 0;
+            break;
+        }
+    }
 
-        this->_onPlanUpdate.call(this, plan);
-
-        return true;
+    if ( !newObjects.empty() )
+    {
+        this->_onNewObjectBatch.call(this, newObjects);
     }
-    return false;
+    if (appliedCount > 0)
+    {
+        this->_onPlanUpdate.call(this, FGE_SCENE_BAD_PLAN);
+    }
+    return appliedCount;
 }
 
 fge::ObjectDataShared Scene::getObject(fge::ObjectSid sid) const
@@ -624,28 +774,58 @@ std::size_t Scene::getAllObj_FromLocalZone(const sf::Rect<int>& zone, const sf::
 std::size_t Scene::getAllObj_ByClass(std::string_view class_name, fge::ObjectContainer& buff) const
 {
     std::size_t objCount = 0;
-    for (const auto & data : this->g_data)
+
+    fge::reg::ClassId classId = fge::reg::GetClassId(class_name);
+    if (classId != FGE_REG_BADCLASSID)
+    {
+        objCount = this->getAllObj_ByClass(classId, buff);
+    }
+
+    //Objects that are not registered (or added before their registration)
+    auto it = this->g_classIndex.find(FGE_REG_BADCLASSID);
+    if (it != this->g_classIndex.cend())
     {
-        if ( data->g_object->getClassName() == class_name )
+        for (const auto & data : it->second)
         {
-            ++objCount;
-            buff.push_back(data);
+            if ( data->g_object->getClassName() == class_name )
+            {
+                ++objCount;
+                buff.push_back(data);
+            }
         }
     }
     return objCount;
 }
+std::size_t Scene::getAllObj_ByClass(fge::reg::ClassId class_id, fge::ObjectContainer& buff) const
+{
+    if (class_id == FGE_REG_BADCLASSID)
+    {
+        return 0;
+    }
+
+    auto it = this->g_classIndex.find(class_id);
+    if (it == this->g_classIndex.cend())
+    {
+        return 0;
+    }
+
+    buff.insert(buff.end(), it->second.begin(), it->second.end());
+    return it->second.size();
+}
 std::size_t Scene::getAllObj_ByTag(std::string_view tag_name, fge::ObjectContainer& buff) const
 {
-    std::size_t objCount = 0;
-    for (const auto & data : this->g_data)
+    return this->getAllObj_ByTag(fge::tag::GetTagId(tag_name), buff);
+}
+std::size_t Scene::getAllObj_ByTag(fge::tag::TagId tag_id, fge::ObjectContainer& buff) const
+{
+    auto it = this->g_tagIndex.find(tag_id);
+    if (it == this->g_tagIndex.cend())
     {
-        if ( data->g_object->_tags.check(tag_name) )
-        {
-            ++objCount;
-            buff.push_back(data);
-        }
+        return 0;
     }
-    return objCount;
+
+    buff.insert(buff.end(), it->second.begin(), it->second.end());
+    return it->second.size();
 }
 
 fge::ObjectDataShared Scene::getFirstObj_ByPosition(const sf::Vector2f& pos) const
@@ -714,25 +894,97 @@ fge::ObjectDataShared Scene::getFirstObj_FromLocalZone(const sf::Rect<int>& zone
 
 fge::ObjectDataShared Scene::getFirstObj_ByClass(std::string_view class_name) const
 {
-    for (const auto & data : this->g_data)
+    const fge::ObjectIndex* registeredIndex = nullptr;
+    const fge::ObjectIndex* unregisteredIndex = nullptr;
+
+    fge::reg::ClassId classId = fge::reg::GetClassId(class_name);
+    if (classId != FGE_REG_BADCLASSID)
     {
-        if ( data->g_object->getClassName() == class_name )
+        auto it = this->g_classIndex.find(classId);
+        if (it != this->g_classIndex.cend())
         {
-            return data;
+            registeredIndex = &it->second;
         }
     }
-    return nullptr;
+    auto it = this->g_classIndex.find(FGE_REG_BADCLASSID);
+    if (it != this->g_classIndex.cend())
+    {
+        unregisteredIndex = &it->second;
+    }
+
+    auto isMatching = [&](const fge::ObjectDataShared& data){
+        return (registeredIndex != nullptr && registeredIndex->count(data) > 0) ||
+               (unregisteredIndex != nullptr && unregisteredIndex->count(data) > 0 && data->g_object->getClassName() == class_name);
+    };
+
+    //Find the lowest plan, the Objects of this plan are then visited in order
+    fge::ObjectDataShared first;
+    std::size_t firstCount = 0;
+    for (const auto* index : {registeredIndex, unregisteredIndex})
+    {
+        if (index == nullptr)
+        {
+            continue;
+        }
+        for (const auto& data : *index)
+        {
+            if (index == unregisteredIndex && data->g_object->getClassName() != class_name)
+            {
+                continue;
+            }
+            if (!first || data->g_plan < first->g_plan)
+            {
+                first = data;
+                firstCount = 1;
+            }
+            else if (data->g_plan == first->g_plan)
+            {
+                ++firstCount;
+            }
+        }
+    }
+
+    if (firstCount > 1)
+    {
+        return this->getFirstObj_InPlan(first->g_plan, isMatching);
+    }
+    return first;
 }
 fge::ObjectDataShared Scene::getFirstObj_ByTag(std::string_view tag_name) const
 {
-    for (const auto & data : this->g_data)
+    return this->getFirstObj_ByTag(fge::tag::GetTagId(tag_name));
+}
+fge::ObjectDataShared Scene::getFirstObj_ByTag(fge::tag::TagId tag_id) const
+{
+    auto it = this->g_tagIndex.find(tag_id);
+    if (it == this->g_tagIndex.cend())
     {
-        if ( data->g_object->_tags.check(tag_name) )
+        return nullptr;
+    }
+
+    //Find the lowest plan, the Objects of this plan are then visited in order
+    fge::ObjectDataShared first;
+    std::size_t firstCount = 0;
+    for (const auto& data : it->second)
+    {
+        if (!first || data->g_plan < first->g_plan)
         {
-            return data;
+            first = data;
+            firstCount = 1;
+        }
+        else if (data->g_plan == first->g_plan)
+        {
+            ++firstCount;
         }
     }
-    return nullptr;
+
+    if (firstCount > 1)
+    {
+        return this->getFirstObj_InPlan(first->g_plan, [&](const fge::ObjectDataShared& data){
+            return it->second.count(data) > 0;
+        });
+    }
+    return first;
 }
 
 /** Static id **/
@@ -752,7 +1004,7 @@ fge::ObjectSid Scene::generateSid(fge::ObjectSid wanted_sid) const
 {
     if ( wanted_sid != FGE_SCENE_BAD_SID )
     {
-        if ( this->g_dataMap.find(wanted_sid) == this->g_dataMap.cend() )
+        if ( !this->isDeferredValid(wanted_sid) )
         {
             return wanted_sid;
         }
@@ -762,16 +1014,24 @@ fge::ObjectSid Scene::generateSid(fge::ObjectSid wanted_sid) const
         }
     }
 
+    //Proposed SIDs can already be taken by an Object added with a wanted SID, they are simply skipped
     fge::ObjectSid new_sid;
-    while ( true )
+    do
     {
-        new_sid = fge::_random.range<fge::ObjectSid>(0, FGE_SCENE_BAD_SID);
-
-        if ( this->g_dataMap.find(wanted_sid) == this->g_dataMap.cend() )
-        {
-            return new_sid;
-        }
+        new_sid = this->g_sidAllocator.get();
     }
+    while ( new_sid != FGE_SCENE_BAD_SID && this->isDeferredValid(new_sid) );
+
+    return new_sid;
+}
+
+void Scene::setSidAllocator(const fge::SidAllocator& allocator)
+{
+    this->g_sidAllocator = allocator;
+}
+const fge::SidAllocator& Scene::getSidAllocator() const
+{
+    return this->g_sidAllocator;
 }
 
 /** Network **/
@@ -849,15 +1109,18 @@ void Scene::unpack(fge::net::Packet& pck)
         FGE_NET_RULES_AFFECT_END(buffType)
 
         fge::ObjectPtr buffObject{fge::reg::GetNewClassOf(buffClass)};
-        if (buffObject)
+        if (!buffObject)
         {
-            this->newObject(std::move(buffObject), buffPlan, buffSid, static_cast<fge::ObjectType>(buffType) )->g_object->unpack(pck);
+            pck.invalidate();
+            return;
         }
-        else
-        {
+        auto newObject = this->newObject(std::move(buffObject), buffPlan, buffSid, static_cast<fge::ObjectType>(buffType) );
+        if (!newObject)
+        {//The SID is already taken by a kept Object
             pck.invalidate();
             return;
         }
+        newObject->g_object->unpack(pck);
     }
 }
 void Scene::packModification(fge::net::Packet& pck, fge::net::ClientList& clients, const fge::net::Identity& id)
@@ -1340,7 +1603,13 @@ void Scene::unpackWatchedEvent(fge::net::Packet& pck)
                 pck.invalidate();
                 return;
             }
-            this->newObject(FGE_NEWOBJECT_PTR(newObj), buffPlan, buffSid, static_cast<fge::ObjectType>(buffType))->g_object->unpack(pck);
+            auto newObject = this->newObject(FGE_NEWOBJECT_PTR(newObj), buffPlan, buffSid, static_cast<fge::ObjectType>(buffType));
+            if (!newObject)
+            {
+                pck.invalidate();
+                return;
+            }
+            newObject->g_object->unpack(pck);
         }
         else if (event == fge::SceneNetEvent::SEVT_DELOBJECT)
         {//Remove object
@@ -1372,6 +1641,26 @@ void Scene::delCustomView()
     this->g_customView.reset();
 }
 
+#ifndef FGE_DEF_SERVER
+/** Batching **/
+void Scene::setBatching(bool enable)
+{
+    this->g_batching = enable;
+}
+bool Scene::isBatching() const
+{
+    return this->g_batching;
+}
+const fge::SpriteBatch& Scene::getSpriteBatch() const
+{
+    return this->g_spriteBatch;
+}
+fge::SpriteBatch& Scene::getSpriteBatch()
+{
+    return this->g_spriteBatch;
+}
+#endif //FGE_DEF_SERVER
+
 /** Linked renderTarget **/
 void Scene::setLinkedRenderTarget(sf::RenderTarget* target)
 {
@@ -1459,9 +1748,14 @@ bool Scene::loadFromFile(const std::string& path)
         {
             nlohmann::json& objJson = it.begin().value();
 
-            this->newObject(std::move(buffObj), objJson["_plan"].get<fge::ObjectPlan>(),
-                                                objJson["_sid"].get<fge::ObjectSid>(),
-                                                objJson["_type"].get<fge::ObjectType>() )->g_object->load(objJson, this);
+            auto newObject = this->newObject(std::move(buffObj), objJson["_plan"].get<fge::ObjectPlan>(),
+                                                                 objJson["_sid"].get<fge::ObjectSid>(),
+                                                                 objJson["_type"].get<fge::ObjectType>() );
+            if (!newObject)
+            {
+                return false;
+            }
+            newObject->g_object->load(objJson, this);
         }
         else
         {
@@ -1495,6 +1789,195 @@ fge::ObjectContainer::const_iterator Scene::findPlan(fge::ObjectPlan plan) const
 }
 
 ///Private
+fge::ObjectDataShared Scene::getFirstObj_InPlan(fge::ObjectPlan plan, const std::function<bool(const fge::ObjectDataShared&)>& predicate) const
+{
+    for (auto it=this->findPlan(plan); it!=this->g_data.cend() && (*it)->g_plan == plan; ++it)
+    {
+        if ( predicate(*it) )
+        {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+bool Scene::isDeferredValid(fge::ObjectSid sid) const
+{
+    return this->g_dataMap.find(sid) != this->g_dataMap.cend() ||
+           this->g_deferredSids.find(sid) != this->g_deferredSids.cend();
+}
+
+void Scene::indexObject(const fge::ObjectDataShared& objectData)
+{
+    fge::Object* object = objectData->g_object.get();
+
+    this->g_classIndex[fge::reg::GetClassId(object->getClassName())].insert(objectData);
+    for (auto tagId : object->_tags)
+    {
+        this->g_tagIndex[tagId].insert(objectData);
+    }
+    object->_tags.setListener(objectData.get());
+}
+void Scene::unindexObject(const fge::ObjectDataShared& objectData)
+{
+    fge::Object* object = objectData->g_object.get();
+    object->_tags.setListener(nullptr);
+
+    auto itClass = this->g_classIndex.find(fge::reg::GetClassId(object->getClassName()));
+    if (itClass == this->g_classIndex.end() || itClass->second.erase(objectData) == 0)
+    {//The class could have been registered after the Object insertion
+        itClass = this->g_classIndex.find(FGE_REG_BADCLASSID);
+        if (itClass != this->g_classIndex.end())
+        {
+            itClass->second.erase(objectData);
+        }
+    }
+    if (itClass != this->g_classIndex.end() && itClass->second.empty())
+    {
+        this->g_classIndex.erase(itClass);
+    }
+
+    for (auto tagId : object->_tags)
+    {
+        auto itTag = this->g_tagIndex.find(tagId);
+        if (itTag != this->g_tagIndex.end())
+        {
+            itTag->second.erase(objectData);
+            if (itTag->second.empty())
+            {
+                this->g_tagIndex.erase(itTag);
+            }
+        }
+    }
+}
+
+fge::ObjectDataShared Scene::insertObject(const fge::ObjectDataShared& objectData)
+{
+    fge::ObjectSid generatedSid = this->generateSid( objectData->g_sid );
+    if (generatedSid == FGE_SCENE_BAD_SID)
+    {
+        return nullptr;
+    }
+    if (this->g_enableNetworkEventsFlag)
+    {
+        this->pushEvent({fge::SceneNetEvent::SEVT_NEWOBJECT, generatedSid});
+    }
+
+    objectData->g_sid = generatedSid;
+
+    auto it = this->getInsertBeginPositionWithPlan(objectData->g_plan);
+
+    it = this->g_data.insert( it, objectData );
+    this->g_dataMap[generatedSid] = it;
+    objectData->g_linkedScene = this;
+    objectData->g_object->_myObjectData = objectData;
+    this->indexObject(objectData);
+    this->refreshPlanDataMap(objectData->g_plan, it, false);
+    if ((this->g_updatedObjectIterator != this->g_data.end()) && objectData->g_parent.expired())
+    {//An object is created inside another object and orphan, make it parent
+        objectData->g_parent = *this->g_updatedObjectIterator;
+    }
+    objectData->g_object->first(this);
+
+    if (objectData->g_object->_callbackContextMode == fge::Object::CallbackContextModes::CONTEXT_AUTO &&
+        this->g_callbackContext._event != nullptr)
+    {
+        objectData->g_object->callbackRegister(*this->g_callbackContext._event, this->g_callbackContext._guiElementHandler);
+    }
+
+    this->_onNewObject.call(this, objectData);
+
+    return objectData;
+}
+void Scene::removeObject(fge::ObjectDataMap::iterator it)
+{
+    if (this->g_enableNetworkEventsFlag)
+    {
+        this->pushEvent({fge::SceneNetEvent::SEVT_DELOBJECT, (*it->second)->g_sid});
+    }
+
+    (*it->second)->g_object->removed(this);
+    this->_onRemoveObject.call(this, *it->second);
+    this->unindexObject(*it->second);
+    (*it->second)->g_linkedScene = nullptr;
+    (*it->second)->g_object->_myObjectData.reset();
+    this->refreshPlanDataMap((*it->second)->g_plan, it->second, true);
+    this->g_data.erase(it->second);
+    this->g_sidAllocator.release(it->first);
+    this->g_dataMap.erase(it);
+}
+bool Scene::moveObjectPlan(fge::ObjectSid sid, fge::ObjectPlan newPlan)
+{
+    auto it = this->g_dataMap.find(sid);
+
+    if ( it != this->g_dataMap.end() )
+    {
+        this->refreshPlanDataMap((*it->second)->g_plan, it->second, true);
+
+        auto newPosIt = this->getInsertBeginPositionWithPlan(newPlan);
+
+        (*it->second)->g_plan = newPlan;
+
+        this->g_data.splice(newPosIt, this->g_data, it->second);
+        this->refreshPlanDataMap(newPlan, it->second, false);
+        return true;
+    }
+    return false;
+}
+bool Scene::moveObjectPlanTop(fge::ObjectSid sid)
+{
+    auto it = this->g_dataMap.find(sid);
+
+    if ( it != this->g_dataMap.end() )
+    {
+        auto newPosIt = this->g_planDataMap.find( (*it->second)->g_plan );
+
+        if (it->second == newPosIt->second)
+        {//already on top
+            return true;
+        }
+
+        this->g_data.splice(newPosIt->second, this->g_data, it->second);
+        this->refreshPlanDataMap((*it->second)->g_plan, it->second, false);
+        return true;
+    }
+    return false;
+}
+bool Scene::moveObjectPlanBot(fge::ObjectSid sid)
+{
+    auto it = this->g_dataMap.find(sid);
+
+    if ( it != this->g_dataMap.end() )
+    {
+        auto plan = (*it->second)->g_plan;
+        auto planIt = this->g_planDataMap.find(plan);
+        auto planItAfter = planIt;
+        ++planItAfter; //Next plan
+
+        bool wasOnTop = false;
+        if (it->second == planIt->second)
+        {//is on top
+            wasOnTop = true;
+            this->refreshPlanDataMap(plan, it->second, true);
+        }
+
+        if (planItAfter == this->g_planDataMap.end())
+        {//object can be pushed at the end
+            this->g_data.splice(this->g_data.end(), this->g_data, it->second);
+        }
+        else
+        {
+            this->g_data.splice(planItAfter->second, this->g_data, it->second);
+        }
+        if (wasOnTop)
+        {
+            this->refreshPlanDataMap(plan, it->second, false);
+        }
+        return true;
+    }
+    return false;
+}
+
 void Scene::refreshPlanDataMap(fge::ObjectPlan plan, fge::ObjectContainer::iterator hintIt, bool isLeaving)
 {
     /*
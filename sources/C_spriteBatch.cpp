@@ -0,0 +1,168 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_spriteBatch.hpp"
+
+namespace fge
+{
+
+void SpriteBatch::begin(sf::RenderTarget* target)
+{
+    this->g_target = target;
+    this->g_vertices.clear();
+    this->g_texture = nullptr;
+    this->g_lastTextureKnown = false;
+}
+void SpriteBatch::end()
+{
+    this->flush();
+    this->g_target = nullptr;
+}
+
+void SpriteBatch::addQuad(const sf::Vertex* vertices, const sf::RenderStates& states)
+{
+    if ( !this->prepare(states) )
+    {
+        if (this->g_target != nullptr)
+        {
+            this->g_target->draw(vertices, 4, sf::TriangleStrip, states);
+        }
+        this->countTexture(states.texture);
+        ++this->g_stats._drawCalls;
+        ++this->g_stats._fallbackCount;
+        this->g_stats._vertexCount += 4;
+        return;
+    }
+
+    //Triangle strip 0,1,2,3 to triangles 0,1,2 and 2,1,3
+    const sf::Vector2f p0 = states.transform.transformPoint(vertices[0].position);
+    const sf::Vector2f p1 = states.transform.transformPoint(vertices[1].position);
+    const sf::Vector2f p2 = states.transform.transformPoint(vertices[2].position);
+    const sf::Vector2f p3 = states.transform.transformPoint(vertices[3].position);
+
+    this->g_vertices.emplace_back(p0, vertices[0].color, vertices[0].texCoords);
+    this->g_vertices.emplace_back(p1, vertices[1].color, vertices[1].texCoords);
+    this->g_vertices.emplace_back(p2, vertices[2].color, vertices[2].texCoords);
+    this->g_vertices.emplace_back(p2, vertices[2].color, vertices[2].texCoords);
+    this->g_vertices.emplace_back(p1, vertices[1].color, vertices[1].texCoords);
+    this->g_vertices.emplace_back(p3, vertices[3].color, vertices[3].texCoords);
+
+    ++this->g_stats._batchedCount;
+}
+void SpriteBatch::addTriangles(const sf::Vertex* vertices, std::size_t count, const sf::RenderStates& states)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if ( !this->prepare(states) )
+    {
+        if (this->g_target != nullptr)
+        {
+            this->g_target->draw(vertices, count, sf::Triangles, states);
+        }
+        this->countTexture(states.texture);
+        ++this->g_stats._drawCalls;
+        ++this->g_stats._fallbackCount;
+        this->g_stats._vertexCount += count;
+        return;
+    }
+
+    this->g_vertices.reserve(this->g_vertices.size() + count);
+    for (std::size_t i=0; i<count; ++i)
+    {
+        this->g_vertices.emplace_back(states.transform.transformPoint(vertices[i].position), vertices[i].color, vertices[i].texCoords);
+    }
+
+    ++this->g_stats._batchedCount;
+}
+void SpriteBatch::draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+    this->flush();
+
+    if (this->g_target != nullptr)
+    {
+        this->g_target->draw(drawable, states);
+    }
+    //The drawable can bind any texture
+    this->g_lastTextureKnown = false;
+    ++this->g_stats._drawCalls;
+    ++this->g_stats._fallbackCount;
+}
+
+void SpriteBatch::flush()
+{
+    if ( this->g_vertices.empty() )
+    {
+        return;
+    }
+
+    if (this->g_target != nullptr)
+    {
+        this->g_target->draw(this->g_vertices.data(), this->g_vertices.size(), sf::Triangles,
+                             sf::RenderStates{this->g_blendMode, sf::Transform::Identity, this->g_texture, nullptr});
+    }
+
+    this->countTexture(this->g_texture);
+    ++this->g_stats._drawCalls;
+    ++this->g_stats._flushCount;
+    this->g_stats._vertexCount += this->g_vertices.size();
+    this->g_vertices.clear();
+}
+
+sf::RenderTarget* SpriteBatch::getTarget() const
+{
+    return this->g_target;
+}
+
+const fge::SpriteBatch::Stats& SpriteBatch::getStats() const
+{
+    return this->g_stats;
+}
+void SpriteBatch::resetStats()
+{
+    this->g_stats = {};
+}
+
+bool SpriteBatch::prepare(const sf::RenderStates& states)
+{
+    if (states.shader != nullptr)
+    {
+        this->flush();
+        return false;
+    }
+
+    if ( !this->g_vertices.empty() && (states.texture != this->g_texture || states.blendMode != this->g_blendMode) )
+    {
+        this->flush();
+    }
+
+    this->g_texture = states.texture;
+    this->g_blendMode = states.blendMode;
+    return true;
+}
+void SpriteBatch::countTexture(const sf::Texture* texture)
+{
+    if (!this->g_lastTextureKnown || texture != this->g_lastTexture)
+    {
+        ++this->g_stats._textureBinds;
+    }
+    this->g_lastTexture = texture;
+    this->g_lastTextureKnown = true;
+}
+
+}//end fge
@@ -16,30 +16,97 @@
 
 #include "FastEngine/C_tagList.hpp"
 
+#include <algorithm>
+
 namespace fge
 {
 
+TagList::TagList(const fge::TagList& r) :
+    g_tags(r.g_tags),
+    g_listener(nullptr)
+{}
+
+fge::TagList& TagList::operator =(const fge::TagList& r)
+{
+    if (this != &r)
+    {
+        if (this->g_listener == nullptr)
+        {
+            this->g_tags = r.g_tags;
+        }
+        else
+        {
+            this->clear();
+            for (auto tagId : r.g_tags)
+            {
+                this->add(tagId);
+            }
+        }
+    }
+    return *this;
+}
+
 void TagList::clear()
 {
+    if (this->g_listener != nullptr)
+    {
+        for (auto tagId : this->g_tags)
+        {
+            this->g_listener->onTagRemoved(*this, tagId);
+        }
+    }
     this->g_tags.clear();
 }
 
 void TagList::add(std::string_view tag)
 {
-    this->g_tags.insert(std::string{tag});
+    this->add(fge::tag::Intern(tag));
+}
+void TagList::add(fge::tag::TagId tagId)
+{
+    if (tagId == FGE_TAG_BADID)
+    {
+        return;
+    }
+
+    auto it = std::lower_bound(this->g_tags.begin(), this->g_tags.end(), tagId);
+    if (it == this->g_tags.end() || *it != tagId)
+    {
+        this->g_tags.insert(it, tagId);
+        if (this->g_listener != nullptr)
+        {
+            this->g_listener->onTagAdded(*this, tagId);
+        }
+    }
 }
 void TagList::del(std::string_view tag)
 {
-    auto it = this->g_tags.find(tag);
-    if (it != this->g_tags.end())
+    if (this->g_tags.empty())
     {
+        return;
+    }
+    this->del(fge::tag::GetTagId(tag));
+}
+void TagList::del(fge::tag::TagId tagId)
+{
+    auto it = std::lower_bound(this->g_tags.begin(), this->g_tags.end(), tagId);
+    if (it != this->g_tags.end() && *it == tagId)
+    {
+        if (this->g_listener != nullptr)
+        {
+            this->g_listener->onTagRemoved(*this, tagId);
+        }
         this->g_tags.erase(it);
     }
 }
 
 bool TagList::check(std::string_view tag) const
 {
-    return this->g_tags.find(tag) != this->g_tags.end();
+    return !this->g_tags.empty() && this->check(fge::tag::GetTagId(tag));
+}
+bool TagList::check(fge::tag::TagId tagId) const
+{
+    return std::binary_search(this->g_tags.begin(), this->g_tags.end(), tagId);
 }
 
 std::size_t TagList::getSize() const
@@ -47,6 +114,15 @@ std::size_t TagList::getSize() const
     return this->g_tags.size();
 }
 
+void TagList::setListener(fge::TagList::Listener* listener)
+{
+    this->g_listener = listener;
+}
+fge::TagList::Listener* TagList::getListener() const
+{
+    return this->g_listener;
+}
+
 fge::TagList::TagListType::const_iterator TagList::begin() const
 {
     return this->g_tags.begin();
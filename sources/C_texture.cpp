@@ -58,8 +58,20 @@ bool Texture::valid() const
 
 sf::Vector2u Texture::getTextureSize() const
 {
+    if (this->g_data->_rect.width != 0)
+    {
+        return {static_cast<unsigned int>(this->g_data->_rect.width), static_cast<unsigned int>(this->g_data->_rect.height)};
+    }
     return this->g_data->_texture->getSize();
 }
+sf::IntRect Texture::getTextureRect() const
+{
+    if (this->g_data->_rect.width != 0)
+    {
+        return this->g_data->_rect;
+    }
+    return {{0,0}, static_cast<sf::Vector2i>(this->g_data->_texture->getSize())};
+}
 
 const fge::texture::TextureDataPtr& Texture::getData() const
 {
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_textureAtlas.hpp"
+
+namespace fge
+{
+
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding) :
+    g_pageSize(pageSize),
+    g_padding(padding)
+{}
+
+void TextureAtlas::clear()
+{
+    this->g_pages.clear();
+}
+void TextureAtlas::reset(unsigned int pageSize, unsigned int padding)
+{
+    this->g_pages.clear();
+    this->g_pageSize = pageSize;
+    this->g_padding = padding;
+}
+
+std::optional<fge::TextureAtlas::Location> TextureAtlas::add(const sf::Image& image, bool smooth)
+{
+    const sf::Vector2u size = image.getSize();
+    if (size.x == 0 || size.y == 0 || size.x > this->g_pageSize || size.y > this->g_pageSize)
+    {
+        return std::nullopt;
+    }
+
+    fge::TextureAtlas::Page* page = nullptr;
+    std::optional<sf::IntRect> rect;
+
+    for (auto& actualPage : this->g_pages)
+    {
+        if (actualPage._smooth != smooth)
+        {
+            continue;
+        }
+        rect = actualPage._packer.insert(size);
+        if (rect)
+        {
+            page = &actualPage;
+            break;
+        }
+    }
+
+    if (page == nullptr)
+    {
+        auto& newPage = this->g_pages.emplace_back();
+        newPage._packer.reset({this->g_pageSize, this->g_pageSize}, this->g_padding);
+        newPage._texture = std::make_shared<fge::TextureType>();
+        newPage._smooth = smooth;
+#ifdef FGE_DEF_SERVER
+        newPage._texture->create(this->g_pageSize, this->g_pageSize, sf::Color::Transparent);
+#else
+        if ( !newPage._texture->create(this->g_pageSize, this->g_pageSize) )
+        {
+            this->g_pages.pop_back();
+            return std::nullopt;
+        }
+        newPage._texture->setSmooth(smooth);
+#endif //FGE_DEF_SERVER
+
+        rect = newPage._packer.insert(size);
+        page = &newPage;
+    }
+
+#ifdef FGE_DEF_SERVER
+    page->_texture->copy(image, static_cast<unsigned int>(rect->left), static_cast<unsigned int>(rect->top));
+#else
+    page->_texture->update(image, static_cast<unsigned int>(rect->left), static_cast<unsigned int>(rect->top));
+#endif //FGE_DEF_SERVER
+
+    return fge::TextureAtlas::Location{page->_texture, *rect};
+}
+
+std::size_t TextureAtlas::getPageCount() const
+{
+    return this->g_pages.size();
+}
+const std::shared_ptr<fge::TextureType>& TextureAtlas::getPage(std::size_t index) const
+{
+    return this->g_pages[index]._texture;
+}
+float TextureAtlas::getPageOccupancy(std::size_t index) const
+{
+    return this->g_pages[index]._packer.getOccupancy();
+}
+bool TextureAtlas::isPageSmooth(std::size_t index) const
+{
+    return this->g_pages[index]._smooth;
+}
+
+unsigned int TextureAtlas::getPageSize() const
+{
+    return this->g_pageSize;
+}
+unsigned int TextureAtlas::getPadding() const
+{
+    return this->g_padding;
+}
+
+}//end fge
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/C_threadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace fge
+{
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        const std::size_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware-1 : 1;
+    }
+
+    this->g_threads.reserve(threadCount);
+    for (std::size_t i=0; i<threadCount; ++i)
+    {
+        this->g_threads.emplace_back(&fge::ThreadPool::work, this);
+    }
+}
+ThreadPool::~ThreadPool()
+{
+    this->wait();
+    {
+        std::lock_guard<std::mutex> lck(this->g_mutex);
+        this->g_stop = true;
+    }
+    this->g_cvTask.notify_all();
+
+    for (auto& thread : this->g_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(fge::ThreadPool::Task task)
+{
+    {
+        std::lock_guard<std::mutex> lck(this->g_mutex);
+        this->g_tasks.push(std::move(task));
+    }
+    this->g_cvTask.notify_one();
+}
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lck(this->g_mutex);
+    this->g_cvDone.wait(lck, [this](){ return this->g_tasks.empty() && this->g_runningTasks == 0; });
+}
+
+void ThreadPool::parallelFor(std::size_t count, const fge::ThreadPool::ForFunction& func)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<std::size_t> _next{0};
+        std::atomic<std::size_t> _done{0};
+        const fge::ThreadPool::ForFunction* _func{nullptr};
+        std::mutex _mutex;
+        std::condition_variable _cv;
+    };
+    //The state is shared, so a helper that start after the end don't access a dead stack
+    auto state = std::make_shared<State>();
+    state->_func = &func;
+
+    auto process = [](State& s, std::size_t count, std::size_t workerIndex)
+    {
+        std::size_t index;
+        while ( (index = s._next.fetch_add(1)) < count )
+        {
+            (*s._func)(index, workerIndex);
+            if (s._done.fetch_add(1)+1 == count)
+            {
+                std::lock_guard<std::mutex> lck(s._mutex);
+                s._cv.notify_all();
+            }
+        }
+    };
+
+    const std::size_t helpers = std::min(this->g_threads.size(), count-1);
+    for (std::size_t i=0; i<helpers; ++i)
+    {
+        this->submit([state, process, count, i](){ process(*state, count, i); });
+    }
+
+    process(*state, count, this->g_threads.size());
+
+    std::unique_lock<std::mutex> lck(state->_mutex);
+    state->_cv.wait(lck, [&](){ return state->_done.load() == count; });
+}
+
+std::size_t ThreadPool::getThreadCount() const
+{
+    return this->g_threads.size();
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        fge::ThreadPool::Task task;
+        {
+            std::unique_lock<std::mutex> lck(this->g_mutex);
+            this->g_cvTask.wait(lck, [this](){ return this->g_stop || !this->g_tasks.empty(); });
+            if (this->g_stop && this->g_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(this->g_tasks.front());
+            this->g_tasks.pop();
+            ++this->g_runningTasks;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lck(this->g_mutex);
+            --this->g_runningTasks;
+            if (this->g_tasks.empty() && this->g_runningTasks == 0)
+            {
+                this->g_cvDone.notify_all();
+            }
+        }
+    }
+}
+
+}//end fge
@@ -15,7 +15,9 @@
  */
 
 #include "FastEngine/C_tilelayer.hpp"
+#include "FastEngine/extra/extra_function.hpp"
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 
 namespace fge
 {
@@ -84,10 +86,12 @@ void TileLayer::Tile::updateTexCoords()
         if (tile != nullptr)
         {
             auto rect = tile->_rect;
+            //The tileset texture can be packed in an atlas page
+            const sf::IntRect area = this->g_tileSet->getTexture().getTextureRect();
 
-            float left   = static_cast<float>(rect.left);
+            float left   = static_cast<float>(area.left + rect.left);
             float right  = left + static_cast<float>(rect.width);
-            float top    = static_cast<float>(rect.top);
+            float top    = static_cast<float>(area.top + rect.top);
             float bottom = top + static_cast<float>(rect.height);
 
             this->g_vertex[0].texCoords = sf::Vector2f(left, top);
@@ -103,12 +107,28 @@ void TileLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
     states.transform *= this->getTransform();
 
-    for (const auto& data : this->g_data)
+    const sf::FloatRect viewRect = states.transform.getInverse().transformRect( fge::GetScreenRect(target) );
+
+    for (std::size_t ix=0; ix<this->g_chunks.getSizeX(); ++ix)
     {
-        if (data.g_tileSet)
+        for (std::size_t iy=0; iy<this->g_chunks.getSizeY(); ++iy)
         {
-            states.texture = static_cast<const sf::Texture*>(data.g_tileSet->getTexture());
-            target.draw(data.g_vertex, 4, sf::TriangleStrip, states);
+            auto& chunk = this->g_chunks[ix][iy];
+            if (chunk._dirty)
+            {
+                this->rebuildChunk(ix, iy);
+            }
+
+            if ( chunk._batches.empty() || !chunk._bounds.intersects(viewRect) )
+            {
+                continue;
+            }
+
+            for (const auto& batch : chunk._batches)
+            {
+                states.texture = batch._texture;
+                target.draw(batch._vertices, states);
+            }
         }
     }
 }
@@ -117,6 +137,10 @@ void TileLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const
 void TileLayer::clear()
 {
     this->g_data.clear();
+    this->g_collisions = std::make_shared<std::vector<uint64_t> >();
+#ifndef FGE_DEF_SERVER
+    this->g_chunks.clear();
+#endif //FGE_DEF_SERVER
 }
 
 void TileLayer::setId(TileId id)
@@ -155,6 +179,10 @@ void TileLayer::setGid(std::size_t x, std::size_t y, const TileSetList& tileSets
         }
         data->updatePositions();
         data->updateTexCoords();
+        this->updateCollision(x, y);
+#ifndef FGE_DEF_SERVER
+        this->invalidateChunk(x, y);
+#endif //FGE_DEF_SERVER
     }
 }
 void TileLayer::setGid(std::size_t x, std::size_t y, TileId gid)
@@ -163,12 +191,31 @@ void TileLayer::setGid(std::size_t x, std::size_t y, TileId gid)
     if (data != nullptr)
     {
         data->g_gid = gid;
+        this->updateCollision(x, y);
+#ifndef FGE_DEF_SERVER
+        this->invalidateChunk(x, y);
+#endif //FGE_DEF_SERVER
+    }
+}
+void TileLayer::setColor(std::size_t x, std::size_t y, const sf::Color& color)
+{
+    auto* data = this->g_data.getPtr(x,y);
+    if (data != nullptr)
+    {
+        data->setColor(color);
+#ifndef FGE_DEF_SERVER
+        this->invalidateChunk(x, y);
+#endif //FGE_DEF_SERVER
     }
 }
 void TileLayer::setGridSize(std::size_t x, std::size_t y)
 {
     this->g_data.clear();
     this->g_data.setSize(x, y);
+    this->g_collisions = std::make_shared<std::vector<uint64_t> >((x*y+63)/64, 0);
+#ifndef FGE_DEF_SERVER
+    this->resizeChunks();
+#endif //FGE_DEF_SERVER
 }
 
 void TileLayer::refreshTextures(const TileSetList& tileSets)
@@ -189,8 +236,42 @@ void TileLayer::refreshTextures(const TileSetList& tileSets)
             data.updateTexCoords();
         }
     }
+    this->refreshCollisions();
+#ifndef FGE_DEF_SERVER
+    this->invalidateAllChunks();
+#endif //FGE_DEF_SERVER
 }
 
+void TileLayer::setCollisionProperty(std::string property)
+{
+    this->g_collisionProperty = fge::PropertyKey{property};
+    this->refreshCollisions();
+}
+const std::string& TileLayer::getCollisionProperty() const
+{
+    return this->g_collisionProperty.getName();
+}
+std::shared_ptr<const std::vector<uint64_t> > TileLayer::getCollisions() const
+{
+    return this->g_collisions;
+}
+bool TileLayer::isSolid(std::size_t x, std::size_t y) const
+{
+    if (x >= this->g_data.getSizeX() || y >= this->g_data.getSizeY())
+    {
+        return false;
+    }
+    const std::size_t index = y*this->g_data.getSizeX() + x;
+    return ((*this->g_collisions)[index/64] >> (index%64)) & 1;
+}
+
+#ifndef FGE_DEF_SERVER
+std::size_t TileLayer::getChunkCount() const
+{
+    return this->g_chunks.getSizeX() * this->g_chunks.getSizeY();
+}
+#endif //FGE_DEF_SERVER
+
 std::shared_ptr<fge::TileSet> TileLayer::retrieveAssociatedTileSet(const TileSetList& tileSets, TileId gid)
 {
     for (const auto& tileSet : tileSets)
@@ -203,6 +284,162 @@ std::shared_ptr<fge::TileSet> TileLayer::retrieveAssociatedTileSet(const TileSet
     return nullptr;
 }
 
+bool TileLayer::isTileSolid(const TileLayer::Tile& tile) const
+{
+    if (!tile.g_tileSet)
+    {
+        return false;
+    }
+    const auto* tileData = tile.g_tileSet->getTile(tile.g_tileSet->getLocalId(tile.g_gid));
+    if (tileData == nullptr)
+    {
+        return false;
+    }
+    auto it = tileData->_properties.find(this->g_collisionProperty);
+    return it != tileData->_properties.end() && it->second.get<bool>().value_or(false);
+}
+std::vector<uint64_t>& TileLayer::getWritableCollisions()
+{
+    if (this->g_collisions.use_count() > 1)
+    {//Someone still use this snapshot, we need our own copy
+        auto collisions = std::make_shared<std::vector<uint64_t> >(*this->g_collisions);
+        this->g_collisions = collisions;
+        return *collisions;
+    }
+    //Every bitmap is created non-const, the const is only here to prevent writes while shared
+    return const_cast<std::vector<uint64_t>&>(*this->g_collisions);
+}
+void TileLayer::updateCollision(std::size_t x, std::size_t y)
+{
+    const std::size_t index = y*this->g_data.getSizeX() + x;
+    const uint64_t mask = uint64_t{1} << (index%64);
+    const bool solid = this->isTileSolid(this->g_data[x][y]);
+
+    if ((((*this->g_collisions)[index/64] & mask) != 0) == solid)
+    {//Nothing changed, avoid a copy of a shared bitmap
+        return;
+    }
+
+    auto& collisions = this->getWritableCollisions();
+    if (solid)
+    {
+        collisions[index/64] |= mask;
+    }
+    else
+    {
+        collisions[index/64] &=~ mask;
+    }
+
+    this->_onCollisionChanged.call(*this, x, y, solid);
+}
+void TileLayer::refreshCollisions()
+{
+    const std::size_t sizeX = this->g_data.getSizeX();
+    const std::size_t sizeY = this->g_data.getSizeY();
+    std::vector<uint64_t> collisions((sizeX*sizeY+63)/64, 0);
+
+    for (std::size_t ix=0; ix<sizeX; ++ix)
+    {
+        for (std::size_t iy=0; iy<sizeY; ++iy)
+        {
+            if (this->isTileSolid(this->g_data[ix][iy]))
+            {
+                const std::size_t index = iy*sizeX + ix;
+                collisions[index/64] |= uint64_t{1} << (index%64);
+            }
+        }
+    }
+
+    this->g_collisions = std::make_shared<std::vector<uint64_t> >(std::move(collisions));
+}
+
+#ifndef FGE_DEF_SERVER
+void TileLayer::resizeChunks()
+{
+    this->g_chunks.clear();
+    this->g_chunks.setSize((this->g_data.getSizeX() + FGE_TILELAYER_CHUNK_SIZE - 1) / FGE_TILELAYER_CHUNK_SIZE,
+                           (this->g_data.getSizeY() + FGE_TILELAYER_CHUNK_SIZE - 1) / FGE_TILELAYER_CHUNK_SIZE);
+}
+void TileLayer::invalidateChunk(std::size_t x, std::size_t y)
+{
+    auto* chunk = this->g_chunks.getPtr(x / FGE_TILELAYER_CHUNK_SIZE, y / FGE_TILELAYER_CHUNK_SIZE);
+    if (chunk != nullptr)
+    {
+        chunk->_dirty = true;
+    }
+}
+void TileLayer::invalidateAllChunks()
+{
+    for (std::size_t ix=0; ix<this->g_chunks.getSizeX(); ++ix)
+    {
+        for (std::size_t iy=0; iy<this->g_chunks.getSizeY(); ++iy)
+        {
+            this->g_chunks[ix][iy]._dirty = true;
+        }
+    }
+}
+void TileLayer::rebuildChunk(std::size_t chunkX, std::size_t chunkY) const
+{
+    auto& chunk = this->g_chunks[chunkX][chunkY];
+
+    chunk._dirty = false;
+    chunk._batches.clear();
+
+    const std::size_t endX = std::min((chunkX+1) * FGE_TILELAYER_CHUNK_SIZE, this->g_data.getSizeX());
+    const std::size_t endY = std::min((chunkY+1) * FGE_TILELAYER_CHUNK_SIZE, this->g_data.getSizeY());
+
+    sf::Vector2f boundsMin{0.0f, 0.0f};
+    sf::Vector2f boundsMax{0.0f, 0.0f};
+    bool emptyBounds = true;
+
+    for (std::size_t ix=chunkX*FGE_TILELAYER_CHUNK_SIZE; ix<endX; ++ix)
+    {
+        for (std::size_t iy=chunkY*FGE_TILELAYER_CHUNK_SIZE; iy<endY; ++iy)
+        {
+            const auto& data = this->g_data[ix][iy];
+            if (!data.g_tileSet)
+            {
+                continue;
+            }
+
+            const auto* texture = static_cast<const sf::Texture*>(data.g_tileSet->getTexture());
+            auto itBatch = std::find_if(chunk._batches.begin(), chunk._batches.end(), [texture](const TileLayer::Chunk::Batch& batch){
+                return batch._texture == texture;
+            });
+            if (itBatch == chunk._batches.end())
+            {
+                itBatch = chunk._batches.emplace(chunk._batches.end());
+                itBatch->_texture = texture;
+            }
+
+            //Triangle strip 0,1,2,3 to triangles 0,1,2 and 2,1,3
+            itBatch->_vertices.append(data.g_vertex[0]);
+            itBatch->_vertices.append(data.g_vertex[1]);
+            itBatch->_vertices.append(data.g_vertex[2]);
+            itBatch->_vertices.append(data.g_vertex[2]);
+            itBatch->_vertices.append(data.g_vertex[1]);
+            itBatch->_vertices.append(data.g_vertex[3]);
+
+            if (emptyBounds)
+            {
+                emptyBounds = false;
+                boundsMin = data.g_vertex[0].position;
+                boundsMax = data.g_vertex[3].position;
+            }
+            else
+            {
+                boundsMin.x = std::min(boundsMin.x, data.g_vertex[0].position.x);
+                boundsMin.y = std::min(boundsMin.y, data.g_vertex[0].position.y);
+                boundsMax.x = std::max(boundsMax.x, data.g_vertex[3].position.x);
+                boundsMax.y = std::max(boundsMax.y, data.g_vertex[3].position.y);
+            }
+        }
+    }
+
+    chunk._bounds = {boundsMin, boundsMax - boundsMin};
+}
+#endif //FGE_DEF_SERVER
+
 void to_json(nlohmann::json& j, const fge::TileLayer& p)
 {
     j = nlohmann::json{{"id", p.getId()},
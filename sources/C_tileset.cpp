@@ -307,18 +307,18 @@ void to_json(nlohmann::json& j, const fge::TileData& p)
             switch (property.second.getType())
             {//TODO: add a bool type for property
             case fge::Property::Types::PTYPE_INTEGERS:
-                propertiesArray.push_back({{"name", property.first},
+                propertiesArray.push_back({{"name", property.first.getName()},
                                            {"type", "int"},
                                            {"value", property.second.get<fge::PintType>().value_or(0)}});
                 break;
             case fge::Property::Types::PTYPE_FLOAT:
             case fge::Property::Types::PTYPE_DOUBLE:
-                propertiesArray.push_back({{"name", property.first},
+                propertiesArray.push_back({{"name", property.first.getName()},
                                            {"type", "float"},
                                            {"value", property.second.get<fge::PfloatType>().value_or(0.0f)}});
                 break;
             case fge::Property::Types::PTYPE_STRING:
-                propertiesArray.push_back({{"name", property.first},
+                propertiesArray.push_back({{"name", property.first.getName()},
                                            {"type", "string"},
                                            {"value", property.second.get<std::string>().value_or("")}});
                 break;
@@ -22,10 +22,11 @@ namespace fge
 Timer::Timer(const fge::Timer& timer) :
         g_lifeTimePoint( timer.g_lifeTimePoint ),
 
-        g_elapsedTime(timer.g_elapsedTime ),
+        g_elapsedTime(timer.getElapsedTime() ),
         g_goalDuration( timer.g_goalDuration ),
 
         g_isPaused( timer.g_isPaused ),
+        g_dispatchPolicy( timer.getDispatchPolicy() ),
         g_name( timer.g_name )
 {
 
@@ -33,10 +34,11 @@ Timer::Timer(const fge::Timer& timer) :
 Timer::Timer(fge::Timer&& timer) noexcept :
         g_lifeTimePoint( std::move(timer.g_lifeTimePoint) ),
 
-        g_elapsedTime(std::move(timer.g_elapsedTime) ),
+        g_elapsedTime(timer.getElapsedTime() ),
         g_goalDuration( std::move(timer.g_goalDuration) ),
 
         g_isPaused( std::move(timer.g_isPaused) ),
+        g_dispatchPolicy( timer.getDispatchPolicy() ),
         g_name( std::move(timer.g_name) )
 {
 
@@ -87,6 +89,17 @@ const std::string& Timer::getName() const
     return this->g_name;
 }
 
+void Timer::setDispatchPolicy(fge::Timer::DispatchPolicies policy)
+{
+    std::lock_guard<std::mutex> lck(this->g_mutex);
+    this->g_dispatchPolicy = policy;
+}
+fge::Timer::DispatchPolicies Timer::getDispatchPolicy() const
+{
+    std::lock_guard<std::mutex> lck(this->g_mutex);
+    return this->g_dispatchPolicy;
+}
+
 void Timer::setGoalDuration(const std::chrono::milliseconds& t)
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
@@ -109,6 +122,7 @@ void Timer::setElapsedTime(const std::chrono::milliseconds& t)
     if (!this->g_isPaused)
     {
         this->g_elapsedTime = t;
+        this->g_updateTimePoint = std::chrono::steady_clock::now();
     }
 }
 void Timer::addToElapsedTime(const std::chrono::milliseconds& t)
@@ -116,6 +130,7 @@ void Timer::addToElapsedTime(const std::chrono::milliseconds& t)
     std::lock_guard<std::mutex> lck(this->g_mutex);
     if (!this->g_isPaused)
     {
+        this->foldElapsedTime();
         this->g_elapsedTime += t;
     }
 }
@@ -124,6 +139,7 @@ void Timer::subToElapsedTime(const std::chrono::milliseconds& t)
     std::lock_guard<std::mutex> lck(this->g_mutex);
     if (!this->g_isPaused)
     {
+        this->foldElapsedTime();
         this->g_elapsedTime -= t;
     }
 }
@@ -139,10 +155,10 @@ std::chrono::milliseconds Timer::getLifeDuration() const
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->g_lifeTimePoint);
 }
 
-const std::chrono::milliseconds& Timer::getElapsedTime() const
+std::chrono::milliseconds Timer::getElapsedTime() const
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
-    return this->g_elapsedTime;
+    return this->computeElapsedTime();
 }
 const std::chrono::milliseconds& Timer::getGoalDuration() const
 {
@@ -153,29 +169,35 @@ const std::chrono::milliseconds& Timer::getGoalDuration() const
 std::chrono::milliseconds Timer::getTimeLeft() const
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
-    return this->g_goalDuration - this->g_elapsedTime;
+    return this->g_goalDuration - this->computeElapsedTime();
 }
 
 bool Timer::goalReached() const
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
-    return (this->g_goalDuration - this->g_elapsedTime).count() <= 0;
+    return (this->g_goalDuration - this->computeElapsedTime()).count() <= 0;
 }
 void Timer::restart()
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
     this->g_elapsedTime = std::chrono::milliseconds(0);
+    this->g_updateTimePoint = std::chrono::steady_clock::now();
 }
 
 void Timer::pause()
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
+    this->foldElapsedTime();
     this->g_isPaused = true;
 }
 void Timer::resume()
 {
     std::lock_guard<std::mutex> lck(this->g_mutex);
-    this->g_isPaused = false;
+    if (this->g_isPaused)
+    {
+        this->g_isPaused = false;
+        this->g_updateTimePoint = std::chrono::steady_clock::now();
+    }
 }
 bool Timer::isPaused() const
 {
@@ -183,4 +205,23 @@ bool Timer::isPaused() const
     return this->g_isPaused;
 }
 
+std::chrono::milliseconds Timer::computeElapsedTime() const
+{
+    if (this->g_isScheduled && !this->g_isPaused)
+    {
+        return this->g_elapsedTime + std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->g_updateTimePoint);
+    }
+    return this->g_elapsedTime;
+}
+void Timer::foldElapsedTime()
+{
+    if (this->g_isScheduled && !this->g_isPaused)
+    {
+        //Only whole milliseconds are moved, the remainder is kept in the time point
+        const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->g_updateTimePoint);
+        this->g_elapsedTime += delta;
+        this->g_updateTimePoint += delta;
+    }
+}
+
 }//end fge
@@ -0,0 +1,283 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/extra/extra_flowField.hpp"
+#include <algorithm>
+
+#define FGE_FLOWFIELD_STRAIGHT_COST 10
+#define FGE_FLOWFIELD_DIAGONAL_COST 14
+
+namespace fge::AStar
+{
+
+namespace
+{
+
+//Straight directions first, the opposite of a direction is 2 indices away in its group
+const fge::AStar::Vector2i FlowDirections[8]{
+    {0, 1}, {1, 0}, {0, -1}, {-1, 0},
+    {1, 1}, {1, -1}, {-1, -1}, {-1, 1}
+};
+
+constexpr uint8_t GetOppositeDirection(std::size_t direction)
+{
+    return static_cast<uint8_t>((direction & 4) | ((direction+2) & 3));
+}
+
+template<class THeapEntry>
+bool HeapCompareFunction(const THeapEntry& left, const THeapEntry& right)
+{
+    return left._cost > right._cost;
+}
+
+}//end
+
+void FlowField::compute(const fge::AStar::Generator& generator, const fge::AStar::CoordinateList& goals)
+{
+    this->g_worldSize = generator.getWorldSize();
+    this->g_directionsCount = generator.isDiagonalMovementEnabled() ? 8 : 4;
+    this->g_goals = goals;
+
+    this->g_costs.setSize(this->g_worldSize);
+    this->g_costs.fill(FGE_FLOWFIELD_NO_COST);
+    this->g_directions.setSize(this->g_worldSize);
+    this->g_directions.fill(FGE_FLOWFIELD_NO_DIRECTION);
+
+    this->g_openHeap.clear();
+    for (const auto& goal : this->g_goals)
+    {
+        if (generator.detectCollision(goal))
+        {
+            continue;
+        }
+        this->g_costs.get(goal) = 0;
+        this->g_openHeap.push_back({0, this->getIndex(goal)});
+    }
+    std::make_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+
+    this->propagate(generator);
+}
+void FlowField::update(const fge::AStar::Generator& generator, fge::AStar::Vector2i coord)
+{
+    if (this->g_worldSize != generator.getWorldSize() ||
+        this->g_directionsCount != (generator.isDiagonalMovementEnabled() ? 8 : 4))
+    {
+        this->compute(generator, this->g_goals);
+        return;
+    }
+    if (!this->isInside(coord))
+    {
+        return;
+    }
+
+    this->g_openHeap.clear();
+
+    if (generator.detectCollision(coord))
+    {
+        if (this->g_costs.get(coord) == FGE_FLOWFIELD_NO_COST)
+        {
+            return;
+        }
+
+        //Invalidate every cell whose path crossed the new collision
+        this->g_openList.clear();
+        this->g_costs.get(coord) = FGE_FLOWFIELD_NO_COST;
+        this->g_directions.get(coord) = FGE_FLOWFIELD_NO_DIRECTION;
+        this->g_openList.push_back(this->getIndex(coord));
+
+        for (std::size_t i=0; i<this->g_openList.size(); ++i)
+        {
+            const fge::AStar::Vector2i current = this->getCoord(this->g_openList[i]);
+            for (std::size_t d=0; d<this->g_directionsCount; ++d)
+            {
+                const fge::AStar::Vector2i neighbor = current + FlowDirections[d];
+                if (!this->isInside(neighbor) || this->g_directions.get(neighbor) != GetOppositeDirection(d))
+                {
+                    continue;
+                }
+                this->g_costs.get(neighbor) = FGE_FLOWFIELD_NO_COST;
+                this->g_directions.get(neighbor) = FGE_FLOWFIELD_NO_DIRECTION;
+                this->g_openList.push_back(this->getIndex(neighbor));
+            }
+        }
+
+        //Seed them back from their valid neighbors
+        for (uint32_t index : this->g_openList)
+        {
+            this->relax(this->getCoord(index), generator);
+        }
+    }
+    else if (this->isGoal(coord))
+    {
+        this->g_costs.get(coord) = 0;
+        this->g_directions.get(coord) = FGE_FLOWFIELD_NO_DIRECTION;
+        this->g_openHeap.push_back({0, this->getIndex(coord)});
+    }
+    else
+    {
+        this->relax(coord, generator);
+    }
+
+    this->propagate(generator);
+}
+
+bool FlowField::getNextStep(fge::AStar::Vector2i coord, fge::AStar::Vector2i& next) const
+{
+    if (!this->isInside(coord))
+    {
+        return false;
+    }
+    const uint8_t direction = this->g_directions.get(coord);
+    if (direction == FGE_FLOWFIELD_NO_DIRECTION)
+    {
+        return false;
+    }
+    next = coord + FlowDirections[direction];
+    return true;
+}
+fge::AStar::Vector2i FlowField::getDirection(fge::AStar::Vector2i coord) const
+{
+    if (!this->isInside(coord))
+    {
+        return {0, 0};
+    }
+    const uint8_t direction = this->g_directions.get(coord);
+    return direction == FGE_FLOWFIELD_NO_DIRECTION ? fge::AStar::Vector2i{0, 0} : FlowDirections[direction];
+}
+uint32_t FlowField::getCost(fge::AStar::Vector2i coord) const
+{
+    return this->isInside(coord) ? this->g_costs.get(coord) : FGE_FLOWFIELD_NO_COST;
+}
+fge::AStar::CoordinateList FlowField::getPath(fge::AStar::Vector2i source) const
+{
+    fge::AStar::CoordinateList path;
+    if (this->getCost(source) == FGE_FLOWFIELD_NO_COST)
+    {
+        return path;
+    }
+
+    path.push_back(source);
+    fge::AStar::Vector2i next;
+    while (this->getNextStep(path.back(), next))
+    {
+        path.push_back(next);
+    }
+    return path;
+}
+
+const fge::AStar::CoordinateList& FlowField::getGoals() const
+{
+    return this->g_goals;
+}
+const fge::Matrix<uint32_t>& FlowField::getCosts() const
+{
+    return this->g_costs;
+}
+const fge::Matrix<uint8_t>& FlowField::getDirections() const
+{
+    return this->g_directions;
+}
+
+bool FlowField::isInside(fge::AStar::Vector2i coord) const
+{
+    return coord.x >= 0 && coord.x < this->g_worldSize.x &&
+           coord.y >= 0 && coord.y < this->g_worldSize.y;
+}
+uint32_t FlowField::getIndex(fge::AStar::Vector2i coord) const
+{
+    return static_cast<uint32_t>(coord.y) * static_cast<uint32_t>(this->g_worldSize.x) + static_cast<uint32_t>(coord.x);
+}
+fge::AStar::Vector2i FlowField::getCoord(uint32_t index) const
+{
+    return {static_cast<int32_t>(index % static_cast<uint32_t>(this->g_worldSize.x)),
+            static_cast<int32_t>(index / static_cast<uint32_t>(this->g_worldSize.x))};
+}
+bool FlowField::isGoal(fge::AStar::Vector2i coord) const
+{
+    return std::find(this->g_goals.begin(), this->g_goals.end(), coord) != this->g_goals.end();
+}
+
+void FlowField::relax(fge::AStar::Vector2i coord, const fge::AStar::Generator& generator)
+{
+    if (generator.detectCollision(coord))
+    {
+        return;
+    }
+
+    uint32_t& cost = this->g_costs.get(coord);
+    for (std::size_t d=0; d<this->g_directionsCount; ++d)
+    {
+        const fge::AStar::Vector2i neighbor = coord + FlowDirections[d];
+        if (!this->isInside(neighbor))
+        {
+            continue;
+        }
+        const uint32_t neighborCost = this->g_costs.get(neighbor);
+        if (neighborCost == FGE_FLOWFIELD_NO_COST)
+        {
+            continue;
+        }
+
+        const uint32_t newCost = neighborCost + (d < 4 ? FGE_FLOWFIELD_STRAIGHT_COST : FGE_FLOWFIELD_DIAGONAL_COST);
+        if (newCost < cost)
+        {
+            cost = newCost;
+            this->g_directions.get(coord) = static_cast<uint8_t>(d);
+        }
+    }
+
+    if (cost != FGE_FLOWFIELD_NO_COST)
+    {
+        this->g_openHeap.push_back({cost, this->getIndex(coord)});
+        std::push_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+    }
+}
+void FlowField::propagate(const fge::AStar::Generator& generator)
+{
+    while (!this->g_openHeap.empty())
+    {
+        std::pop_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+        const HeapEntry entry = this->g_openHeap.back();
+        this->g_openHeap.pop_back();
+
+        const fge::AStar::Vector2i current = this->getCoord(entry._index);
+        if (entry._cost != this->g_costs.get(current))
+        {//Outdated entry
+            continue;
+        }
+
+        for (std::size_t d=0; d<this->g_directionsCount; ++d)
+        {
+            const fge::AStar::Vector2i neighbor = current + FlowDirections[d];
+            if (generator.detectCollision(neighbor))
+            {
+                continue;
+            }
+
+            const uint32_t newCost = entry._cost + (d < 4 ? FGE_FLOWFIELD_STRAIGHT_COST : FGE_FLOWFIELD_DIAGONAL_COST);
+            uint32_t& neighborCost = this->g_costs.get(neighbor);
+            if (newCost < neighborCost)
+            {
+                neighborCost = newCost;
+                this->g_directions.get(neighbor) = GetOppositeDirection(d);
+                this->g_openHeap.push_back({newCost, this->getIndex(neighbor)});
+                std::push_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+            }
+        }
+    }
+}
+
+}//end fge::AStar
@@ -16,27 +16,39 @@
 
 #include "FastEngine/extra/extra_pathFinding.hpp"
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
+#include <limits>
+
+#define FGE_ASTAR_NO_TARGET std::numeric_limits<uint32_t>::max()
+#define FGE_ASTAR_NO_COST std::numeric_limits<uint32_t>::max()
+#define FGE_ASTAR_STRAIGHT_COST 10
+#define FGE_ASTAR_DIAGONAL_COST 14
+#define FGE_ASTAR_ENTRANCE_SPLIT_LENGTH 6
+#define FGE_ASTAR_MAX_COLLISION_CHANGES 4096
 
 using namespace std::placeholders;
 
 namespace fge::AStar
 {
 
-Node::Node(fge::AStar::Vector2i coord, Node* parent) :
-        _g(0),
-        _h(0),
-        _coord(coord),
-        _parent(parent)
+namespace
 {
-}
 
-unsigned int Node::getScore() const
+std::atomic<uint64_t> _collisionEpochs{0};
+
+//Min heap on the score, ties are broken with the lowest heuristic
+template<class THeapEntry>
+bool HeapCompareFunction(const THeapEntry& left, const THeapEntry& right)
 {
-    return this->_g + this->_h;
+    return left._score > right._score || (left._score == right._score && left._h > right._h);
 }
 
+}//end
+
 Generator::Generator() :
+        g_collisionEpoch(++_collisionEpochs),
         g_directions({{
             {0, 1}, {1, 0}, {0, -1}, {-1, 0},
             {-1, -1}, {1, 1}, {-1, 1}, {1, -1}
@@ -48,7 +60,31 @@ Generator::Generator() :
 
 void Generator::setWorldSize(fge::AStar::Vector2i worldSize)
 {
-    this->g_worldSize = worldSize;
+    worldSize.x = std::max(worldSize.x, 0);
+    worldSize.y = std::max(worldSize.y, 0);
+
+    const std::size_t cellCount = static_cast<std::size_t>(worldSize.x) * static_cast<std::size_t>(worldSize.y);
+    std::vector<uint64_t> walls((cellCount+63)/64, 0);
+
+    //Keep the collisions inside the new size
+    const int32_t minX = std::min(worldSize.x, this->g_worldSize.x);
+    const int32_t minY = std::min(worldSize.y, this->g_worldSize.y);
+    for (int32_t y=0; y<minY; ++y)
+    {
+        for (int32_t x=0; x<minX; ++x)
+        {
+            if (this->detectCollision({x,y}))
+            {
+                const std::size_t index = static_cast<std::size_t>(y) * static_cast<std::size_t>(worldSize.x) + static_cast<std::size_t>(x);
+                walls[index/64] |= uint64_t{1} << (index%64);
+            }
+        }
+    }
+
+    this->g_walls = std::make_shared<std::vector<uint64_t> >(std::move(walls));
+    this->g_wallsOwned = true;
+    this->resetCollisionChanges();
+    this->resetNodes(worldSize);
 }
 const fge::AStar::Vector2i& Generator::getWorldSize() const
 {
@@ -58,6 +94,11 @@ const fge::AStar::Vector2i& Generator::getWorldSize() const
 void Generator::setDiagonalMovement(bool enable)
 {
     this->g_directionsCount = enable ? 8 : 4;
+    this->g_hierarchyDirty = true;
+}
+bool Generator::isDiagonalMovementEnabled() const
+{
+    return this->g_directionsCount == 8;
 }
 
 void Generator::setHeuristic(HeuristicFunction heuristic)
@@ -67,128 +108,998 @@ void Generator::setHeuristic(HeuristicFunction heuristic)
 
 void Generator::addCollision(fge::AStar::Vector2i coord)
 {
-    this->g_walls.insert(coord);
+    if (this->isInside(coord))
+    {
+        const std::size_t index = this->getIndex(coord);
+        this->getWritableWalls()[index/64] |= uint64_t{1} << (index%64);
+        this->recordCollisionChange(index);
+        this->invalidateHierarchy(coord);
+    }
 }
 
 void Generator::removeCollision(fge::AStar::Vector2i coord)
 {
-    this->g_walls.erase(coord);
+    if (this->isInside(coord))
+    {
+        const std::size_t index = this->getIndex(coord);
+        this->getWritableWalls()[index/64] &=~ (uint64_t{1} << (index%64));
+        this->recordCollisionChange(index);
+        this->invalidateHierarchy(coord);
+    }
+}
+
+void Generator::setCollision(fge::AStar::Vector2i coord, bool solid)
+{
+    if (solid)
+    {
+        this->addCollision(coord);
+    }
+    else
+    {
+        this->removeCollision(coord);
+    }
 }
 
 void Generator::clearCollisions()
 {
-    this->g_walls.clear();
+    auto& walls = this->getWritableWalls();
+    std::fill(walls.begin(), walls.end(), 0);
+    this->resetCollisionChanges();
+    this->g_hierarchyDirty = true;
 }
 
-CoordinateList Generator::findPath(fge::AStar::Vector2i source, fge::AStar::Vector2i target)
+void Generator::shareCollisions(const fge::AStar::Generator& generator)
 {
-    Node* current = nullptr;
-    NodeList openNodes;
-    NodeList closeNodes;
+    if (this->g_worldSize != generator.g_worldSize)
+    {
+        this->resetNodes(generator.g_worldSize);
+    }
 
-    openNodes.reserve(100);
-    closeNodes.reserve(100);
-    openNodes.push_back(new Node(source));
+    if (this->g_directionsCount != generator.g_directionsCount || this->g_clusterSize != generator.g_clusterSize)
+    {
+        this->g_directionsCount = generator.g_directionsCount;
+        this->g_clusterSize = generator.g_clusterSize;
+        this->g_hierarchyDirty = true;
+    }
 
-    bool validPath = false;
+    //Modified collisions are always copied first, so the same pointer mean the same collisions
+    if (this->g_walls != generator.g_walls)
+    {
+        this->g_walls = generator.g_walls;
+        this->g_wallsOwned = generator.g_wallsOwned;
+
+        //Same history, only the cells changed since the last share are invalidated
+        const uint64_t missingChanges = generator.g_collisionVersion - this->g_collisionVersion;
+        if (this->g_collisionEpoch == generator.g_collisionEpoch &&
+            generator.g_collisionVersion >= this->g_collisionVersion &&
+            missingChanges <= generator.g_collisionChanges.size())
+        {
+            for (auto it = generator.g_collisionChanges.end()-static_cast<std::ptrdiff_t>(missingChanges);
+                 it != generator.g_collisionChanges.end(); ++it)
+            {
+                this->invalidateHierarchy(this->getCoord(*it));
+            }
+        }
+        else
+        {
+            this->g_hierarchyDirty = true;
+        }
+    }
+    this->g_collisionEpoch = generator.g_collisionEpoch;
+    this->g_collisionVersion = generator.g_collisionVersion;
+    this->g_collisionHistoryOwned = false;
+
+    this->g_heuristic = generator.g_heuristic;
+    this->g_strategy = generator.g_strategy;
+}
+
+void Generator::setCollisions(fge::AStar::Vector2i worldSize, std::shared_ptr<const std::vector<uint64_t> > collisions)
+{
+    worldSize.x = std::max(worldSize.x, 0);
+    worldSize.y = std::max(worldSize.y, 0);
+
+    const std::size_t cellCount = static_cast<std::size_t>(worldSize.x) * static_cast<std::size_t>(worldSize.y);
+    if (!collisions || collisions->size() < (cellCount+63)/64)
+    {
+        return;
+    }
 
-    while (!openNodes.empty())
+    if (this->g_walls == collisions)
     {
-        auto itCurrent = openNodes.begin();
-        current = *itCurrent;
+        return;
+    }
 
-        for (auto it = ++openNodes.begin(); it != openNodes.end(); ++it)
+    if (this->g_worldSize != worldSize)
+    {
+        this->resetNodes(worldSize);
+        this->resetCollisionChanges();
+    }
+    else
+    {//Only the changed cells are invalidated
+        const auto& walls = *this->g_walls;
+        for (std::size_t word=0; word<(cellCount+63)/64; ++word)
         {
-            auto* node = *it;
-            if (node->getScore() <= current->getScore())
+            uint64_t changes = walls[word] ^ (*collisions)[word];
+            if (word == cellCount/64)
+            {//Ignore the bits after the last cell
+                changes &= (uint64_t{1} << (cellCount%64)) - 1;
+            }
+
+            while (changes != 0)
             {
-                current = node;
-                itCurrent = it;
+                const std::size_t index = word*64 + static_cast<std::size_t>(std::countr_zero(changes));
+                this->recordCollisionChange(index);
+                this->invalidateHierarchy(this->getCoord(static_cast<uint32_t>(index)));
+                changes &= changes-1;
             }
         }
+    }
+
+    this->g_walls = std::move(collisions);
+    this->g_wallsOwned = false;
+}
+
+CoordinateList Generator::findPath(fge::AStar::Vector2i source, fge::AStar::Vector2i target)
+{
+    if (!this->isInside(source) || this->detectCollision(target))
+    {
+        return {};
+    }
 
-        if (current->_coord == target)
+    switch (this->g_strategy)
+    {
+    case Strategies::STRATEGY_JUMP_POINT:
+        if (this->g_directionsCount == 8)
         {
-            validPath = true;
-            break;
+            return this->findPathJumpPoint(source, target);
         }
+        break;
+    case Strategies::STRATEGY_HIERARCHICAL:
+        return this->findPathHierarchical(source, target);
+    default:
+        break;
+    }
 
-        closeNodes.push_back(current);
-        openNodes.erase(itCurrent);
+    const auto sourceIndex = static_cast<uint32_t>(this->getIndex(source));
+    const auto targetIndex = static_cast<uint32_t>(this->getIndex(target));
+    if ( !this->search(sourceIndex, targetIndex, this->getWorldBounds()) )
+    {
+        return {};
+    }
+    return this->buildPath(sourceIndex, targetIndex);
+}
+
+bool Generator::detectCollision(fge::AStar::Vector2i coord) const
+{
+    if (!this->isInside(coord))
+    {
+        return true;
+    }
+    const std::size_t index = this->getIndex(coord);
+    return ((*this->g_walls)[index/64] >> (index%64)) & 1;
+}
+
+void Generator::setStrategy(fge::AStar::Generator::Strategies strategy)
+{
+    this->g_strategy = strategy;
+}
+fge::AStar::Generator::Strategies Generator::getStrategy() const
+{
+    return this->g_strategy;
+}
+
+void Generator::setClusterSize(int32_t size)
+{
+    size = std::max(size, 4);
+    if (size != this->g_clusterSize)
+    {
+        this->g_clusterSize = size;
+        this->g_hierarchyDirty = true;
+    }
+}
+int32_t Generator::getClusterSize() const
+{
+    return this->g_clusterSize;
+}
+
+std::vector<uint64_t>& Generator::getWritableWalls()
+{
+    if (!this->g_wallsOwned || this->g_walls.use_count() > 1)
+    {//Provided by the caller or shared with another owner, we need our own copy
+        auto walls = std::make_shared<std::vector<uint64_t> >(*this->g_walls);
+        this->g_walls = walls;
+        this->g_wallsOwned = true;
+        return *walls;
+    }
+    //Our bitmaps are created non-const, the const is only here to prevent writes while shared
+    return const_cast<std::vector<uint64_t>&>(*this->g_walls);
+}
+void Generator::recordCollisionChange(std::size_t index)
+{
+    if (!this->g_collisionHistoryOwned)
+    {//This generator doesn't follow the shared one anymore
+        this->resetCollisionChanges();
+    }
+
+    if (this->g_collisionChanges.size() >= FGE_ASTAR_MAX_COLLISION_CHANGES)
+    {//Generators that are too late will rebuild everything
+        this->g_collisionChanges.erase(this->g_collisionChanges.begin(),
+                                       this->g_collisionChanges.begin()+FGE_ASTAR_MAX_COLLISION_CHANGES/2);
+    }
+    this->g_collisionChanges.push_back(static_cast<uint32_t>(index));
+    ++this->g_collisionVersion;
+}
+void Generator::resetCollisionChanges()
+{
+    this->g_collisionEpoch = ++_collisionEpochs;
+    this->g_collisionVersion = 0;
+    this->g_collisionChanges.clear();
+    this->g_collisionHistoryOwned = true;
+}
+void Generator::resetNodes(fge::AStar::Vector2i worldSize)
+{
+    this->g_worldSize = worldSize;
+    this->g_nodes.clear();
+    this->g_nodes.resize(static_cast<std::size_t>(worldSize.x) * static_cast<std::size_t>(worldSize.y));
+    this->g_generation = 0;
+    this->g_hierarchyDirty = true;
+}
+
+bool Generator::isInside(fge::AStar::Vector2i coord) const
+{
+    return coord.x >= 0 && coord.x < this->g_worldSize.x &&
+           coord.y >= 0 && coord.y < this->g_worldSize.y;
+}
+bool Generator::isInside(fge::AStar::Vector2i coord, const Bounds& bounds)
+{
+    return coord.x >= bounds._left && coord.x < bounds._right &&
+           coord.y >= bounds._top && coord.y < bounds._bottom;
+}
+std::size_t Generator::getIndex(fge::AStar::Vector2i coord) const
+{
+    return static_cast<std::size_t>(coord.y) * static_cast<std::size_t>(this->g_worldSize.x) + static_cast<std::size_t>(coord.x);
+}
+fge::AStar::Vector2i Generator::getCoord(uint32_t index) const
+{
+    const auto worldWidth = static_cast<uint32_t>(this->g_worldSize.x);
+    return {static_cast<int32_t>(index % worldWidth), static_cast<int32_t>(index / worldWidth)};
+}
+Generator::Bounds Generator::getWorldBounds() const
+{
+    return {0, 0, this->g_worldSize.x, this->g_worldSize.y};
+}
+
+uint32_t Generator::nextGeneration()
+{
+    //A new generation invalidate all the nodes of the previous search
+    if (++this->g_generation == 0)
+    {
+        for (auto& node : this->g_nodes)
+        {
+            node._generation = 0;
+        }
+        this->g_generation = 1;
+    }
+    return this->g_generation;
+}
+
+bool Generator::search(uint32_t source, uint32_t target, const Bounds& bounds)
+{
+    const uint32_t generation = this->nextGeneration();
+    const bool hasTarget = target != FGE_ASTAR_NO_TARGET;
+    const fge::AStar::Vector2i targetCoord = hasTarget ? this->getCoord(target) : fge::AStar::Vector2i{};
+
+    this->g_openHeap.clear();
+
+    auto& sourceNode = this->g_nodes[source];
+    sourceNode._g = 0;
+    sourceNode._parent = source;
+    sourceNode._generation = generation;
+    sourceNode._closed = false;
+
+    const uint32_t sourceH = hasTarget ? this->g_heuristic(this->getCoord(source), targetCoord) : 0;
+    this->g_openHeap.push_back({sourceH, sourceH, source});
+
+    while (!this->g_openHeap.empty())
+    {
+        std::pop_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+        const HeapEntry entry = this->g_openHeap.back();
+        this->g_openHeap.pop_back();
+
+        auto& current = this->g_nodes[entry._index];
+        //Outdated entry, the node was already closed with a better cost
+        if (current._closed)
+        {
+            continue;
+        }
+
+        if (entry._index == target)
+        {
+            return true;
+        }
+
+        current._closed = true;
+
+        const fge::AStar::Vector2i currentCoord = this->getCoord(entry._index);
 
         for (std::size_t i = 0; i < this->g_directionsCount; ++i)
         {
-            fge::AStar::Vector2i newCoordinates{current->_coord + this->g_directions[i]};
-            if (this->detectCollision(newCoordinates) ||
-                this->findNodeOnList(closeNodes, newCoordinates) != nullptr)
+            const fge::AStar::Vector2i newCoordinates{currentCoord + this->g_directions[i]};
+            if (!Generator::isInside(newCoordinates, bounds) || this->detectCollision(newCoordinates))
             {
                 continue;
             }
 
-            unsigned int totalCost = current->_g + ((i < 4) ? 10 : 14);
+            const auto successorIndex = static_cast<uint32_t>(this->getIndex(newCoordinates));
+            auto& successor = this->g_nodes[successorIndex];
 
-            Node* successor = findNodeOnList(openNodes, newCoordinates);
-            if (successor == nullptr)
+            const uint32_t totalCost = current._g + ((i < 4) ? FGE_ASTAR_STRAIGHT_COST : FGE_ASTAR_DIAGONAL_COST);
+
+            if (successor._generation != generation)
             {
-                successor = new Node(newCoordinates, current);
-                successor->_g = totalCost;
-                successor->_h = g_heuristic(successor->_coord, target);
-                openNodes.push_back(successor);
+                successor._generation = generation;
+                successor._closed = false;
             }
-            else if (totalCost < successor->_g)
+            else if (successor._closed || totalCost >= successor._g)
             {
-                successor->_parent = current;
-                successor->_g = totalCost;
+                continue;
             }
+
+            successor._g = totalCost;
+            successor._parent = entry._index;
+
+            const uint32_t h = hasTarget ? this->g_heuristic(newCoordinates, targetCoord) : 0;
+            this->g_openHeap.push_back({totalCost + h, h, successorIndex});
+            std::push_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
         }
     }
 
+    return false;
+}
+
+CoordinateList Generator::buildPath(uint32_t source, uint32_t target) const
+{
+    //Parents can be far away (jump points), intermediate cells are added on the straight/diagonal line
     CoordinateList path;
+    uint32_t index = target;
+    fge::AStar::Vector2i coord = this->getCoord(index);
+    path.push_back(coord);
 
-    if (validPath)
+    while (index != source)
     {
-        while (current != nullptr)
+        index = this->g_nodes[index]._parent;
+        const fge::AStar::Vector2i parentCoord = this->getCoord(index);
+        const fge::AStar::Vector2i step{(parentCoord.x > coord.x) - (parentCoord.x < coord.x),
+                                        (parentCoord.y > coord.y) - (parentCoord.y < coord.y)};
+        while (coord != parentCoord)
         {
-            path.push_back(current->_coord);
-            current = current->_parent;
+            coord += step;
+            path.push_back(coord);
         }
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+//Jump Point Search
+
+CoordinateList Generator::findPathJumpPoint(fge::AStar::Vector2i source, fge::AStar::Vector2i target)
+{
+    const uint32_t generation = this->nextGeneration();
+    const auto sourceIndex = static_cast<uint32_t>(this->getIndex(source));
+    const auto targetIndex = static_cast<uint32_t>(this->getIndex(target));
+
+    this->g_openHeap.clear();
+
+    auto& sourceNode = this->g_nodes[sourceIndex];
+    sourceNode._g = 0;
+    sourceNode._parent = sourceIndex;
+    sourceNode._generation = generation;
+    sourceNode._closed = false;
+
+    const uint32_t sourceH = this->g_heuristic(source, target);
+    this->g_openHeap.push_back({sourceH, sourceH, sourceIndex});
+
+    std::array<fge::AStar::Vector2i, 8> directions{};
+
+    while (!this->g_openHeap.empty())
+    {
+        std::pop_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+        const HeapEntry entry = this->g_openHeap.back();
+        this->g_openHeap.pop_back();
+
+        auto& current = this->g_nodes[entry._index];
+        if (current._closed)
+        {
+            continue;
+        }
+
+        if (entry._index == targetIndex)
+        {
+            return this->buildPath(sourceIndex, targetIndex);
+        }
+
+        current._closed = true;
+
+        const fge::AStar::Vector2i coord = this->getCoord(entry._index);
+
+        //Pruned neighbors, depending on the direction we come from
+        std::size_t directionsCount = 0;
+        if (entry._index == sourceIndex)
+        {
+            directions = this->g_directions;
+            directionsCount = 8;
+        }
+        else
+        {
+            const fge::AStar::Vector2i parentCoord = this->getCoord(current._parent);
+            const int32_t dx = (coord.x > parentCoord.x) - (coord.x < parentCoord.x);
+            const int32_t dy = (coord.y > parentCoord.y) - (coord.y < parentCoord.y);
+
+            if (dx != 0 && dy != 0)
+            {
+                directions[directionsCount++] = {dx, 0};
+                directions[directionsCount++] = {0, dy};
+                directions[directionsCount++] = {dx, dy};
+                if (this->detectCollision({coord.x-dx, coord.y}))
+                {
+                    directions[directionsCount++] = {-dx, dy};
+                }
+                if (this->detectCollision({coord.x, coord.y-dy}))
+                {
+                    directions[directionsCount++] = {dx, -dy};
+                }
+            }
+            else if (dx != 0)
+            {
+                directions[directionsCount++] = {dx, 0};
+                if (this->detectCollision({coord.x, coord.y+1}))
+                {
+                    directions[directionsCount++] = {dx, 1};
+                }
+                if (this->detectCollision({coord.x, coord.y-1}))
+                {
+                    directions[directionsCount++] = {dx, -1};
+                }
+            }
+            else
+            {
+                directions[directionsCount++] = {0, dy};
+                if (this->detectCollision({coord.x+1, coord.y}))
+                {
+                    directions[directionsCount++] = {1, dy};
+                }
+                if (this->detectCollision({coord.x-1, coord.y}))
+                {
+                    directions[directionsCount++] = {-1, dy};
+                }
+            }
+        }
+
+        for (std::size_t i=0; i<directionsCount; ++i)
+        {
+            fge::AStar::Vector2i jumpPoint;
+            if ( !this->jump(coord, directions[i], target, jumpPoint) )
+            {
+                continue;
+            }
+
+            const auto successorIndex = static_cast<uint32_t>(this->getIndex(jumpPoint));
+            auto& successor = this->g_nodes[successorIndex];
+
+            const uint32_t totalCost = current._g + Heuristic::octagonal(coord, jumpPoint);
+
+            if (successor._generation != generation)
+            {
+                successor._generation = generation;
+                successor._closed = false;
+            }
+            else if (successor._closed || totalCost >= successor._g)
+            {
+                continue;
+            }
+
+            successor._g = totalCost;
+            successor._parent = entry._index;
 
-        std::reverse(path.begin(), path.end());
+            const uint32_t h = this->g_heuristic(jumpPoint, target);
+            this->g_openHeap.push_back({totalCost + h, h, successorIndex});
+            std::push_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+        }
     }
 
-    this->releaseNodes(openNodes);
-    this->releaseNodes(closeNodes);
+    return {};
+}
+
+bool Generator::jump(fge::AStar::Vector2i coord, fge::AStar::Vector2i direction, fge::AStar::Vector2i target, fge::AStar::Vector2i& jumpPoint) const
+{
+    const int32_t dx = direction.x;
+    const int32_t dy = direction.y;
+
+    while (true)
+    {
+        coord += direction;
+        if (this->detectCollision(coord))
+        {
+            return false;
+        }
+        if (coord == target)
+        {
+            jumpPoint = coord;
+            return true;
+        }
+
+        //Check for forced neighbors
+        if (dx != 0 && dy != 0)
+        {
+            if ((this->detectCollision({coord.x-dx, coord.y}) && !this->detectCollision({coord.x-dx, coord.y+dy})) ||
+                (this->detectCollision({coord.x, coord.y-dy}) && !this->detectCollision({coord.x+dx, coord.y-dy})))
+            {
+                jumpPoint = coord;
+                return true;
+            }
+
+            //A diagonal move stop when a straight jump find something
+            fge::AStar::Vector2i straightJumpPoint;
+            if (this->jump(coord, {dx, 0}, target, straightJumpPoint) ||
+                this->jump(coord, {0, dy}, target, straightJumpPoint))
+            {
+                jumpPoint = coord;
+                return true;
+            }
+        }
+        else if (dx != 0)
+        {
+            if ((this->detectCollision({coord.x, coord.y+1}) && !this->detectCollision({coord.x+dx, coord.y+1})) ||
+                (this->detectCollision({coord.x, coord.y-1}) && !this->detectCollision({coord.x+dx, coord.y-1})))
+            {
+                jumpPoint = coord;
+                return true;
+            }
+        }
+        else
+        {
+            if ((this->detectCollision({coord.x+1, coord.y}) && !this->detectCollision({coord.x+1, coord.y+dy})) ||
+                (this->detectCollision({coord.x-1, coord.y}) && !this->detectCollision({coord.x-1, coord.y+dy})))
+            {
+                jumpPoint = coord;
+                return true;
+            }
+        }
+    }
+}
+
+//Hierarchical
+
+CoordinateList Generator::findPathHierarchical(fge::AStar::Vector2i source, fge::AStar::Vector2i target)
+{
+    this->updateHierarchy();
+
+    const auto sourceIndex = static_cast<uint32_t>(this->getIndex(source));
+    const auto targetIndex = static_cast<uint32_t>(this->getIndex(target));
+    const std::size_t sourceCluster = this->getClusterIndex(sourceIndex);
+    const std::size_t targetCluster = this->getClusterIndex(targetIndex);
+
+    //Inside the same cluster, a local search is often enough
+    if (sourceCluster == targetCluster && this->search(sourceIndex, targetIndex, this->getClusterBounds(sourceCluster)))
+    {
+        return this->buildPath(sourceIndex, targetIndex);
+    }
+
+    //Costs from the source/target to their cluster transitions
+    const Cluster& sourceData = this->g_clusters[sourceCluster];
+    const Cluster& targetData = this->g_clusters[targetCluster];
+    std::vector<uint32_t> sourceCosts(sourceData._transitions.size());
+    std::vector<uint32_t> targetCosts(targetData._transitions.size());
+    this->computeCosts(sourceIndex, this->getClusterBounds(sourceCluster), sourceData._transitions, sourceCosts.data());
+    this->computeCosts(targetIndex, this->getClusterBounds(targetCluster), targetData._transitions, targetCosts.data());
+
+    //Search on the abstract graph, nodes are the transitions cells
+    const uint32_t generation = this->nextGeneration();
+    this->g_openHeap.clear();
+
+    auto& sourceNode = this->g_nodes[sourceIndex];
+    sourceNode._g = 0;
+    sourceNode._parent = sourceIndex;
+    sourceNode._generation = generation;
+    sourceNode._closed = false;
+
+    const uint32_t sourceH = this->g_heuristic(source, target);
+    this->g_openHeap.push_back({sourceH, sourceH, sourceIndex});
+
+    auto relax = [&](uint32_t from, uint32_t to, uint32_t cost){
+        auto& node = this->g_nodes[to];
+        const uint32_t totalCost = this->g_nodes[from]._g + cost;
+        if (node._generation != generation)
+        {
+            node._generation = generation;
+            node._closed = false;
+        }
+        else if (node._closed || totalCost >= node._g)
+        {
+            return;
+        }
+        node._g = totalCost;
+        node._parent = from;
+
+        const uint32_t h = this->g_heuristic(this->getCoord(to), target);
+        this->g_openHeap.push_back({totalCost + h, h, to});
+        std::push_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+    };
+
+    bool validPath = false;
+    while (!this->g_openHeap.empty())
+    {
+        std::pop_heap(this->g_openHeap.begin(), this->g_openHeap.end(), HeapCompareFunction<HeapEntry>);
+        const HeapEntry entry = this->g_openHeap.back();
+        this->g_openHeap.pop_back();
+
+        auto& current = this->g_nodes[entry._index];
+        if (current._closed)
+        {
+            continue;
+        }
+        if (entry._index == targetIndex)
+        {
+            validPath = true;
+            break;
+        }
+        current._closed = true;
+
+        if (entry._index == sourceIndex)
+        {
+            for (std::size_t i=0; i<sourceData._transitions.size(); ++i)
+            {
+                if (sourceCosts[i] != FGE_ASTAR_NO_COST)
+                {
+                    relax(entry._index, sourceData._transitions[i], sourceCosts[i]);
+                }
+            }
+        }
+
+        const std::size_t clusterIndex = this->getClusterIndex(entry._index);
+        const Cluster& cluster = this->g_clusters[clusterIndex];
+        const auto it = std::find(cluster._transitions.begin(), cluster._transitions.end(), entry._index);
+        if (it == cluster._transitions.end())
+        {
+            continue;
+        }
+        const auto position = static_cast<std::size_t>(it - cluster._transitions.begin());
+        const std::size_t transitionCount = cluster._transitions.size();
+
+        for (std::size_t i=0; i<transitionCount; ++i)
+        {
+            const uint32_t cost = cluster._costs[position*transitionCount + i];
+            if (i != position && cost != FGE_ASTAR_NO_COST)
+            {
+                relax(entry._index, cluster._transitions[i], cost);
+            }
+        }
+        const fge::AStar::Vector2i coord = this->getCoord(entry._index);
+        for (uint32_t link : cluster._links[position])
+        {
+            const fge::AStar::Vector2i linkCoord = this->getCoord(link);
+            relax(entry._index, link, (linkCoord.x != coord.x && linkCoord.y != coord.y) ? FGE_ASTAR_DIAGONAL_COST : FGE_ASTAR_STRAIGHT_COST);
+        }
+        if (clusterIndex == targetCluster && targetCosts[position] != FGE_ASTAR_NO_COST)
+        {
+            relax(entry._index, targetIndex, targetCosts[position]);
+        }
+    }
+
+    if (!validPath)
+    {
+        return {};
+    }
+
+    std::vector<uint32_t> abstractPath;
+    for (uint32_t index = targetIndex; index != sourceIndex; index = this->g_nodes[index]._parent)
+    {
+        abstractPath.push_back(index);
+    }
+    abstractPath.push_back(sourceIndex);
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    //Refine every abstract edge, links are neighbor cells and others are inside a cluster
+    CoordinateList path{source};
+    for (std::size_t i=1; i<abstractPath.size(); ++i)
+    {
+        const uint32_t from = abstractPath[i-1];
+        const uint32_t to = abstractPath[i];
+        const std::size_t clusterIndex = this->getClusterIndex(from);
+
+        if (clusterIndex != this->getClusterIndex(to))
+        {
+            path.push_back(this->getCoord(to));
+            continue;
+        }
+
+        if ( !this->search(from, to, this->getClusterBounds(clusterIndex)) )
+        {//Should not happen as costs are up to date
+            return {};
+        }
+        const CoordinateList subPath = this->buildPath(from, to);
+        path.insert(path.end(), subPath.begin()+1, subPath.end());
+    }
 
     return path;
 }
 
-Node* Generator::findNodeOnList(const NodeList& nodes, fge::AStar::Vector2i coord) const
+void Generator::invalidateHierarchy(fge::AStar::Vector2i coord)
+{
+    if (this->g_hierarchyDirty)
+    {
+        return;
+    }
+
+    const int32_t clusterX = coord.x / this->g_clusterSize;
+    const int32_t clusterY = coord.y / this->g_clusterSize;
+    const int32_t localX = coord.x - clusterX*this->g_clusterSize;
+    const int32_t localY = coord.y - clusterY*this->g_clusterSize;
+    const auto cluster = static_cast<std::size_t>(clusterY*this->g_clusterCount.x + clusterX);
+
+    this->g_clustersDirty[cluster] = 1;
+
+    //Borders (the left/top one of a cluster have the index of the neighbor cluster)
+    if (localX == 0 && clusterX > 0)
+    {
+        this->g_bordersDirty[0][cluster-1] = 1;
+    }
+    if (localX == this->g_clusterSize-1 && clusterX < this->g_clusterCount.x-1)
+    {
+        this->g_bordersDirty[0][cluster] = 1;
+    }
+    if (localY == 0 && clusterY > 0)
+    {
+        this->g_bordersDirty[1][cluster-static_cast<std::size_t>(this->g_clusterCount.x)] = 1;
+    }
+    if (localY == this->g_clusterSize-1 && clusterY < this->g_clusterCount.y-1)
+    {
+        this->g_bordersDirty[1][cluster] = 1;
+    }
+
+    //Corner cells can change the diagonal links between clusters, all the borders around are rebuilt
+    const bool cornerX = localX == 0 || localX == this->g_clusterSize-1;
+    const bool cornerY = localY == 0 || localY == this->g_clusterSize-1;
+    if (cornerX && cornerY && this->g_directionsCount == 8)
+    {
+        for (int32_t y=std::max(clusterY-1, 0); y<=std::min(clusterY+1, this->g_clusterCount.y-1); ++y)
+        {
+            for (int32_t x=std::max(clusterX-1, 0); x<=std::min(clusterX+1, this->g_clusterCount.x-1); ++x)
+            {
+                const auto neighbor = static_cast<std::size_t>(y*this->g_clusterCount.x + x);
+                this->g_bordersDirty[0][neighbor] = 1;
+                this->g_bordersDirty[1][neighbor] = 1;
+            }
+        }
+    }
+}
+
+void Generator::updateHierarchy()
 {
-    for (auto* node: nodes)
+    if (this->g_hierarchyDirty)
     {
-        if (node->_coord == coord)
+        this->g_clusterCount = {(this->g_worldSize.x + this->g_clusterSize-1) / this->g_clusterSize,
+                                (this->g_worldSize.y + this->g_clusterSize-1) / this->g_clusterSize};
+        const auto clusterCount = static_cast<std::size_t>(this->g_clusterCount.x) * static_cast<std::size_t>(this->g_clusterCount.y);
+
+        this->g_clusters.assign(clusterCount, {});
+        this->g_clustersDirty.assign(clusterCount, 1);
+        for (std::size_t i=0; i<2; ++i)
         {
-            return node;
+            this->g_borders[i].assign(clusterCount, {});
+            this->g_bordersDirty[i].assign(clusterCount, 1);
+        }
+        this->g_hierarchyDirty = false;
+    }
+
+    for (std::size_t i=0; i<2; ++i)
+    {
+        for (std::size_t border=0; border<this->g_bordersDirty[i].size(); ++border)
+        {
+            if (this->g_bordersDirty[i][border] != 0)
+            {
+                this->buildBorder(border, i == 0);
+                this->g_bordersDirty[i][border] = 0;
+            }
+        }
+    }
+
+    for (std::size_t cluster=0; cluster<this->g_clustersDirty.size(); ++cluster)
+    {
+        if (this->g_clustersDirty[cluster] != 0)
+        {
+            this->buildCluster(cluster);
+            this->g_clustersDirty[cluster] = 0;
         }
     }
-    return nullptr;
 }
 
-void Generator::releaseNodes(NodeList& nodes)
+void Generator::buildBorder(std::size_t border, bool vertical)
 {
-    for (auto* node: nodes)
+    auto& pairs = this->g_borders[vertical ? 0 : 1][border];
+    pairs.clear();
+
+    const Bounds bounds = this->getClusterBounds(border);
+    //There is no neighbor cluster
+    if ((vertical && bounds._right >= this->g_worldSize.x) || (!vertical && bounds._bottom >= this->g_worldSize.y))
+    {
+        return;
+    }
+
+    //Clusters around are rebuilt with the new transitions
+    const auto clusterX = static_cast<int32_t>(border % static_cast<std::size_t>(this->g_clusterCount.x));
+    const auto clusterY = static_cast<int32_t>(border / static_cast<std::size_t>(this->g_clusterCount.x));
+    for (int32_t y=std::max(clusterY-1, 0); y<=std::min(clusterY+1, this->g_clusterCount.y-1); ++y)
     {
-        delete node;
+        for (int32_t x=clusterX; x<=std::min(clusterX+1, this->g_clusterCount.x-1); ++x)
+        {
+            this->g_clustersDirty[static_cast<std::size_t>(y*this->g_clusterCount.x + x)] = 1;
+        }
+    }
+
+    const int32_t length = vertical ? (bounds._bottom - bounds._top) : (bounds._right - bounds._left);
+    auto getCells = [&](int32_t i){
+        return vertical ? std::make_pair(fge::AStar::Vector2i{bounds._right-1, bounds._top+i}, fge::AStar::Vector2i{bounds._right, bounds._top+i}) :
+                          std::make_pair(fge::AStar::Vector2i{bounds._left+i, bounds._bottom-1}, fge::AStar::Vector2i{bounds._left+i, bounds._bottom});
+    };
+    auto addPair = [&](int32_t i){
+        const auto cells = getCells(i);
+        pairs.emplace_back(static_cast<uint32_t>(this->getIndex(cells.first)), static_cast<uint32_t>(this->getIndex(cells.second)));
+    };
+
+    //Every free segment is an entrance, long ones have a transition on both ends
+    int32_t start = -1;
+    for (int32_t i=0; i<=length; ++i)
+    {
+        bool free = false;
+        if (i < length)
+        {
+            const auto cells = getCells(i);
+            free = !this->detectCollision(cells.first) && !this->detectCollision(cells.second);
+        }
+
+        if (free && start < 0)
+        {
+            start = i;
+        }
+        else if (!free && start >= 0)
+        {
+            const int32_t end = i-1;
+            if (end-start+1 >= FGE_ASTAR_ENTRANCE_SPLIT_LENGTH)
+            {
+                addPair(start);
+                addPair(end);
+            }
+            else
+            {
+                addPair((start+end)/2);
+            }
+            start = -1;
+        }
+    }
+
+    //With diagonal movement, clusters can also be linked by a diagonal move when no straight entrance is around
+    if (this->g_directionsCount == 8)
+    {
+        auto isFree = [&](int32_t i){
+            const auto cells = getCells(i);
+            return !this->detectCollision(cells.first) && !this->detectCollision(cells.second);
+        };
+        for (int32_t i=0; i<length-1; ++i)
+        {
+            if (isFree(i) || isFree(i+1))
+            {
+                continue;
+            }
+            const auto cells = getCells(i);
+            const auto nextCells = getCells(i+1);
+            if (!this->detectCollision(cells.first) && !this->detectCollision(nextCells.second))
+            {
+                pairs.emplace_back(static_cast<uint32_t>(this->getIndex(cells.first)), static_cast<uint32_t>(this->getIndex(nextCells.second)));
+            }
+            if (!this->detectCollision(nextCells.first) && !this->detectCollision(cells.second))
+            {
+                pairs.emplace_back(static_cast<uint32_t>(this->getIndex(nextCells.first)), static_cast<uint32_t>(this->getIndex(cells.second)));
+            }
+        }
+
+        //Diagonal links with the corner clusters are stored in the vertical borders
+        if (vertical)
+        {
+            auto addCorner = [&](fge::AStar::Vector2i from, fge::AStar::Vector2i to){
+                if (!this->detectCollision(from) && !this->detectCollision(to) &&
+                    this->detectCollision({to.x, from.y}) && this->detectCollision({from.x, to.y}))
+                {
+                    pairs.emplace_back(static_cast<uint32_t>(this->getIndex(from)), static_cast<uint32_t>(this->getIndex(to)));
+                }
+            };
+            addCorner({bounds._right-1, bounds._bottom-1}, {bounds._right, bounds._bottom});
+            addCorner({bounds._right-1, bounds._top}, {bounds._right, bounds._top-1});
+        }
+    }
+}
+
+void Generator::buildCluster(std::size_t cluster)
+{
+    Cluster& data = this->g_clusters[cluster];
+    data._transitions.clear();
+    data._links.clear();
+
+    const auto clusterX = static_cast<int32_t>(cluster % static_cast<std::size_t>(this->g_clusterCount.x));
+    const auto clusterY = static_cast<int32_t>(cluster / static_cast<std::size_t>(this->g_clusterCount.x));
+
+    auto addTransition = [&](uint32_t cell, uint32_t link){
+        auto it = std::find(data._transitions.begin(), data._transitions.end(), cell);
+        if (it == data._transitions.end())
+        {
+            data._transitions.push_back(cell);
+            data._links.emplace_back(1, link);
+        }
+        else
+        {
+            data._links[static_cast<std::size_t>(it - data._transitions.begin())].push_back(link);
+        }
+    };
+
+    //Pairs of the borders around that have a cell inside this cluster
+    for (int32_t y=std::max(clusterY-1, 0); y<=std::min(clusterY+1, this->g_clusterCount.y-1); ++y)
+    {
+        for (int32_t x=std::max(clusterX-1, 0); x<=std::min(clusterX+1, this->g_clusterCount.x-1); ++x)
+        {
+            const auto neighbor = static_cast<std::size_t>(y*this->g_clusterCount.x + x);
+            for (const auto& borders : this->g_borders)
+            {
+                for (const auto& pair : borders[neighbor])
+                {
+                    if (this->getClusterIndex(pair.first) == cluster)
+                    {
+                        addTransition(pair.first, pair.second);
+                    }
+                    else if (this->getClusterIndex(pair.second) == cluster)
+                    {
+                        addTransition(pair.second, pair.first);
+                    }
+                }
+            }
+        }
+    }
+
+    const std::size_t transitionCount = data._transitions.size();
+    data._costs.assign(transitionCount*transitionCount, FGE_ASTAR_NO_COST);
+
+    const Bounds bounds = this->getClusterBounds(cluster);
+    for (std::size_t i=0; i<transitionCount; ++i)
+    {
+        this->computeCosts(data._transitions[i], bounds, data._transitions, data._costs.data() + i*transitionCount);
     }
-    nodes.clear();
 }
 
-bool Generator::detectCollision(fge::AStar::Vector2i coord)
+std::size_t Generator::getClusterIndex(uint32_t index) const
+{
+    const fge::AStar::Vector2i coord = this->getCoord(index);
+    return static_cast<std::size_t>((coord.y / this->g_clusterSize) * this->g_clusterCount.x + coord.x / this->g_clusterSize);
+}
+Generator::Bounds Generator::getClusterBounds(std::size_t cluster) const
 {
-    bool isWall = this->g_walls.find(coord) != this->g_walls.end();
+    const auto clusterX = static_cast<int32_t>(cluster % static_cast<std::size_t>(this->g_clusterCount.x));
+    const auto clusterY = static_cast<int32_t>(cluster / static_cast<std::size_t>(this->g_clusterCount.x));
+    return {clusterX*this->g_clusterSize, clusterY*this->g_clusterSize,
+            std::min((clusterX+1)*this->g_clusterSize, this->g_worldSize.x),
+            std::min((clusterY+1)*this->g_clusterSize, this->g_worldSize.y)};
+}
+
+void Generator::computeCosts(uint32_t source, const Bounds& bounds, const std::vector<uint32_t>& targets, uint32_t* costs)
+{
+    //Dijkstra from the source to every reachable cell of the bounds
+    this->search(source, FGE_ASTAR_NO_TARGET, bounds);
 
-    return isWall || coord.x < 0 || coord.x >= this->g_worldSize.x ||
-                     coord.y < 0 || coord.y >= this->g_worldSize.y;
+    for (std::size_t i=0; i<targets.size(); ++i)
+    {
+        const auto& node = this->g_nodes[targets[i]];
+        costs[i] = (node._generation == this->g_generation) ? node._g : FGE_ASTAR_NO_COST;
+    }
 }
 
 fge::AStar::Vector2i Heuristic::getDelta(fge::AStar::Vector2i source, fge::AStar::Vector2i target)
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/extra/extra_pathService.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace fge::AStar
+{
+
+PathService::~PathService()
+{
+    this->wait();
+}
+
+void PathService::setThreadPool(fge::ThreadPool* threadPool)
+{
+    this->wait();
+    this->g_threadPool = threadPool;
+}
+fge::ThreadPool* PathService::getThreadPool() const
+{
+    return this->g_threadPool;
+}
+
+fge::AStar::Generator& PathService::getGenerator()
+{
+    return this->g_generator;
+}
+const fge::AStar::Generator& PathService::getGenerator() const
+{
+    return this->g_generator;
+}
+
+void PathService::setDeduplicationRadius(int32_t radius)
+{
+    this->g_deduplicationRadius = std::max(radius, 0);
+}
+int32_t PathService::getDeduplicationRadius() const
+{
+    return this->g_deduplicationRadius;
+}
+
+fge::AStar::QueryId PathService::request(fge::AStar::Vector2i source, fge::AStar::Vector2i target,
+                                         fge::AStar::PathService::Callback* callback, fge::Subscriber* subscriber)
+{
+    std::unique_ptr<fge::CallbackHandler<fge::AStar::QueryId, const fge::AStar::CoordinateList&> > handler;
+    if (callback != nullptr)
+    {
+        handler = std::make_unique<fge::CallbackHandler<fge::AStar::QueryId, const fge::AStar::CoordinateList&> >();
+        handler->add(callback, subscriber);
+    }
+
+    std::scoped_lock<std::mutex> lck(this->g_mutex);
+    if (++this->g_lastId == FGE_PATHSERVICE_BAD_QUERY)
+    {
+        ++this->g_lastId;
+    }
+    this->g_pending.push_back({this->g_lastId, source, target, std::move(handler), 0});
+    return this->g_lastId;
+}
+
+std::size_t PathService::process()
+{
+    if (this->g_running->load())
+    {
+        return 0;
+    }
+
+    std::size_t delivered = this->deliverBatch();
+
+    this->prepareBatch();
+    if (this->g_jobs.empty())
+    {
+        return delivered;
+    }
+
+    if (this->g_threadPool != nullptr)
+    {
+        this->g_running->store(true);
+        //The waiting thread can destroy the service as soon as the flag is cleared, only the shared flag is used after
+        this->g_threadPool->submit([this, running=this->g_running](){
+            this->runBatch();
+            running->store(false);
+            running->notify_all();
+        });
+    }
+    else
+    {
+        this->runBatch();
+        delivered += this->deliverBatch();
+    }
+    return delivered;
+}
+void PathService::wait()
+{
+    while (this->g_running->load())
+    {
+        this->g_running->wait(true);
+    }
+}
+
+std::size_t PathService::getPendingCount() const
+{
+    std::scoped_lock<std::mutex> lck(this->g_mutex);
+    return this->g_pending.size();
+}
+bool PathService::isRunning() const
+{
+    return this->g_running->load();
+}
+
+void PathService::prepareBatch()
+{
+    {
+        std::scoped_lock<std::mutex> lck(this->g_mutex);
+        this->g_batch = std::move(this->g_pending);
+        this->g_pending.clear();
+    }
+
+    this->g_jobs.clear();
+    if (this->g_batch.empty())
+    {
+        return;
+    }
+
+    //Snapshot of the reference generator, one generator per worker (+1 for the calling thread of parallelFor)
+    const std::size_t workerCount = this->g_threadPool != nullptr ? this->g_threadPool->getThreadCount()+1 : 1;
+    if (this->g_workers.size() != workerCount)
+    {
+        this->g_workers.clear();
+        this->g_workers.resize(workerCount);
+    }
+    for (auto& worker : this->g_workers)
+    {
+        worker.shareCollisions(this->g_generator);
+    }
+
+    //Merge identical/nearby requests, jobs are grouped by target
+    std::unordered_map<uint64_t, std::vector<std::size_t> > jobsByTarget;
+    for (auto& request : this->g_batch)
+    {
+        const uint64_t targetKey = (static_cast<uint64_t>(static_cast<uint32_t>(request._target.x)) << 32) |
+                                   static_cast<uint32_t>(request._target.y);
+        auto& jobs = jobsByTarget[targetKey];
+
+        bool merged = false;
+        for (std::size_t job : jobs)
+        {
+            const fge::AStar::Vector2i& source = this->g_jobs[job]._source;
+            if (std::abs(source.x - request._source.x) <= this->g_deduplicationRadius &&
+                std::abs(source.y - request._source.y) <= this->g_deduplicationRadius)
+            {
+                request._job = job;
+                merged = true;
+                break;
+            }
+        }
+
+        if (!merged)
+        {
+            request._job = this->g_jobs.size();
+            jobs.push_back(request._job);
+            this->g_jobs.push_back({request._source, request._target, {}});
+        }
+    }
+}
+void PathService::runBatch()
+{
+    if (this->g_threadPool != nullptr)
+    {
+        this->g_threadPool->parallelFor(this->g_jobs.size(), [this](std::size_t index, std::size_t workerIndex){
+            auto& job = this->g_jobs[index];
+            job._path = this->g_workers[workerIndex].findPath(job._source, job._target);
+        });
+    }
+    else
+    {
+        for (auto& job : this->g_jobs)
+        {
+            job._path = this->g_workers.front().findPath(job._source, job._target);
+        }
+    }
+}
+std::size_t PathService::deliverBatch()
+{
+    const std::size_t count = this->g_batch.size();
+    for (auto& request : this->g_batch)
+    {
+        const auto& path = this->g_jobs[request._job]._path;
+        if (request._callback)
+        {
+            request._callback->call(request._id, path);
+        }
+        this->_onPathFound.call(request._id, path);
+    }
+    this->g_batch.clear();
+    return count;
+}
+
+}//end fge::AStar
@@ -91,6 +91,7 @@ public:
             {
                 this->_g_myPoints[i] = this->getTransform().transformPoint(this->g_shape.getPoint(i));
             }
+            this->invalidateObstacle();
             return;
         }
 
@@ -101,6 +102,7 @@ public:
         {
             this->_g_myPoints[i] = this->getTransform().transformPoint(this->g_shape.getPoint(i));
         }
+        this->invalidateObstacle();
 
         if ( event.isMouseButtonPressed(sf::Mouse::Left) )
         {
@@ -290,4 +290,50 @@ bool Push(const std::string& name, const fge::anim::AnimationDataPtr& data)
     return true;
 }
 
+std::size_t PackAtlas()
+{
+    std::lock_guard<std::mutex> lck(_dataMutex);
+    auto textureLock = fge::texture::AcquireLock();
+    auto& atlas = fge::texture::GetAtlas(textureLock);
+
+    const auto& badTexture = fge::texture::GetBadTexture()->_texture;
+    std::size_t count = 0;
+
+    for (auto& data : _dataAnim)
+    {
+        if (data.second->_type != fge::anim::AnimationType::ANIM_TYPE_SEPARATE_FILES)
+        {
+            continue;
+        }
+
+        for (auto& group : data.second->_groups)
+        {
+            for (auto& frame : group._frames)
+            {
+                if (frame._texture == nullptr || frame._texture == badTexture || frame._textureRect.width != 0)
+                {
+                    continue;
+                }
+
+#ifdef FGE_DEF_SERVER
+                auto location = atlas.add(*frame._texture);
+#else
+                if ( frame._texture->isRepeated() )
+                {//The repeat would wrap the whole page
+                    continue;
+                }
+                auto location = atlas.add(frame._texture->copyToImage(), frame._texture->isSmooth());
+#endif //FGE_DEF_SERVER
+                if (location)
+                {
+                    frame._texture = std::move(location->_page);
+                    frame._textureRect = location->_rect;
+                    ++count;
+                }
+            }
+        }
+    }
+    return count;
+}
+
 }//end fge::anim
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/manager/tag_manager.hpp"
+#include "private/string_hash.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fge::tag
+{
+
+namespace
+{
+
+using TagNameMapType = std::unordered_map<std::string, fge::tag::TagId, fge::priv::string_hash, std::equal_to<>>;
+using TagIdMapType = std::deque<std::string>; //deque keep references valid on insertion
+
+TagNameMapType _dataTagNameMap;
+TagIdMapType _dataTagIdMap;
+std::atomic<std::size_t> _dataTagIdSize{0}; //lock-free size, tags are never removed
+std::shared_mutex _dataMutex;
+
+}//end
+
+fge::tag::TagId Intern(std::string_view tagName)
+{
+    {//Most of the tags are already interned, a shared lock is enough
+        std::shared_lock<std::shared_mutex> lck(_dataMutex);
+
+        auto it = _dataTagNameMap.find(tagName);
+        if (it != _dataTagNameMap.cend())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lck(_dataMutex);
+
+    auto it = _dataTagNameMap.find(tagName);
+    if (it != _dataTagNameMap.cend())
+    {
+        return it->second;
+    }
+
+    if (_dataTagIdMap.size() >= FGE_TAG_BADID)
+    {
+        return FGE_TAG_BADID;
+    }
+
+    auto tagId = static_cast<fge::tag::TagId>(_dataTagIdMap.size());
+    _dataTagIdMap.emplace_back(tagName);
+    _dataTagNameMap.emplace(_dataTagIdMap.back(), tagId);
+    _dataTagIdSize.store(_dataTagIdMap.size(), std::memory_order_release);
+    return tagId;
+}
+
+fge::tag::TagId GetTagId(std::string_view tagName)
+{
+    std::shared_lock<std::shared_mutex> lck(_dataMutex);
+
+    auto it = _dataTagNameMap.find(tagName);
+    if (it != _dataTagNameMap.cend())
+    {
+        return it->second;
+    }
+    return FGE_TAG_BADID;
+}
+std::string_view GetTagName(fge::tag::TagId tagId)
+{
+    std::shared_lock<std::shared_mutex> lck(_dataMutex);
+
+    if (tagId < _dataTagIdMap.size())
+    {
+        return _dataTagIdMap[tagId];
+    }
+    return {};
+}
+
+bool Check(std::string_view tagName)
+{
+    return fge::tag::GetTagId(tagName) != FGE_TAG_BADID;
+}
+bool Check(fge::tag::TagId tagId)
+{
+    return tagId < _dataTagIdSize.load(std::memory_order_acquire);
+}
+
+std::size_t GetInternedSize()
+{
+    return _dataTagIdSize.load(std::memory_order_acquire);
+}
+
+}//end fge::tag
@@ -26,6 +26,33 @@ namespace
 fge::texture::TextureDataPtr _dataTextureBad;
 std::unordered_map<std::string, fge::texture::TextureDataPtr, fge::priv::string_hash, std::equal_to<>> _dataTexture;
 std::mutex _dataMutex;
+fge::TextureAtlas _dataAtlas;
+
+bool PackTexture(fge::texture::TextureData& data)
+{
+    if (!data._valid || data._texture == nullptr || data._rect.width != 0)
+    {
+        return false;
+    }
+
+#ifdef FGE_DEF_SERVER
+    auto location = _dataAtlas.add(*data._texture);
+#else
+    if ( data._texture->isRepeated() )
+    {//The repeat would wrap the whole page
+        return false;
+    }
+    auto location = _dataAtlas.add(data._texture->copyToImage(), data._texture->isSmooth());
+#endif //FGE_DEF_SERVER
+    if (!location)
+    {
+        return false;
+    }
+
+    data._texture = std::move(location->_page);
+    data._rect = location->_rect;
+    return true;
+}
 
 }//end
 
@@ -68,6 +95,7 @@ bool IsInit()
 void Uninit()
 {
     _dataTexture.clear();
+    _dataAtlas.clear();
     _dataTextureBad = nullptr;
 }
 
@@ -210,6 +238,7 @@ bool Unload(std::string_view name)
     {
         it->second->_valid = false;
         it->second->_texture = _dataTextureBad->_texture;
+        it->second->_rect = {};
         _dataTexture.erase(it);
         return true;
     }
@@ -223,8 +252,10 @@ void UnloadAll()
     {
         data.second->_valid = false;
         data.second->_texture = _dataTextureBad->_texture;
+        data.second->_rect = {};
     }
     _dataTexture.clear();
+    _dataAtlas.clear();
 }
 
 bool Push(std::string_view name, const fge::texture::TextureDataPtr& data)
@@ -244,4 +275,38 @@ bool Push(std::string_view name, const fge::texture::TextureDataPtr& data)
     return true;
 }
 
+std::size_t PackAtlas(const std::vector<std::string>& names)
+{
+    std::lock_guard<std::mutex> lck(_dataMutex);
+    std::size_t count = 0;
+
+    if ( names.empty() )
+    {
+        for (auto& data : _dataTexture)
+        {
+            count += PackTexture(*data.second) ? 1 : 0;
+        }
+    }
+    else
+    {
+        for (const auto& name : names)
+        {
+            auto it = _dataTexture.find(name);
+            if (it != _dataTexture.end())
+            {
+                count += PackTexture(*it->second) ? 1 : 0;
+            }
+        }
+    }
+    return count;
+}
+fge::TextureAtlas& GetAtlas(const std::unique_lock<std::mutex>& lock)
+{
+    if (!lock.owns_lock() || lock.mutex() != &_dataMutex)
+    {
+        throw std::runtime_error("texture_manager::GetAtlas : lock is not owned or not my mutex !");
+    }
+    return _dataAtlas;
+}
+
 }//end fge::texture
@@ -16,78 +16,579 @@
 
 #include "FastEngine/manager/timer_manager.hpp"
 
-#include <list>
+#include <array>
 #include <thread>
 #include <condition_variable>
+#include <unordered_map>
+#include <vector>
 
-#include "FastEngine/C_clock.hpp"
+#define FGE_TIMER_WHEEL_LEVEL_BITS 8
+#define FGE_TIMER_WHEEL_SLOTS (1 << FGE_TIMER_WHEEL_LEVEL_BITS)
+#define FGE_TIMER_WHEEL_LEVELS 4
+#define FGE_TIMER_MAX_WAIT_TIME 1000
+#define FGE_TIMER_PAUSED_CHECK_TIME 1000
 
 namespace fge::timer
 {
 
-namespace
+/**
+ * \class TimerWheel
+ * \brief Hierarchical timing wheel used by the timer thread (not thread-safe)
+ *
+ * Timers are placed by deadline (in milliseconds) in FGE_TIMER_WHEEL_LEVELS levels of FGE_TIMER_WHEEL_SLOTS
+ * slots, each level covering a range FGE_TIMER_WHEEL_SLOTS times larger than the previous one. The slots of
+ * an upper level are cascaded into the lower levels when the wheel reach them, so adding, rescheduling
+ * and removing a timer is done in constant time and only the expired timers are touched.
+ *
+ * Paused timers are checked every FGE_TIMER_PAUSED_CHECK_TIME milliseconds.
+ */
+class TimerWheel
+{
+public:
+    using Tick = uint64_t;
+
+    TimerWheel() = default;
+
+    bool add(fge::timer::TimerShared timer);
+    bool remove(const fge::Timer* timer);
+    void clear();
+
+    bool reschedule(const fge::Timer* timer);
+    void rescheduleAll();
+    bool rename(const fge::Timer* timer, const std::string& name);
+
+    [[nodiscard]] bool contains(const fge::Timer* timer) const;
+    [[nodiscard]] fge::timer::TimerShared find(const std::string& name) const;
+    [[nodiscard]] std::size_t getSize() const;
+
+    /**
+     * \brief Move the wheel to the current time and retrieve the expired timers
+     *
+     * Expired timers are still handled but not scheduled, finishExpired() must be called
+     * once their callbacks are done.
+     *
+     * \param expired The list where expired timers are added
+     */
+    void advance(std::vector<fge::timer::TimerShared>& expired);
+    /**
+     * \brief Remove an expired timer if it reached its goal or reschedule it
+     *
+     * \param timer An expired timer returned by advance()
+     * \param reached \b true if the callbacks of the timer were called
+     */
+    void finishExpired(const fge::Timer* timer, bool reached);
+
+    [[nodiscard]] std::chrono::milliseconds getWaitTime() const;
+
+private:
+    struct Entry
+    {
+        fge::timer::TimerShared _timer;
+        std::string _name;      ///< Indexed name
+        Tick _deadline{0};
+        std::size_t _level{0};
+        std::size_t _slot{0};
+        std::size_t _position{0};
+        bool _linked{false};    ///< In a slot
+        bool _expired{false};   ///< Returned by advance() and waiting for finishExpired()
+    };
+
+    [[nodiscard]] Tick getTick() const;
+    void schedule(Entry& entry);
+    void link(Entry& entry);
+    void unlink(Entry& entry);
+    void cascade(std::size_t level, std::size_t slot);
+    void unindexName(const Entry& entry);
+    void release(Entry& entry);
+
+    const std::chrono::steady_clock::time_point g_startTimePoint{std::chrono::steady_clock::now()};
+    Tick g_currentTick{0};
+    std::size_t g_linkedCount{0};
+    std::array<std::size_t, FGE_TIMER_WHEEL_LEVELS> g_levelCounts{};
+
+    std::unordered_map<const fge::Timer*, Entry> g_entries;
+    std::unordered_multimap<std::string, Entry*> g_names;
+    std::array<std::array<std::vector<Entry*>, FGE_TIMER_WHEEL_SLOTS>, FGE_TIMER_WHEEL_LEVELS> g_slots;
+};
+
+bool TimerWheel::add(fge::timer::TimerShared timer)
+{
+    if (!timer || this->g_entries.find(timer.get()) != this->g_entries.end())
+    {
+        return false;
+    }
+
+    auto& entry = this->g_entries[timer.get()];
+    entry._timer = std::move(timer);
+    entry._name = entry._timer->getName();
+    if (!entry._name.empty())
+    {
+        this->g_names.emplace(entry._name, &entry);
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(entry._timer->g_mutex);
+        entry._timer->g_isScheduled = true;
+        entry._timer->g_updateTimePoint = std::chrono::steady_clock::now();
+    }
+
+    this->schedule(entry);
+    return true;
+}
+bool TimerWheel::remove(const fge::Timer* timer)
+{
+    auto it = this->g_entries.find(timer);
+    if (it == this->g_entries.end())
+    {
+        return false;
+    }
+
+    this->unlink(it->second);
+    this->unindexName(it->second);
+    this->release(it->second);
+    this->g_entries.erase(it);
+    return true;
+}
+void TimerWheel::clear()
+{
+    for (auto& entry : this->g_entries)
+    {
+        this->release(entry.second);
+    }
+    this->g_entries.clear();
+    this->g_names.clear();
+    for (auto& level : this->g_slots)
+    {
+        for (auto& slot : level)
+        {
+            slot.clear();
+        }
+    }
+    this->g_linkedCount = 0;
+    this->g_levelCounts.fill(0);
+}
+
+bool TimerWheel::reschedule(const fge::Timer* timer)
+{
+    auto it = this->g_entries.find(timer);
+    if (it == this->g_entries.end())
+    {
+        return false;
+    }
+    if (!it->second._expired)
+    {//Expired timers are rescheduled by finishExpired()
+        this->unlink(it->second);
+        this->schedule(it->second);
+    }
+    return true;
+}
+void TimerWheel::rescheduleAll()
+{
+    for (auto& entry : this->g_entries)
+    {
+        if (!entry.second._expired)
+        {
+            this->unlink(entry.second);
+            this->schedule(entry.second);
+        }
+    }
+}
+bool TimerWheel::rename(const fge::Timer* timer, const std::string& name)
+{
+    auto it = this->g_entries.find(timer);
+    if (it == this->g_entries.end())
+    {
+        return false;
+    }
+
+    this->unindexName(it->second);
+    it->second._timer->setName(name);
+    it->second._name = name;
+    if (!name.empty())
+    {
+        this->g_names.emplace(name, &it->second);
+    }
+    return true;
+}
+
+bool TimerWheel::contains(const fge::Timer* timer) const
+{
+    return this->g_entries.find(timer) != this->g_entries.end();
+}
+fge::timer::TimerShared TimerWheel::find(const std::string& name) const
+{
+    if (name.empty())
+    {//Unnamed timers are not indexed
+        for (const auto& entry : this->g_entries)
+        {
+            if (entry.second._name.empty())
+            {
+                return entry.second._timer;
+            }
+        }
+        return nullptr;
+    }
+
+    auto it = this->g_names.find(name);
+    return it != this->g_names.end() ? it->second->_timer : nullptr;
+}
+std::size_t TimerWheel::getSize() const
+{
+    return this->g_entries.size();
+}
+
+void TimerWheel::advance(std::vector<fge::timer::TimerShared>& expired)
+{
+    const Tick now = this->getTick();
+    if (this->g_linkedCount == 0)
+    {
+        this->g_currentTick = std::max(now, this->g_currentTick);
+        return;
+    }
+
+    while (this->g_currentTick < now)
+    {
+        //Skip the ticks where nothing can happen, up to the next cascade of the lowest used level
+        std::size_t usedLevel = 0;
+        while (this->g_levelCounts[usedLevel] == 0)
+        {
+            ++usedLevel;
+        }
+        if (usedLevel > 0)
+        {
+            const Tick levelRange = Tick{1} << (FGE_TIMER_WHEEL_LEVEL_BITS*usedLevel);
+            const Tick nextCascade = (this->g_currentTick / levelRange + 1) * levelRange;
+            if (nextCascade > now)
+            {
+                this->g_currentTick = now;
+                break;
+            }
+            this->g_currentTick = nextCascade - 1;
+        }
+
+        const Tick tick = ++this->g_currentTick;
+
+        //Upper levels first, so a lower slot receive its timers before being processed
+        for (std::size_t level=FGE_TIMER_WHEEL_LEVELS-1; level>0; --level)
+        {
+            const Tick levelMask = (Tick{1} << (FGE_TIMER_WHEEL_LEVEL_BITS*level)) - 1;
+            if ((tick & levelMask) == 0)
+            {
+                this->cascade(level, (tick >> (FGE_TIMER_WHEEL_LEVEL_BITS*level)) & (FGE_TIMER_WHEEL_SLOTS-1));
+            }
+        }
+
+        auto& slot = this->g_slots[0][tick & (FGE_TIMER_WHEEL_SLOTS-1)];
+        for (auto* entry : slot)
+        {
+            entry->_linked = false;
+            entry->_expired = true;
+            expired.push_back(entry->_timer);
+        }
+        this->g_linkedCount -= slot.size();
+        this->g_levelCounts[0] -= slot.size();
+        slot.clear();
+
+        if (this->g_linkedCount == 0)
+        {
+            this->g_currentTick = now;
+            break;
+        }
+    }
+}
+void TimerWheel::finishExpired(const fge::Timer* timer, bool reached)
+{
+    auto it = this->g_entries.find(timer);
+    if (it == this->g_entries.end() || !it->second._expired)
+    {//Destroyed (or destroyed and created again) during the callbacks
+        return;
+    }
+
+    it->second._expired = false;
+    if (reached && timer->goalReached())
+    {//The timer was not restarted by a callback
+        this->unindexName(it->second);
+        this->release(it->second);
+        this->g_entries.erase(it);
+    }
+    else
+    {
+        this->schedule(it->second);
+    }
+}
+
+std::chrono::milliseconds TimerWheel::getWaitTime() const
+{
+    if (this->g_linkedCount == 0)
+    {
+        return std::chrono::milliseconds{FGE_TIMER_MAX_WAIT_TIME};
+    }
+
+    const Tick now = this->getTick();
+    if (now > this->g_currentTick)
+    {
+        return std::chrono::milliseconds{0};
+    }
+
+    //First used slot before the next cascade of the level 1
+    const Tick boundary = ((this->g_currentTick >> FGE_TIMER_WHEEL_LEVEL_BITS) + 1) << FGE_TIMER_WHEEL_LEVEL_BITS;
+    Tick next = boundary;
+    for (Tick tick=this->g_currentTick+1; tick<boundary; ++tick)
+    {
+        if (!this->g_slots[0][tick & (FGE_TIMER_WHEEL_SLOTS-1)].empty())
+        {
+            next = tick;
+            break;
+        }
+    }
+    return std::chrono::milliseconds{std::min<Tick>(next - now, FGE_TIMER_MAX_WAIT_TIME)};
+}
+
+TimerWheel::Tick TimerWheel::getTick() const
+{
+    return static_cast<Tick>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->g_startTimePoint).count());
+}
+void TimerWheel::schedule(Entry& entry)
 {
+    Tick delay = FGE_TIMER_PAUSED_CHECK_TIME;
+    {
+        std::lock_guard<std::mutex> lck(entry._timer->g_mutex);
+        if (!entry._timer->g_isPaused)
+        {
+            const auto timeLeft = entry._timer->g_goalDuration - entry._timer->computeElapsedTime();
+            delay = timeLeft.count() > 0 ? static_cast<Tick>(timeLeft.count()) : 0;
+        }
+    }
 
-using DataTimersType = std::list<fge::timer::TimerShared>;
+    //The elapsed time and the ticks are both truncated to the millisecond, one more tick make sure
+    //that the goal is reached when the timer expire. The current slot is already processed.
+    entry._deadline = std::max(this->getTick() + delay + 1, this->g_currentTick + 1);
+    this->link(entry);
+}
+void TimerWheel::link(Entry& entry)
+{
+    const Tick delta = entry._deadline - this->g_currentTick;
+
+    std::size_t level = 0;
+    while (level < FGE_TIMER_WHEEL_LEVELS-1 && delta >= (Tick{1} << (FGE_TIMER_WHEEL_LEVEL_BITS*(level+1))))
+    {
+        ++level;
+    }
+    //Deadlines beyond the last level land in a nearer slot and are cascaded again
+    const std::size_t slot = (entry._deadline >> (FGE_TIMER_WHEEL_LEVEL_BITS*level)) & (FGE_TIMER_WHEEL_SLOTS-1);
 
-DataTimersType _dataTimers;
+    auto& slotList = this->g_slots[level][slot];
+    entry._level = level;
+    entry._slot = slot;
+    entry._position = slotList.size();
+    entry._linked = true;
+    slotList.push_back(&entry);
+    ++this->g_linkedCount;
+    ++this->g_levelCounts[level];
+}
+void TimerWheel::unlink(Entry& entry)
+{
+    if (!entry._linked)
+    {
+        return;
+    }
+
+    auto& slotList = this->g_slots[entry._level][entry._slot];
+    slotList[entry._position] = slotList.back();
+    slotList[entry._position]->_position = entry._position;
+    slotList.pop_back();
+
+    entry._linked = false;
+    --this->g_linkedCount;
+    --this->g_levelCounts[entry._level];
+}
+void TimerWheel::cascade(std::size_t level, std::size_t slot)
+{
+    std::vector<Entry*> entries;
+    entries.swap(this->g_slots[level][slot]);
+    this->g_linkedCount -= entries.size();
+    this->g_levelCounts[level] -= entries.size();
+
+    for (auto* entry : entries)
+    {
+        this->link(*entry);
+    }
+
+    //Keep the allocated memory of the slot
+    if (this->g_slots[level][slot].empty())
+    {
+        entries.clear();
+        this->g_slots[level][slot].swap(entries);
+    }
+}
+void TimerWheel::unindexName(const Entry& entry)
+{
+    if (entry._name.empty())
+    {
+        return;
+    }
+
+    auto range = this->g_names.equal_range(entry._name);
+    for (auto it=range.first; it!=range.second; ++it)
+    {
+        if (it->second == &entry)
+        {
+            this->g_names.erase(it);
+            return;
+        }
+    }
+}
+void TimerWheel::release(Entry& entry)
+{
+    std::lock_guard<std::mutex> lck(entry._timer->g_mutex);
+    entry._timer->foldElapsedTime();
+    entry._timer->g_isScheduled = false;
+}
+
+namespace
+{
+
+TimerWheel _wheel;
 std::mutex _dataMutex;
 std::condition_variable _dataCv;
+bool _rescheduleAll = false;
+fge::ThreadPool* _threadPool = nullptr;
+
+struct QueuedTimer
+{
+    fge::timer::TimerShared _timer;
+    std::chrono::steady_clock::time_point _queueTimePoint;
+};
+
+std::vector<QueuedTimer> _queuedTimers;
+std::chrono::milliseconds _queueTimeout{0};
+std::mutex _queueMutex;
+
+fge::timer::Stats _stats;
+std::mutex _statsMutex;
 
 std::unique_ptr<std::thread> _timerThread;
 bool _timerThreadRunning = false;
 
+//Call the callbacks if the goal is reached, return false otherwise
+bool CallTimer(fge::Timer& timer)
+{
+    const std::chrono::milliseconds timeLeft = timer.getTimeLeft();
+    if (timeLeft.count() > 0)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(_statsMutex);
+        ++_stats._callbackCount;
+        _stats._totalLatency -= timeLeft;
+        _stats._maxLatency = std::max(_stats._maxLatency, -timeLeft);
+    }
+
+    timer._onTimeReached.call(timer);
+    return true;
+}
+void CallDeferredTimer(const fge::timer::TimerShared& timer)
+{
+    const bool reached = CallTimer(*timer);
+
+    {
+        std::lock_guard<std::mutex> lck(_dataMutex);
+        _wheel.finishExpired(timer.get(), reached);
+    }
+    _dataCv.notify_all();
+}
+
+//Remove the timers that waited too long in the main loop queue, _dataMutex must be locked
+void DropTimedOutQueuedTimers()
+{
+    std::lock_guard<std::mutex> lck(_queueMutex);
+    if (_queueTimeout.count() <= 0 || _queuedTimers.empty())
+    {
+        return;
+    }
+
+    //Timers are queued in order, the oldest ones are at the front
+    const auto now = std::chrono::steady_clock::now();
+    auto it = _queuedTimers.begin();
+    while (it != _queuedTimers.end() && now - it->_queueTimePoint >= _queueTimeout)
+    {
+        _wheel.remove(it->_timer.get());
+        ++it;
+    }
+    if (it == _queuedTimers.begin())
+    {
+        return;
+    }
+
+    const auto dropped = static_cast<uint64_t>(it - _queuedTimers.begin());
+    _queuedTimers.erase(_queuedTimers.begin(), it);
+
+    std::lock_guard<std::mutex> lckStats(_statsMutex);
+    _stats._droppedCount += dropped;
+}
+
 void TimerThread()
 {
-    std::chrono::milliseconds waitTime = std::chrono::milliseconds(1000);
+    std::vector<fge::timer::TimerShared> expired;
+    std::vector<std::pair<fge::timer::TimerShared, bool> > finished;
     std::unique_lock<std::mutex> lckData(_dataMutex);
 
-    fge::Clock clock;
-
     while (_timerThreadRunning)
     {
-        _dataCv.wait_for(lckData, waitTime);
+        _dataCv.wait_for(lckData, _wheel.getWaitTime());
 
         if (!_timerThreadRunning)
         {
             break;
         }
 
-        waitTime = std::chrono::milliseconds(1000);
+        if (_rescheduleAll)
+        {
+            _rescheduleAll = false;
+            _wheel.rescheduleAll();
+        }
 
-        std::chrono::milliseconds interval = std::chrono::duration_cast<std::chrono::milliseconds>( clock.restart() );
+        DropTimedOutQueuedTimers();
 
-        for (auto it=_dataTimers.begin(); it != _dataTimers.end(); ++it)
+        _wheel.advance(expired);
+        if (expired.empty())
         {
-            auto* timerData = (*it).get();
-
-            timerData->addToElapsedTime(interval);
-            std::chrono::milliseconds timeLeft = timerData->getTimeLeft();
-            if ( timeLeft.count() <= 0 )
-            {//time reached
-                timerData->_onTimeReached.call(*timerData);
+            continue;
+        }
 
-                timeLeft = timerData->getTimeLeft();
-                if ( timeLeft.count() <= 0 )
-                {//We recheck if the goal is reached after the call to the callback (if the user restarted the timer, we will not destroy it (loop))
-                    it = --_dataTimers.erase(it);
-                }
-                else
-                {//New goal
-                    if (timeLeft < waitTime)
-                    {
-                        waitTime = timeLeft;
-                    }
-                }
+        //Callbacks are called without the lock, so they can use the timer manager
+        fge::ThreadPool* threadPool = _threadPool;
+        lckData.unlock();
+        for (auto& timer : expired)
+        {
+            const auto policy = timer->getDispatchPolicy();
+            if (policy == fge::Timer::DispatchPolicies::DISPATCH_THREAD_POOL && threadPool != nullptr)
+            {
+                threadPool->submit([timer](){
+                    CallDeferredTimer(timer);
+                });
+            }
+            else if (policy == fge::Timer::DispatchPolicies::DISPATCH_MAIN_LOOP)
+            {
+                std::lock_guard<std::mutex> lck(_queueMutex);
+                _queuedTimers.push_back({std::move(timer), std::chrono::steady_clock::now()});
             }
             else
             {
-                if (timeLeft < waitTime)
-                {
-                    waitTime = timeLeft;
-                }
+                const bool reached = CallTimer(*timer);
+                finished.emplace_back(std::move(timer), reached);
             }
         }
+        lckData.lock();
+
+        for (const auto& timer : finished)
+        {
+            _wheel.finishExpired(timer.first.get(), timer.second);
+        }
+        finished.clear();
+        expired.clear();
     }
 }
 
@@ -109,109 +610,148 @@ void Uninit()
 {
     if (_timerThread != nullptr )
     {
+        _dataMutex.lock();
         _timerThreadRunning = false;
+        _dataMutex.unlock();
         _dataCv.notify_all();
 
         _timerThread->join();
         _timerThread.reset(nullptr);
 
         _dataMutex.lock();
-        _dataTimers.clear();
+        _wheel.clear();
         _dataMutex.unlock();
+
+        _queueMutex.lock();
+        _queuedTimers.clear();
+        _queueMutex.unlock();
+    }
+}
+
+void SetThreadPool(fge::ThreadPool* threadPool)
+{
+    std::lock_guard<std::mutex> lck(_dataMutex);
+    _threadPool = threadPool;
+}
+fge::ThreadPool* GetThreadPool()
+{
+    std::lock_guard<std::mutex> lck(_dataMutex);
+    return _threadPool;
+}
+
+std::size_t ProcessQueuedCallbacks()
+{
+    std::vector<QueuedTimer> timers;
+    {
+        std::lock_guard<std::mutex> lck(_queueMutex);
+        timers.swap(_queuedTimers);
     }
+
+    for (const auto& timer : timers)
+    {
+        CallDeferredTimer(timer._timer);
+    }
+    return timers.size();
+}
+void SetQueueTimeout(const std::chrono::milliseconds& timeout)
+{
+    std::lock_guard<std::mutex> lck(_queueMutex);
+    _queueTimeout = timeout;
+}
+std::chrono::milliseconds GetQueueTimeout()
+{
+    std::lock_guard<std::mutex> lck(_queueMutex);
+    return _queueTimeout;
+}
+
+fge::timer::Stats GetStats()
+{
+    fge::timer::Stats stats;
+    {
+        std::lock_guard<std::mutex> lck(_statsMutex);
+        stats = _stats;
+    }
+    std::lock_guard<std::mutex> lck(_queueMutex);
+    stats._queuedCount = _queuedTimers.size();
+    return stats;
+}
+void ResetStats()
+{
+    std::lock_guard<std::mutex> lck(_statsMutex);
+    _stats = {};
 }
 
 void Notify()
 {
+    _dataMutex.lock();
+    _rescheduleAll = true;
+    _dataMutex.unlock();
     _dataCv.notify_all();
 }
+bool Notify(const fge::timer::TimerShared& timer)
+{
+    std::lock_guard<std::mutex> lck(_dataMutex);
+    if ( _wheel.reschedule(timer.get()) )
+    {
+        _dataCv.notify_all();
+        return true;
+    }
+    return false;
+}
 
 fge::timer::TimerShared Create(fge::timer::TimerShared timer)
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    _dataTimers.push_back( std::move(timer) );
+    _wheel.add(timer);
     _dataCv.notify_all();
-    return _dataTimers.back();
+    return timer;
 }
 
 bool Destroy(const fge::timer::TimerShared& timer)
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    for (auto it=_dataTimers.begin(); it != _dataTimers.end(); ++it)
-    {
-        if ( (*it).get() == timer.get() )
-        {
-            _dataTimers.erase(it);
-            _dataCv.notify_all();
-            return true;
-        }
-    }
-    return false;
+    return _wheel.remove(timer.get());
 }
 bool Destroy(const std::string& timerName)
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    for (auto it=_dataTimers.begin(); it != _dataTimers.end(); ++it)
-    {
-        if ( (*it)->getName() == timerName )
-        {
-            _dataTimers.erase(it);
-            _dataCv.notify_all();
-            return true;
-        }
-    }
-    return false;
+    auto timer = _wheel.find(timerName);
+    return timer != nullptr && _wheel.remove(timer.get());
 }
 
 void DestroyAll()
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    _dataTimers.clear();
-    _dataCv.notify_all();
+    _wheel.clear();
 }
 
 bool Check(const fge::timer::TimerShared& timer)
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    for (auto& dataTimer : _dataTimers)
-    {
-        if ( dataTimer.get() == timer.get() )
-        {
-            return true;
-        }
-    }
-    return false;
+    return _wheel.contains(timer.get());
 }
 bool Check(const std::string& timerName)
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    for (auto& dataTimer : _dataTimers)
-    {
-        if ( dataTimer->getName() == timerName )
-        {
-            return true;
-        }
-    }
-    return false;
+    return _wheel.find(timerName) != nullptr;
+}
+
+bool Rename(const fge::timer::TimerShared& timer, const std::string& name)
+{
+    std::lock_guard<std::mutex> lck(_dataMutex);
+    return _wheel.rename(timer.get(), name);
 }
 
 std::size_t GetTimerSize()
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    return _dataTimers.size();
+    return _wheel.getSize();
 }
 
 fge::timer::TimerShared Get(const std::string& timerName)
 {
     std::lock_guard<std::mutex> lck(_dataMutex);
-    for (auto& dataTimer : _dataTimers)
-    {
-        if ( dataTimer->getName() == timerName )
-        {
-            return dataTimer;
-        }
-    }
-    return nullptr;
+    return _wheel.find(timerName);
 }
 
 }//end fge::timer
@@ -16,10 +16,86 @@
 
 #include "FastEngine/object/C_childObjectsAccessor.hpp"
 #include "FastEngine/C_scene.hpp"
+#ifndef FGE_DEF_SERVER
+    #include "SFML/Graphics/RenderTexture.hpp"
+    #include <algorithm>
+    #include <cmath>
+    #include <mutex>
+#endif //FGE_DEF_SERVER
 
 namespace fge
 {
 
+#ifndef FGE_DEF_SERVER
+struct ChildObjectsAccessor::RenderCache : public fge::Subscriber
+{
+    void onNetworkApplied()
+    {
+        this->_valid = false;
+    }
+    void detachNetwork()
+    {
+        this->detachAll();
+    }
+
+    static void ReleaseTexture(RenderCache* cache)
+    {
+        _usage -= cache->_memory;
+        cache->_memory = 0;
+        cache->_texture.reset();
+        cache->_valid = false;
+    }
+    static void Evict(const RenderCache* keep)
+    {
+        while (_usage > _budget)
+        {
+            RenderCache* coldest = nullptr;
+            for (auto* cache : _caches)
+            {
+                if (cache != keep && cache->_texture && (coldest == nullptr || cache->_lastUse < coldest->_lastUse))
+                {
+                    coldest = cache;
+                }
+            }
+            if (coldest == nullptr)
+            {
+                return;
+            }
+            ReleaseTexture(coldest);
+        }
+    }
+
+    std::unique_ptr<sf::RenderTexture> _texture;
+    std::size_t _memory{0};
+    sf::FloatRect _bounds;
+    sf::Vector2f _scale{0.0f, 0.0f};
+    uint64_t _lastUse{0};
+    bool _valid{false};
+
+    static std::mutex _mutex;
+    static std::vector<RenderCache*> _caches;
+    static std::size_t _budget;
+    static std::size_t _usage;
+    static uint64_t _clock;
+};
+
+std::mutex ChildObjectsAccessor::RenderCache::_mutex;
+std::vector<ChildObjectsAccessor::RenderCache*> ChildObjectsAccessor::RenderCache::_caches;
+std::size_t ChildObjectsAccessor::RenderCache::_budget{FGE_CHILDOBJECTS_DEFAULT_CACHE_BUDGET};
+std::size_t ChildObjectsAccessor::RenderCache::_usage{0};
+uint64_t ChildObjectsAccessor::RenderCache::_clock{0};
+
+void ChildObjectsAccessor::RenderCacheDeleter::operator()(RenderCache* cache) const
+{
+    {
+        std::scoped_lock<std::mutex> lck(RenderCache::_mutex);
+        RenderCache::ReleaseTexture(cache);
+        RenderCache::_caches.erase(std::remove(RenderCache::_caches.begin(), RenderCache::_caches.end(), cache), RenderCache::_caches.end());
+    }
+    delete cache;
+}
+#endif //FGE_DEF_SERVER
+
 void ChildObjectsAccessor::DataContext::NotHandledObjectDeleter::operator()(fge::ObjectData* data)
 {
     (void)data->releaseObject();
@@ -29,6 +105,7 @@ void ChildObjectsAccessor::DataContext::NotHandledObjectDeleter::operator()(fge:
 void ChildObjectsAccessor::clear()
 {
     this->g_data.clear();
+    this->onStructureChanged();
 }
 
 void ChildObjectsAccessor::addExistingObject(const fge::ObjectDataWeak& parent, fge::Object* object, fge::Scene* linkedScene, std::size_t insertionIndex)
@@ -54,6 +131,9 @@ void ChildObjectsAccessor::addExistingObject(const fge::ObjectDataWeak& parent,
     auto parentPtr = parent.lock();
     it->_objData->setParent(parentPtr);
     it->_objPtr->_myObjectData = it->_objData;
+
+    this->g_parent = parent;
+    this->onStructureChanged();
 }
 void ChildObjectsAccessor::addNewObject(const fge::ObjectDataWeak& parent, fge::ObjectPtr&& newObject, fge::Scene* linkedScene, std::size_t insertionIndex)
 {
@@ -78,6 +158,9 @@ void ChildObjectsAccessor::addNewObject(const fge::ObjectDataWeak& parent, fge::
     auto parentPtr = parent.lock();
     it->_objData->setParent(parentPtr);
     it->_objPtr->_myObjectData = it->_objData;
+
+    this->g_parent = parent;
+    this->onStructureChanged();
 }
 
 std::size_t ChildObjectsAccessor::getSize() const
@@ -102,6 +185,7 @@ void ChildObjectsAccessor::remove(std::size_t index)
     if (index < this->g_data.size())
     {
         this->g_data.erase(this->g_data.begin()+static_cast<std::vector<DataContext>::difference_type>(index));
+        this->onStructureChanged();
     }
 }
 void ChildObjectsAccessor::remove(std::size_t first, std::size_t last)
@@ -110,6 +194,7 @@ void ChildObjectsAccessor::remove(std::size_t first, std::size_t last)
     {
         this->g_data.erase(this->g_data.begin()+static_cast<std::vector<DataContext>::difference_type>(first),
                            this->g_data.begin()+static_cast<std::vector<DataContext>::difference_type>(last));
+        this->onStructureChanged();
     }
 }
 
@@ -130,6 +215,157 @@ void ChildObjectsAccessor::update(sf::RenderWindow& screen, fge::Event& event, c
     }
 }
 void ChildObjectsAccessor::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (!this->g_cache || this->g_data.empty())
+    {
+        this->drawChildren(target, states);
+        return;
+    }
+
+    auto& cache = *this->g_cache;
+    bool needRender = !cache._valid;
+
+    if (needRender)
+    {//Direct children bounds are in our local coordinates
+        cache._bounds = this->g_data.front()._objPtr->getGlobalBounds();
+        for (std::size_t i=1; i<this->g_data.size(); ++i)
+        {
+            const sf::FloatRect objectBounds = this->g_data[i]._objPtr->getGlobalBounds();
+            const float left = std::min(cache._bounds.left, objectBounds.left);
+            const float top = std::min(cache._bounds.top, objectBounds.top);
+            cache._bounds.width = std::max(cache._bounds.left+cache._bounds.width, objectBounds.left+objectBounds.width) - left;
+            cache._bounds.height = std::max(cache._bounds.top+cache._bounds.height, objectBounds.top+objectBounds.height) - top;
+            cache._bounds.left = left;
+            cache._bounds.top = top;
+        }
+    }
+    const sf::FloatRect& bounds = cache._bounds;
+
+    //Number of target pixels covered by one local unit, so the texture keep the final resolution
+    const float* matrix = states.transform.getMatrix();
+    const sf::Vector2f viewSize = target.getView().getSize();
+    const sf::Vector2f scale{std::hypot(matrix[0], matrix[1]) * static_cast<float>(target.getSize().x) / std::abs(viewSize.x),
+                             std::hypot(matrix[4], matrix[5]) * static_cast<float>(target.getSize().y) / std::abs(viewSize.y)};
+
+    const float width = std::ceil(bounds.width * scale.x);
+    const float height = std::ceil(bounds.height * scale.y);
+    const auto maximumSize = static_cast<float>(sf::Texture::getMaximumSize());
+    if ( !(width >= 1.0f && height >= 1.0f && width <= maximumSize && height <= maximumSize) )
+    {
+        this->drawChildren(target, states);
+        return;
+    }
+    const sf::Vector2u size{static_cast<unsigned int>(width), static_cast<unsigned int>(height)};
+
+    {
+        std::scoped_lock<std::mutex> lck(RenderCache::_mutex);
+        cache._lastUse = ++RenderCache::_clock;
+
+        if (!cache._texture || cache._texture->getSize() != size)
+        {
+            RenderCache::ReleaseTexture(&cache);
+            needRender = true;
+
+            cache._texture = std::make_unique<sf::RenderTexture>();
+            if ( !cache._texture->create(size.x, size.y) )
+            {
+                cache._texture.reset();
+            }
+            else
+            {
+                cache._memory = static_cast<std::size_t>(size.x)*size.y*4;
+                RenderCache::_usage += cache._memory;
+                RenderCache::Evict(&cache);
+            }
+        }
+    }
+
+    if (!cache._texture)
+    {
+        this->drawChildren(target, states);
+        return;
+    }
+
+    if (needRender || cache._scale != scale)
+    {
+        cache._valid = true;
+        cache._scale = scale;
+
+        cache._texture->setView(sf::View{bounds});
+        cache._texture->clear(sf::Color::Transparent);
+        this->drawChildren(*cache._texture, sf::RenderStates::Default);
+        cache._texture->display();
+
+        //Any applied network value invalidate the cache
+        cache.detachNetwork();
+        this->attachNetwork(cache);
+    }
+
+    const float left = bounds.left;
+    const float top = bounds.top;
+    const float right = bounds.left+bounds.width;
+    const float bottom = bounds.top+bounds.height;
+    const sf::Vertex vertices[4]{
+        {{left, top}, sf::Color::White, {0.0f, 0.0f}},
+        {{left, bottom}, sf::Color::White, {0.0f, height}},
+        {{right, top}, sf::Color::White, {width, 0.0f}},
+        {{right, bottom}, sf::Color::White, {width, height}}
+    };
+
+    //The texture content is premultiplied by the alpha blending of the children
+    states.blendMode = sf::BlendMode{sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha};
+    states.texture = &cache._texture->getTexture();
+    target.draw(vertices, 4, sf::TriangleStrip, states);
+}
+
+void ChildObjectsAccessor::setCacheEnabled(bool enable)
+{
+    if (enable == static_cast<bool>(this->g_cache))
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        this->g_cache.reset(new RenderCache{});
+        std::scoped_lock<std::mutex> lck(RenderCache::_mutex);
+        RenderCache::_caches.push_back(this->g_cache.get());
+    }
+    else
+    {
+        this->g_cache.reset();
+    }
+}
+bool ChildObjectsAccessor::isCacheEnabled() const
+{
+    return static_cast<bool>(this->g_cache);
+}
+void ChildObjectsAccessor::invalidateCache()
+{
+    if (this->g_cache)
+    {
+        this->g_cache->_valid = false;
+    }
+}
+
+void ChildObjectsAccessor::SetCacheMemoryBudget(std::size_t bytes)
+{
+    std::scoped_lock<std::mutex> lck(RenderCache::_mutex);
+    RenderCache::_budget = bytes;
+    RenderCache::Evict(nullptr);
+}
+std::size_t ChildObjectsAccessor::GetCacheMemoryBudget()
+{
+    std::scoped_lock<std::mutex> lck(RenderCache::_mutex);
+    return RenderCache::_budget;
+}
+std::size_t ChildObjectsAccessor::GetCacheMemoryUsage()
+{
+    std::scoped_lock<std::mutex> lck(RenderCache::_mutex);
+    return RenderCache::_usage;
+}
+
+void ChildObjectsAccessor::drawChildren(sf::RenderTarget& target, const sf::RenderStates& states) const
 {
     for (this->g_actualIteratedIndex=0; this->g_actualIteratedIndex<this->g_data.size(); ++this->g_actualIteratedIndex)
     {
@@ -137,8 +373,30 @@ void ChildObjectsAccessor::draw(sf::RenderTarget& target, sf::RenderStates state
         this->g_data[this->g_actualIteratedIndex]._objPtr->draw(target, states);
     }
 }
+void ChildObjectsAccessor::attachNetwork(RenderCache& cache) const
+{
+    for (const auto& data : this->g_data)
+    {
+        for (std::size_t i=0; i<data._objPtr->_netList.size(); ++i)
+        {
+            data._objPtr->_netList[i]->_onApplied.add(new fge::CallbackFunctorObject(&RenderCache::onNetworkApplied, &cache), &cache);
+        }
+        data._objPtr->_children.attachNetwork(cache);
+    }
+}
 #endif //FGE_DEF_SERVER
 
+void ChildObjectsAccessor::onStructureChanged()
+{
+#ifndef FGE_DEF_SERVER
+    this->invalidateCache();
+    if (auto parent = this->g_parent.lock())
+    {
+        parent->getObject()->invalidateParentsCache();
+    }
+#endif //FGE_DEF_SERVER
+}
+
 void ChildObjectsAccessor::putInFront(std::size_t index)
 {
     if (index < this->g_data.size() && index != 0)
@@ -146,6 +404,7 @@ void ChildObjectsAccessor::putInFront(std::size_t index)
         auto data = this->g_data[index];
         this->g_data.erase(this->g_data.begin()+static_cast<std::vector<DataContext>::difference_type>(index));
         this->g_data.insert(this->g_data.begin(), std::move(data));
+        this->onStructureChanged();
     }
 }
 void ChildObjectsAccessor::putInBack(std::size_t index)
@@ -155,6 +414,7 @@ void ChildObjectsAccessor::putInBack(std::size_t index)
         auto data = this->g_data[index];
         this->g_data.erase(this->g_data.begin()+static_cast<std::vector<DataContext>::difference_type>(index));
         this->g_data.push_back(std::move(data));
+        this->onStructureChanged();
     }
 }
 
@@ -0,0 +1,373 @@
+/*
+ * Copyright 2022 Guillaume Guillet
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FastEngine/object/C_lightSystem.hpp"
+#include "FastEngine/object/C_lightObstacle.hpp"
+#include "FastEngine/C_threadPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace fge
+{
+
+LightSystem::LightSystem(fge::LightSystem&& r) noexcept :
+        fge::Tunnel<fge::LightObstacle>(std::move(r)),
+        g_cellSize(r.g_cellSize),
+        g_shadowVersion(r.g_shadowVersion+1),
+        g_lights(std::move(r.g_lights)),
+        g_threadPool(r.g_threadPool)
+{
+    r.g_lights.clear();
+    for (auto* light : this->g_lights)
+    {
+        light->g_lightSystem = this;
+    }
+    this->updateObstaclesSystem();
+}
+LightSystem::~LightSystem()
+{
+    for (auto* light : this->g_lights)
+    {
+        light->g_lightSystem = nullptr;
+    }
+}
+
+fge::LightSystem& LightSystem::operator =(fge::LightSystem&& r) noexcept
+{
+    for (auto* light : this->g_lights)
+    {
+        light->g_lightSystem = nullptr;
+    }
+
+    fge::Tunnel<fge::LightObstacle>::operator=(std::move(r));
+    this->g_cellSize = r.g_cellSize;
+    //Every light of both systems must be computed again
+    this->g_shadowVersion = std::max(this->g_shadowVersion, r.g_shadowVersion) + 1;
+    r.g_shadowVersion = this->g_shadowVersion;
+    this->g_lights = std::move(r.g_lights);
+    this->g_threadPool = r.g_threadPool;
+    r.g_lights.clear();
+
+    for (auto* light : this->g_lights)
+    {
+        light->g_lightSystem = this;
+    }
+    this->updateObstaclesSystem();
+
+    this->g_cells.clear();
+    this->invalidate();
+    r.invalidate();
+    return *this;
+}
+
+void LightSystem::setCellSize(float size)
+{
+    if (size > 0.0f && size != this->g_cellSize)
+    {
+        this->g_cellSize = size;
+        this->g_cells.clear();
+        this->invalidate();
+    }
+}
+float LightSystem::getCellSize() const
+{
+    return this->g_cellSize;
+}
+
+void LightSystem::setThreadPool(fge::ThreadPool* threadPool)
+{
+    this->g_threadPool = threadPool;
+}
+fge::ThreadPool* LightSystem::getThreadPool() const
+{
+    return this->g_threadPool;
+}
+
+void LightSystem::invalidate()
+{
+    this->g_dirty = true;
+    this->g_shadowsComputed = false;
+    ++this->g_shadowVersion;
+}
+void LightSystem::invalidateObstacle(const fge::LightObstacle* obstacle)
+{
+    if (!this->g_dirty)
+    {
+        if (this->g_movedObstacles.size() >= this->g_entries.size())
+        {//Most of the obstacles have moved, a full rebuild is cheaper
+            this->g_dirty = true;
+            this->g_movedObstacles.clear();
+        }
+        else
+        {
+            this->g_movedObstacles.push_back(obstacle);
+        }
+    }
+    this->g_shadowsComputed = false;
+    ++this->g_shadowVersion;
+}
+
+void LightSystem::updateIndex()
+{
+    if (this->g_dirty || this->g_lastGatesSize != this->getGatesSize())
+    {
+        this->rebuildIndex();
+        return;
+    }
+
+    for (const auto* obstacle : this->g_movedObstacles)
+    {
+        auto it = this->g_entryIndexes.find(obstacle);
+        if (it == this->g_entryIndexes.end())
+        {//This obstacle was empty on the last build
+            this->rebuildIndex();
+            return;
+        }
+
+        const std::size_t index = it->second;
+        this->eraseEntry(index);
+        if ( !this->computeEntry(this->g_entries[index]._obstacle, this->g_entries[index]) )
+        {//This obstacle is now empty
+            this->rebuildIndex();
+            return;
+        }
+        this->insertEntry(index);
+    }
+    this->g_movedObstacles.clear();
+}
+
+std::size_t LightSystem::getObstacles(const sf::FloatRect& rect, std::vector<fge::LightObstacle*>& buff) const
+{
+    buff.clear();
+
+    const int32_t startX = static_cast<int32_t>(std::floor(rect.left / this->g_cellSize));
+    const int32_t startY = static_cast<int32_t>(std::floor(rect.top / this->g_cellSize));
+    const int32_t endX = static_cast<int32_t>(std::floor((rect.left+rect.width) / this->g_cellSize));
+    const int32_t endY = static_cast<int32_t>(std::floor((rect.top+rect.height) / this->g_cellSize));
+
+    for (int32_t x=startX; x<=endX; ++x)
+    {
+        for (int32_t y=startY; y<=endY; ++y)
+        {
+            auto it = this->g_cells.find(fge::LightSystem::getCellKey(x, y));
+            if (it == this->g_cells.end())
+            {
+                continue;
+            }
+
+            for (std::size_t index : it->second)
+            {
+                const auto& entry = this->g_entries[index];
+
+                //An obstacle is only reported by the first visited cell that contains it
+                if (x != std::max(startX, entry._cellX) || y != std::max(startY, entry._cellY))
+                {
+                    continue;
+                }
+
+                //Inclusive test, as an obstacle can be a single line with an empty area
+                const sf::FloatRect& bounds = entry._bounds;
+                if (bounds.left <= rect.left+rect.width && bounds.left+bounds.width >= rect.left &&
+                    bounds.top <= rect.top+rect.height && bounds.top+bounds.height >= rect.top)
+                {
+                    buff.push_back(entry._obstacle);
+                }
+            }
+        }
+    }
+
+    return buff.size();
+}
+
+void LightSystem::computeShadows(const sf::FloatRect& visibleArea)
+{
+    if (this->g_shadowsComputed && this->g_visibleArea == visibleArea)
+    {
+        return;
+    }
+    this->g_shadowsComputed = true;
+    this->g_visibleArea = visibleArea;
+
+    this->g_outdatedLights.clear();
+    for (auto* light : this->g_lights)
+    {
+        if (light->g_shadowVersion != this->g_shadowVersion && light->getLightBounds().intersects(visibleArea))
+        {
+            light->g_shadowVersion = this->g_shadowVersion;
+            this->g_outdatedLights.push_back(light);
+        }
+    }
+    if (this->g_outdatedLights.empty())
+    {
+        return;
+    }
+
+    this->updateIndex();
+
+    if (this->g_threadPool == nullptr || this->g_outdatedLights.size() < 2)
+    {
+        this->g_scratches.resize(1);
+        for (auto* light : this->g_outdatedLights)
+        {
+            light->computeShadows(*this, this->g_scratches.front());
+        }
+        return;
+    }
+
+    this->g_scratches.resize(this->g_threadPool->getThreadCount()+1);
+    this->g_threadPool->parallelFor(this->g_outdatedLights.size(), [this](std::size_t index, std::size_t workerIndex)
+    {
+        this->g_outdatedLights[index]->computeShadows(*this, this->g_scratches[workerIndex]);
+    });
+}
+void LightSystem::computeShadows(const fge::LightComponent& light)
+{
+    if (light.g_lightSystem != this || light.g_shadowVersion == this->g_shadowVersion)
+    {
+        return;
+    }
+    light.g_shadowVersion = this->g_shadowVersion;
+
+    this->updateIndex();
+
+    this->g_scratches.resize(std::max<std::size_t>(this->g_scratches.size(), 1));
+    light.computeShadows(*this, this->g_scratches.front());
+}
+std::size_t LightSystem::getLightsSize() const
+{
+    return this->g_lights.size();
+}
+
+void LightSystem::addLight(fge::LightComponent* light)
+{
+    this->g_lights.push_back(light);
+    light->g_lightSystem = this;
+    light->g_shadowVersion = 0;
+    this->g_shadowsComputed = false;
+}
+void LightSystem::removeLight(fge::LightComponent* light)
+{
+    for (std::size_t i=0; i<this->g_lights.size(); ++i)
+    {
+        if (this->g_lights[i] == light)
+        {
+            this->g_lights[i] = this->g_lights.back();
+            this->g_lights.pop_back();
+            break;
+        }
+    }
+    light->g_lightSystem = nullptr;
+}
+
+bool LightSystem::computeEntry(fge::LightObstacle* obstacle, fge::LightSystem::Entry& entry) const
+{
+    if (obstacle == nullptr || obstacle->_g_myPoints.empty())
+    {
+        return false;
+    }
+
+    sf::Vector2f min = obstacle->_g_myPoints.front();
+    sf::Vector2f max = min;
+    for (const auto& point : obstacle->_g_myPoints)
+    {
+        min.x = std::min(min.x, point.x);
+        min.y = std::min(min.y, point.y);
+        max.x = std::max(max.x, point.x);
+        max.y = std::max(max.y, point.y);
+    }
+
+    entry._obstacle = obstacle;
+    entry._bounds = {min, max-min};
+    entry._cellX = static_cast<int32_t>(std::floor(min.x / this->g_cellSize));
+    entry._cellY = static_cast<int32_t>(std::floor(min.y / this->g_cellSize));
+    entry._cellEndX = static_cast<int32_t>(std::floor(max.x / this->g_cellSize));
+    entry._cellEndY = static_cast<int32_t>(std::floor(max.y / this->g_cellSize));
+    return true;
+}
+void LightSystem::insertEntry(std::size_t index)
+{
+    const auto& entry = this->g_entries[index];
+    for (int32_t x=entry._cellX; x<=entry._cellEndX; ++x)
+    {
+        for (int32_t y=entry._cellY; y<=entry._cellEndY; ++y)
+        {
+            this->g_cells[fge::LightSystem::getCellKey(x, y)].push_back(index);
+        }
+    }
+}
+void LightSystem::eraseEntry(std::size_t index)
+{
+    const auto& entry = this->g_entries[index];
+    for (int32_t x=entry._cellX; x<=entry._cellEndX; ++x)
+    {
+        for (int32_t y=entry._cellY; y<=entry._cellEndY; ++y)
+        {
+            auto& cell = this->g_cells[fge::LightSystem::getCellKey(x, y)];
+            auto it = std::find(cell.begin(), cell.end(), index);
+            if (it != cell.end())
+            {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+void LightSystem::rebuildIndex()
+{
+    this->g_dirty = false;
+    this->g_lastGatesSize = this->getGatesSize();
+    this->g_movedObstacles.clear();
+
+    this->g_entries.clear();
+    this->g_entryIndexes.clear();
+    for (auto& cell : this->g_cells)
+    {//Keep the allocated memory for the next build
+        cell.second.clear();
+    }
+
+    for (std::size_t i=0; i<this->getGatesSize(); ++i)
+    {
+        fge::LightSystem::Entry entry{};
+        if ( !this->computeEntry(this->get(i), entry) )
+        {
+            continue;
+        }
+
+        const std::size_t index = this->g_entries.size();
+        this->g_entries.push_back(entry);
+        this->g_entryIndexes[entry._obstacle] = index;
+        this->insertEntry(index);
+    }
+}
+
+void LightSystem::updateObstaclesSystem()
+{
+    for (std::size_t i=0; i<this->getGatesSize(); ++i)
+    {
+        fge::LightObstacle* obstacle = this->get(i);
+        if (obstacle != nullptr)
+        {
+            obstacle->g_lightSystem = this;
+        }
+    }
+}
+
+uint64_t LightSystem::getCellKey(int32_t x, int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+}
+
+}//end fge
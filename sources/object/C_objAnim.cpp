@@ -15,6 +15,7 @@
  */
 
 #include "FastEngine/object/C_objAnim.hpp"
+#include "FastEngine/C_spriteBatch.hpp"
 
 namespace fge
 {
@@ -131,6 +132,13 @@ FGE_OBJ_DRAW_BODY(ObjAnimation)
     states.texture = static_cast<const sf::Texture*>(this->g_animation);
     target.draw(this->g_vertices, 4, sf::TriangleStrip, states);
 }
+FGE_OBJ_DRAWBATCHED_BODY(ObjAnimation)
+{
+    states.transform *= this->getTransform();
+    states.texture = static_cast<const sf::Texture*>(this->g_animation);
+    batch.addQuad(this->g_vertices, states);
+    return true;
+}
 #endif
 
 void ObjAnimation::save(nlohmann::json& jsonObject, fge::Scene* scene)
@@ -20,6 +20,7 @@
 #include "FastEngine/extra/extra_function.hpp"
 
 #include "FastEngine/object/C_objRenderMap.hpp"
+#include <algorithm>
 
 namespace fge
 {
@@ -61,6 +62,8 @@ void ObjLight::setTexture(const fge::Texture& texture, bool resetRect)
 
     // Assign the new texture
     this->g_texture = texture;
+    this->updateTexCoords();
+    this->invalidateShadowCache();
     this->setOrigin( static_cast<float>(this->g_textureRect.width)/2.0f, static_cast<float>(this->g_textureRect.height)/2.0f );
 }
 void ObjLight::setTextureRect(const sf::IntRect& rectangle)
@@ -70,6 +73,7 @@ void ObjLight::setTextureRect(const sf::IntRect& rectangle)
         this->g_textureRect = rectangle;
         this->updatePositions();
         this->updateTexCoords();
+        this->invalidateShadowCache();
     }
 }
 
@@ -88,6 +92,16 @@ void ObjLight::setColor(const sf::Color& color)
     this->g_vertices[1].color = color;
     this->g_vertices[2].color = color;
     this->g_vertices[3].color = color;
+    this->invalidateShadowCache();
+}
+
+void ObjLight::invalidateShadowCache()
+{
+#ifndef FGE_DEF_SERVER
+    this->g_shadowCache._valid = false;
+    this->g_shadowComputed = false;
+#endif //FGE_DEF_SERVER
+    this->invalidateLight();
 }
 
 const fge::Texture& ObjLight::getTexture() const
@@ -120,71 +134,85 @@ FGE_OBJ_UPDATE_BODY(ObjLight)
 {
 #ifndef FGE_DEF_SERVER
     FGE_OBJ_UPDATE_CALL(this->g_renderMap);
+
+    //Moved lights are invalidated before any draw, so they are all computed by the same batched pass
+    if ( this->hasMoved() )
+    {
+        this->invalidateShadowCache();
+    }
 #endif //FGE_DEF_SERVER
 }
 
 #ifndef FGE_DEF_SERVER
 FGE_OBJ_DRAW_BODY(ObjLight)
 {
-    this->g_renderMap._renderTexture.clear(sf::Color(0,0,0,0));
-
-    states.transform *= this->getTransform();
-    states.texture = static_cast<const sf::Texture*>(this->g_texture);
-    states.blendMode = sf::BlendMode{sf::BlendMode::Factor::One,
-                                     sf::BlendMode::Factor::Zero,
-                                     sf::BlendMode::Equation::Add,
+    //The light can be moved without an update (paused scene, network ...), it's then computed alone
+    if ( this->hasMoved() )
+    {
+        this->g_shadowCache._valid = false;
+        this->g_shadowComputed = false;
+        this->invalidateLightOnly();
+    }
 
-                                     sf::BlendMode::Factor::One,
-                                     sf::BlendMode::Factor::Zero,
-                                     sf::BlendMode::Equation::Add};
+    auto* lightSystem = this->getLightSystem();
+    if (lightSystem != nullptr)
+    {
+        //Compute the shadows of every outdated visible light of the system at once
+        lightSystem->computeShadows( fge::GetScreenRect(target) );
+        //This light can be outside the target area or added after the first computation
+        lightSystem->computeShadows(*this);
+    }
+    else if (!this->g_shadowComputed)
+    {//No obstacles, the scratch is not used
+        fge::ShadowScratch scratch;
+        this->computeShadowGeometry(nullptr, scratch);
+    }
 
-    this->g_renderMap._renderTexture.draw(this->g_vertices, 4, sf::TriangleStrip, states);
+    //The light map is only rendered again if the light or a nearby obstacle have changed
+    const float* parentMatrix = states.transform.getMatrix();
+    if ( !std::equal(parentMatrix, parentMatrix+16, this->g_shadowCache._parentTransform.getMatrix()) )
+    {
+        this->g_shadowCache._parentTransform = states.transform;
+        this->g_shadowOutdated = true;
+    }
+    //The light map is drawn with the view of the last frame target
+    const float* viewMatrix = this->g_renderMap._renderTexture.getView().getTransform().getMatrix();
+    if ( !std::equal(viewMatrix, viewMatrix+16, this->g_shadowCache._viewTransform.getMatrix()) )
+    {
+        this->g_shadowCache._viewTransform = this->g_renderMap._renderTexture.getView().getTransform();
+        this->g_shadowOutdated = true;
+    }
+    //The render texture is created again when the window is resized
+    if (this->g_renderMap._renderTexture.getSize() != this->g_shadowCache._mapSize)
+    {
+        this->g_shadowCache._mapSize = this->g_renderMap._renderTexture.getSize();
+        this->g_shadowOutdated = true;
+    }
 
-    if ( this->_g_lightSystemGate.isOpen() )
+    if ( this->g_shadowOutdated )
     {
-        fge::LightSystem* lightSystem = this->_g_lightSystemGate.getTunnel();
+        this->g_shadowOutdated = false;
 
-        sf::BlendMode noLightBlend = sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::One, sf::BlendMode::Equation::Add,
-                                                sf::BlendMode::Factor::Zero, sf::BlendMode::Factor::Zero, sf::BlendMode::Equation::Add);
+        this->g_renderMap._renderTexture.clear(sf::Color(0,0,0,0));
 
-        sf::FloatRect bounds = this->getGlobalBounds();
-        float range = (bounds.width > bounds.height) ? bounds.width : bounds.height;
+        states.transform *= this->getTransform();
+        states.texture = static_cast<const sf::Texture*>(this->g_texture);
+        states.blendMode = sf::BlendMode{sf::BlendMode::Factor::One,
+                                         sf::BlendMode::Factor::Zero,
+                                         sf::BlendMode::Equation::Add,
 
-        for ( std::size_t i=0; i<lightSystem->getGatesSize(); ++i )
-        {
-            fge::LightObstacle* obstacle = lightSystem->get(i);
+                                         sf::BlendMode::Factor::One,
+                                         sf::BlendMode::Factor::Zero,
+                                         sf::BlendMode::Equation::Add};
 
-            std::size_t passCount = 0;
+        this->g_renderMap._renderTexture.draw(this->g_vertices, 4, sf::TriangleStrip, states);
 
-            static std::vector<sf::Vector2f> tmpHull;
-            tmpHull.resize( obstacle->_g_myPoints.size()*2 );
-            for ( std::size_t a=0; a<obstacle->_g_myPoints.size(); ++a )
-            {
-                float distance = range - fge::GetDistanceBetween(obstacle->_g_myPoints[a], this->getPosition());
-                if (distance < 0)
-                {
-                    ++passCount;
-                    distance = std::abs(distance) + range;
-                }
-
-                sf::Vector2f direction = fge::NormalizeVector2(obstacle->_g_myPoints[a] - this->getPosition());
-                tmpHull[a] = sf::Vector2f( obstacle->_g_myPoints[a].x+direction.x*distance, obstacle->_g_myPoints[a].y+direction.y*distance );
-                tmpHull[a+obstacle->_g_myPoints.size()] = obstacle->_g_myPoints[a];
-            }
-            if (passCount >= obstacle->_g_myPoints.size())
-            {
-                continue;
-            }
-            fge::GetConvexHull(tmpHull, tmpHull);
-
-            sf::VertexArray polygon(sf::PrimitiveType::TriangleFan, tmpHull.size());
-            for ( std::size_t a=0; a<tmpHull.size(); ++a )
-            {
-                polygon[a].position = tmpHull[a];
-                polygon[a].color = sf::Color(255, 255, 255, 255);
-            }
+        if (this->g_shadowVertices.getVertexCount() > 0)
+        {
+            sf::BlendMode noLightBlend = sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::One, sf::BlendMode::Equation::Add,
+                                                       sf::BlendMode::Factor::Zero, sf::BlendMode::Factor::Zero, sf::BlendMode::Equation::Add);
 
-            this->g_renderMap._renderTexture.draw( polygon, sf::RenderStates(noLightBlend) );
+            this->g_renderMap._renderTexture.draw( this->g_shadowVertices, sf::RenderStates(noLightBlend) );
         }
     }
 
@@ -202,6 +230,122 @@ FGE_OBJ_DRAW_BODY(ObjLight)
 }
 #endif
 
+void ObjLight::computeShadows([[maybe_unused]] const fge::LightSystem& lightSystem, [[maybe_unused]] fge::ShadowScratch& scratch) const
+{
+#ifndef FGE_DEF_SERVER
+    this->computeShadowGeometry(&lightSystem, scratch);
+#endif //FGE_DEF_SERVER
+}
+
+#ifndef FGE_DEF_SERVER
+void ObjLight::computeShadowGeometry(const fge::LightSystem* lightSystem, fge::ShadowScratch& scratch) const
+{
+    this->g_shadowComputed = true;
+
+    sf::FloatRect bounds = this->getGlobalBounds();
+    float range = (bounds.width > bounds.height) ? bounds.width : bounds.height;
+    const sf::Vector2f lightPosition = this->getPosition();
+
+    if (lightSystem != nullptr)
+    {//Only the obstacles inside the range of the light can cast a shadow
+        lightSystem->getObstacles({lightPosition.x-range, lightPosition.y-range, range*2.0f, range*2.0f}, this->g_obstacles);
+    }
+    else
+    {
+        this->g_obstacles.clear();
+    }
+
+    if ( !this->updateShadowCache() )
+    {//Same geometry as the last time
+        return;
+    }
+    this->g_shadowOutdated = true;
+
+    this->g_shadowVertices.clear();
+
+    auto& hull = scratch._hull;
+    for ( const fge::LightObstacle* obstacle : this->g_obstacles )
+    {
+        std::size_t passCount = 0;
+
+        hull.resize( obstacle->_g_myPoints.size()*2 );
+        for ( std::size_t a=0; a<obstacle->_g_myPoints.size(); ++a )
+        {
+            float distance = range - fge::GetDistanceBetween(obstacle->_g_myPoints[a], lightPosition);
+            if (distance < 0)
+            {
+                ++passCount;
+                distance = std::abs(distance) + range;
+            }
+
+            sf::Vector2f direction = fge::NormalizeVector2(obstacle->_g_myPoints[a] - lightPosition);
+            hull[a] = sf::Vector2f( obstacle->_g_myPoints[a].x+direction.x*distance, obstacle->_g_myPoints[a].y+direction.y*distance );
+            hull[a+obstacle->_g_myPoints.size()] = obstacle->_g_myPoints[a];
+        }
+        if (passCount >= obstacle->_g_myPoints.size())
+        {
+            continue;
+        }
+        fge::GetConvexHull(hull, hull);
+
+        //Triangulate the convex hull as a fan, so every shadow can be merged in one draw call
+        for ( std::size_t a=2; a<hull.size(); ++a )
+        {
+            this->g_shadowVertices.append( sf::Vertex(hull[0], sf::Color(255, 255, 255, 255)) );
+            this->g_shadowVertices.append( sf::Vertex(hull[a-1], sf::Color(255, 255, 255, 255)) );
+            this->g_shadowVertices.append( sf::Vertex(hull[a], sf::Color(255, 255, 255, 255)) );
+        }
+    }
+}
+
+bool ObjLight::hasMoved() const
+{
+    const float* matrix = this->getTransform().getMatrix();
+    return !std::equal(matrix, matrix+16, this->g_shadowCache._transform.getMatrix());
+}
+bool ObjLight::updateShadowCache() const
+{
+    auto& cache = this->g_shadowCache;
+    bool outdated = !cache._valid;
+
+    const float* matrix = this->getTransform().getMatrix();
+    if ( !std::equal(matrix, matrix+16, cache._transform.getMatrix()) )
+    {
+        cache._transform = this->getTransform();
+        outdated = true;
+    }
+
+    if (cache._obstacles.size() != this->g_obstacles.size())
+    {
+        cache._obstacles.resize(this->g_obstacles.size());
+        outdated = true;
+    }
+    for (std::size_t i=0; i<this->g_obstacles.size(); ++i)
+    {
+        const fge::LightObstacle* obstacle = this->g_obstacles[i];
+
+        //FNV-1a hash of the obstacle points
+        uint64_t hash = 14695981039346656037ULL;
+        const auto* bytes = reinterpret_cast<const uint8_t*>(obstacle->_g_myPoints.data());
+        for (std::size_t b=0; b<obstacle->_g_myPoints.size()*sizeof(sf::Vector2f); ++b)
+        {
+            hash = (hash ^ bytes[b]) * 1099511628211ULL;
+        }
+
+        auto& entry = cache._obstacles[i];
+        if (entry._obstacle != obstacle || entry._pointsHash != hash)
+        {
+            entry._obstacle = obstacle;
+            entry._pointsHash = hash;
+            outdated = true;
+        }
+    }
+
+    cache._valid = true;
+    return outdated;
+}
+#endif //FGE_DEF_SERVER
+
 void ObjLight::save(nlohmann::json& jsonObject, fge::Scene* scene)
 {
     fge::Object::save(jsonObject, scene);
@@ -245,6 +389,10 @@ sf::FloatRect ObjLight::getGlobalBounds() const
 {
     return this->getTransform().transformRect(this->getLocalBounds());
 }
+sf::FloatRect ObjLight::getLightBounds() const
+{
+    return this->getGlobalBounds();
+}
 sf::FloatRect ObjLight::getLocalBounds() const
 {
     float width = static_cast<float>( std::abs(this->g_textureRect.width) );
@@ -265,9 +413,12 @@ void ObjLight::updatePositions()
 
 void ObjLight::updateTexCoords()
 {
-    float left   = static_cast<float>(this->g_textureRect.left);
+    //The texture can be packed in an atlas page
+    const sf::IntRect area = this->g_texture.getTextureRect();
+
+    float left   = static_cast<float>(area.left + this->g_textureRect.left);
     float right  = left + static_cast<float>(this->g_textureRect.width);
-    float top    = static_cast<float>(this->g_textureRect.top);
+    float top    = static_cast<float>(area.top + this->g_textureRect.top);
     float bottom = top + static_cast<float>(this->g_textureRect.height);
 
     this->g_vertices[0].texCoords = sf::Vector2f(left, top);
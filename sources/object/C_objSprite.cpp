@@ -15,6 +15,7 @@
  */
 
 #include "FastEngine/object/C_objSprite.hpp"
+#include "FastEngine/C_spriteBatch.hpp"
 
 namespace fge
 {
@@ -41,6 +42,8 @@ void ObjSprite::setTexture(const fge::Texture& texture, bool resetRect)
 
     // Assign the new texture
     this->g_texture = texture;
+    this->updateTexCoords();
+    this->invalidateParentsCache();
 }
 void ObjSprite::setTextureRect(const sf::IntRect& rectangle)
 {
@@ -49,6 +52,7 @@ void ObjSprite::setTextureRect(const sf::IntRect& rectangle)
         this->g_textureRect = rectangle;
         this->updatePositions();
         this->updateTexCoords();
+        this->invalidateParentsCache();
     }
 }
 
@@ -58,6 +62,7 @@ void ObjSprite::setColor(const sf::Color& color)
     this->g_vertices[1].color = color;
     this->g_vertices[2].color = color;
     this->g_vertices[3].color = color;
+    this->invalidateParentsCache();
 }
 
 const fge::Texture& ObjSprite::getTexture() const
@@ -81,6 +86,13 @@ FGE_OBJ_DRAW_BODY(ObjSprite)
     states.texture = static_cast<const sf::Texture*>(this->g_texture);
     target.draw(this->g_vertices, 4, sf::TriangleStrip, states);
 }
+FGE_OBJ_DRAWBATCHED_BODY(ObjSprite)
+{
+    states.transform *= this->getTransform();
+    states.texture = static_cast<const sf::Texture*>(this->g_texture);
+    batch.addQuad(this->g_vertices, states);
+    return true;
+}
 #endif
 
 void ObjSprite::save(nlohmann::json& jsonObject, fge::Scene* scene)
@@ -147,9 +159,12 @@ void ObjSprite::updatePositions()
 
 void ObjSprite::updateTexCoords()
 {
-    float left   = static_cast<float>(this->g_textureRect.left);
+    //The texture can be packed in an atlas page
+    const sf::IntRect area = this->g_texture.getTextureRect();
+
+    float left   = static_cast<float>(area.left + this->g_textureRect.left);
     float right  = left + static_cast<float>(this->g_textureRect.width);
-    float top    = static_cast<float>(this->g_textureRect.top);
+    float top    = static_cast<float>(area.top + this->g_textureRect.top);
     float bottom = top + static_cast<float>(this->g_textureRect.height);
 
     this->g_vertices[0].texCoords = sf::Vector2f(left, top);
@@ -19,6 +19,7 @@
 #undef private
 
 #include "FastEngine/object/C_objText.hpp"
+#include "FastEngine/C_spriteBatch.hpp"
 #include "FastEngine/manager/font_manager.hpp"
 #include "FastEngine/arbitraryJsonTypes.hpp"
 
@@ -149,7 +150,13 @@ ObjText::ObjText(fge::Font font, const sf::Vector2f& position, fge::ObjText::Cha
 
 void ObjText::setFont(fge::Font font)
 {
+    if (font.getData() != this->g_font.getData())
+    {
+        this->g_geometryNeedUpdate = true;
+        this->g_validCodePoints = 0;
+    }
     this->g_font = std::move(font);
+    this->invalidateParentsCache();
 }
 const fge::Font& ObjText::getFont() const
 {
@@ -160,8 +167,19 @@ void ObjText::setString(tiny_utf8::string string)
 {
     if (this->g_string != string)
     {
+        // Only the code points after the common prefix will have to be rebuilt
+        std::size_t commonPrefix = 0;
+        for (auto itOld = this->g_string.cbegin(), itNew = string.cbegin();
+             itOld != this->g_string.cend() && itNew != string.cend() && static_cast<uint32_t>(*itOld) == static_cast<uint32_t>(*itNew);
+             ++itOld, ++itNew)
+        {
+            ++commonPrefix;
+        }
+        this->g_validCodePoints = std::min(this->g_validCodePoints, commonPrefix);
+
         this->g_string = std::move(string);
         this->g_geometryNeedUpdate = true;
+        this->invalidateParentsCache();
     }
 }
 
@@ -171,6 +189,8 @@ void ObjText::setCharacterSize(fge::ObjText::CharacterSize size)
     {
         this->g_characterSize = size;
         this->g_geometryNeedUpdate = true;
+        this->g_validCodePoints = 0;
+        this->invalidateParentsCache();
     }
 }
 
@@ -180,6 +200,8 @@ void ObjText::setLineSpacingFactor(float spacingFactor)
     {
         this->g_lineSpacingFactor = spacingFactor;
         this->g_geometryNeedUpdate = true;
+        this->g_validCodePoints = 0;
+        this->invalidateParentsCache();
     }
 }
 void ObjText::setLetterSpacingFactor(float spacingFactor)
@@ -188,6 +210,8 @@ void ObjText::setLetterSpacingFactor(float spacingFactor)
     {
         this->g_letterSpacingFactor = spacingFactor;
         this->g_geometryNeedUpdate = true;
+        this->g_validCodePoints = 0;
+        this->invalidateParentsCache();
     }
 }
 
@@ -197,6 +221,8 @@ void ObjText::setStyle(std::underlying_type<Style>::type style)
     {
         this->g_style = style;
         this->g_geometryNeedUpdate = true;
+        this->g_validCodePoints = 0;
+        this->invalidateParentsCache();
     }
 }
 
@@ -205,16 +231,15 @@ void ObjText::setFillColor(const sf::Color& color)
     if (color != this->g_fillColor)
     {
         this->g_fillColor = color;
+        this->g_runNeedUpdate = true;
 
         // Change vertex colors directly, no need to update whole geometry
-        // (if geometry is updated anyway, we can skip this step)
-        if (!this->g_geometryNeedUpdate)
+        // (the characters kept by an incremental rebuild must be updated too)
+        for (auto& character : this->g_characters)
         {
-            for (auto& character : this->g_characters)
-            {
-                character.setFillColor(color);
-            }
+            character.setFillColor(color);
         }
+        this->invalidateParentsCache();
     }
 }
 void ObjText::setOutlineColor(const sf::Color& color)
@@ -222,16 +247,15 @@ void ObjText::setOutlineColor(const sf::Color& color)
     if (color != this->g_outlineColor)
     {
         this->g_outlineColor = color;
+        this->g_runNeedUpdate = true;
 
         // Change vertex colors directly, no need to update whole geometry
-        // (if geometry is updated anyway, we can skip this step)
-        if (!this->g_geometryNeedUpdate)
+        // (the characters kept by an incremental rebuild must be updated too)
+        for (auto& character : this->g_characters)
         {
-            for (auto& character : this->g_characters)
-            {
-                character.setOutlineColor(color);
-            }
+            character.setOutlineColor(color);
         }
+        this->invalidateParentsCache();
     }
 }
 
@@ -241,6 +265,8 @@ void ObjText::setOutlineThickness(float thickness)
     {
         this->g_outlineThickness = thickness;
         this->g_geometryNeedUpdate = true;
+        this->g_validCodePoints = 0;
+        this->invalidateParentsCache();
     }
 }
 
@@ -304,6 +330,8 @@ sf::Vector2f ObjText::findCharacterPos(std::size_t index) const
 
 std::vector<fge::Character>& ObjText::getCharacters()
 {
+    // The characters can be modified, so the merged run must be rebuilt
+    this->g_runNeedUpdate = true;
     return this->g_characters;
 }
 const std::vector<fge::Character>& ObjText::getCharacters() const
@@ -317,35 +345,33 @@ FGE_OBJ_DRAW_BODY(ObjText)
     if (this->g_font.valid())
     {
         this->ensureGeometryUpdate();
+        this->ensureRunUpdate();
 
-        states.transform *= getTransform();
-        states.texture = &this->g_font.getData()->_font->getTexture(this->g_characterSize);
-
-        if (this->g_outlineThickness != 0.0f)
+        if (this->g_runVertices.getVertexCount() > 0)
         {
-            for (const auto& character : this->g_characters)
-            {
-                if (character.isVisible())
-                {
-                    sf::RenderStates statesCharacter{states};
-                    statesCharacter.transform *= character.getTransform();
+            states.transform *= getTransform();
+            states.texture = &this->g_font.getData()->_font->getTexture(this->g_characterSize);
 
-                    target.draw(character.g_outlineVertices, statesCharacter);
-                }
-            }
+            target.draw(this->g_runVertices, states);
         }
+    }
+}
+FGE_OBJ_DRAWBATCHED_BODY(ObjText)
+{
+    if (this->g_font.valid())
+    {
+        this->ensureGeometryUpdate();
+        this->ensureRunUpdate();
 
-        for (const auto& character : this->g_characters)
+        if (this->g_runVertices.getVertexCount() > 0)
         {
-            if (character.isVisible())
-            {
-                sf::RenderStates statesCharacter{states};
-                statesCharacter.transform *= character.getTransform();
+            states.transform *= getTransform();
+            states.texture = &this->g_font.getData()->_font->getTexture(this->g_characterSize);
 
-                target.draw(character.g_vertices, statesCharacter);
-            }
+            batch.addTriangles(&this->g_runVertices[0], this->g_runVertices.getVertexCount(), states);
         }
     }
+    return true;
 }
 #endif
 
@@ -378,6 +404,7 @@ void ObjText::load(nlohmann::json& jsonObject, fge::Scene* scene)
     this->g_outlineThickness = jsonObject.value<float>("outlineThickness", 0.0f);
 
     this->g_geometryNeedUpdate = true;
+    this->g_validCodePoints = 0;
 }
 
 void ObjText::pack(fge::net::Packet& pck)
@@ -405,6 +432,7 @@ void ObjText::unpack(fge::net::Packet& pck)
     pck >> this->g_outlineThickness;
 
     this->g_geometryNeedUpdate = true;
+    this->g_validCodePoints = 0;
 }
 
 const char* ObjText::getClassName() const
@@ -441,19 +469,27 @@ void ObjText::ensureGeometryUpdate() const
         return;
     }
 
+    // The glyphs can have moved in the font texture, everything must be rebuilt
+    if (font->getTexture(this->g_characterSize).m_cacheId != this->g_fontTextureId)
+    {
+        this->g_validCodePoints = 0;
+    }
+
     // Save the current fonts texture id
     this->g_fontTextureId = font->getTexture(this->g_characterSize).m_cacheId;
 
     // Mark geometry as updated
     this->g_geometryNeedUpdate = false;
+    this->g_runNeedUpdate = true;
 
-    // Clear the previous geometry
-    this->g_characters.clear();
     this->g_bounds = sf::FloatRect();
 
     // No text: nothing to draw
     if (this->g_string.empty())
     {
+        this->g_characters.clear();
+        this->g_layout.clear();
+        this->g_validCodePoints = 0;
         return;
     }
 
@@ -486,8 +522,39 @@ void ObjText::ensureGeometryUpdate() const
     float maxY = 0.f;
 
     uint32_t prevChar = 0;
-    for (auto it = this->g_string.begin(); it != this->g_string.end(); ++it)
+
+    auto it = this->g_string.begin();
+
+    // Resume from the first changed code point, if the previous geometry is still valid
+    const std::size_t startIndex = std::min(this->g_validCodePoints, this->g_layout.empty() ? 0 : this->g_layout.size()-1);
+    if (startIndex > 0)
+    {
+        const LayoutState& state = this->g_layout[startIndex];
+        position = state._position;
+        prevChar = state._prevChar;
+        minX = state._minX;
+        minY = state._minY;
+        maxX = state._maxX;
+        maxY = state._maxY;
+
+        this->g_characters.erase(this->g_characters.begin()+static_cast<std::ptrdiff_t>(state._characterCount), this->g_characters.end());
+        this->g_layout.resize(startIndex);
+
+        for (std::size_t i=0; i<startIndex; ++i)
+        {
+            ++it;
+        }
+    }
+    else
+    {
+        this->g_characters.clear();
+        this->g_layout.clear();
+    }
+
+    for (; it != this->g_string.end(); ++it)
     {
+        this->g_layout.push_back({this->g_characters.size(), position, prevChar, minX, minY, maxX, maxY});
+
         uint32_t curChar = static_cast<uint32_t>(*it);
 
         // Skip the \r char to avoid weird graphical issues
@@ -639,6 +706,10 @@ void ObjText::ensureGeometryUpdate() const
         position.x += characterLength;
     }
 
+    // Keep the final state, so a string that only grows can resume from here
+    this->g_layout.push_back({this->g_characters.size(), position, prevChar, minX, minY, maxX, maxY});
+    this->g_validCodePoints = this->g_layout.size()-1;
+
     // If we're using outline, update the current bounds
     if (this->g_outlineThickness != 0.0f)
     {
@@ -656,4 +727,45 @@ void ObjText::ensureGeometryUpdate() const
     this->g_bounds.height = maxY - minY;
 }
 
+void ObjText::ensureRunUpdate() const
+{
+    if (!this->g_runNeedUpdate)
+    {
+        return;
+    }
+    this->g_runNeedUpdate = false;
+
+    this->g_runVertices.clear();
+
+    // Outlines are drawn first, behind every character
+    if (this->g_outlineThickness != 0.0f)
+    {
+        for (const auto& character : this->g_characters)
+        {
+            if (character.isVisible())
+            {
+                const sf::Transform& transform = character.getTransform();
+                for (std::size_t i=0; i<character.g_outlineVertices.getVertexCount(); ++i)
+                {
+                    const sf::Vertex& vertex = character.g_outlineVertices[i];
+                    this->g_runVertices.append({transform.transformPoint(vertex.position), vertex.color, vertex.texCoords});
+                }
+            }
+        }
+    }
+
+    for (const auto& character : this->g_characters)
+    {
+        if (character.isVisible())
+        {
+            const sf::Transform& transform = character.getTransform();
+            for (std::size_t i=0; i<character.g_vertices.getVertexCount(); ++i)
+            {
+                const sf::Vertex& vertex = character.g_vertices[i];
+                this->g_runVertices.append({transform.transformPoint(vertex.position), vertex.color, vertex.texCoords});
+            }
+        }
+    }
+}
+
 }//end fge
@@ -35,6 +35,7 @@ void ObjTextList::first([[maybe_unused]] fge::Scene* scene)
     this->g_text.setFillColor(sf::Color::White);
     this->g_text.setOutlineColor(sf::Color::Black);
     this->g_text.setOutlineThickness(1.0f);
+    this->invalidateTexts();
 }
 void ObjTextList::callbackRegister([[maybe_unused]] fge::Event& event, fge::GuiElementHandler* guiElementHandlerPtr)
 {
@@ -67,15 +68,20 @@ FGE_OBJ_DRAW_BODY(ObjTextList)
 
     float characterHeightOffset = static_cast<float>(this->g_text.getLineSpacing());
 
-    this->g_text.setPosition(4.0f, this->g_box.getSize().y-characterHeightOffset);
+    sf::Vector2f position{4.0f, this->g_box.getSize().y-characterHeightOffset};
+
+    this->g_batch.begin(&target);
     for (std::size_t i=static_cast<std::size_t>(static_cast<float>(this->g_stringList.size()-1)*
             this->getTextScrollRatio()); i < this->g_stringList.size(); ++i)
     {
-        this->g_text.setString(this->g_stringList[i]);
-        target.draw(this->g_text, states);
+        auto& text = this->updateText(i);
+        text.setPosition(position);
+
+        text.drawBatched(this->g_batch, states);
 
-        this->g_text.move(0, -characterHeightOffset);
+        position.y -= characterHeightOffset;
     }
+    this->g_batch.end();
 
     target.setView(backupView);
 }
@@ -101,10 +107,13 @@ sf::FloatRect ObjTextList::getLocalBounds() const
 
 void ObjTextList::addString(tiny_utf8::string string)
 {
+    auto& line = this->g_lines.emplace_front(Line{this->g_text, false});
+    line._text.setString(string);
     this->g_stringList.insert(this->g_stringList.begin(), std::move(string));
     if (this->g_stringList.size() > this->g_maxStrings)
     {
         this->g_stringList.erase(this->g_stringList.end()-1);
+        this->g_lines.pop_back();
     }
 }
 std::size_t ObjTextList::getStringsSize() const
@@ -113,20 +122,27 @@ std::size_t ObjTextList::getStringsSize() const
 }
 tiny_utf8::string& ObjTextList::getString(std::size_t index)
 {
+    this->g_lines[index]._needUpdate = true;
     return this->g_stringList[index];
 }
 const tiny_utf8::string& ObjTextList::getString(std::size_t index) const
 {
     return this->g_stringList[index];
 }
+const fge::ObjText& ObjTextList::getText(std::size_t index) const
+{
+    return this->updateText(index);
+}
 void ObjTextList::removeAllStrings()
 {
     this->g_stringList.clear();
+    this->g_lines.clear();
 }
 
 void ObjTextList::setFont(fge::Font font)
 {
     this->g_text.setFont(std::move(font));
+    this->invalidateTexts();
 }
 const fge::Font& ObjTextList::getFont() const
 {
@@ -161,6 +177,37 @@ std::size_t ObjTextList::getMaxStrings() const
     return this->g_maxStrings;
 }
 
+void ObjTextList::applyTextStyle(fge::ObjText& text) const
+{
+    if (text.getFont().getData() != this->g_text.getFont().getData())
+    {
+        text.setFont(this->g_text.getFont());
+    }
+    text.setCharacterSize(this->g_text.getCharacterSize());
+    text.setFillColor(this->g_text.getFillColor());
+    text.setOutlineColor(this->g_text.getOutlineColor());
+    text.setOutlineThickness(this->g_text.getOutlineThickness());
+}
+
+fge::ObjText& ObjTextList::updateText(std::size_t index) const
+{
+    auto& line = this->g_lines[index];
+    if (line._needUpdate)
+    {
+        line._needUpdate = false;
+        this->applyTextStyle(line._text);
+        line._text.setString(this->g_stringList[index]);
+    }
+    return line._text;
+}
+void ObjTextList::invalidateTexts()
+{
+    for (auto& line : this->g_lines)
+    {
+        line._needUpdate = true;
+    }
+}
+
 void ObjTextList::refreshSize()
 {
     this->refreshSize(this->g_guiElementHandler->_lastSize);
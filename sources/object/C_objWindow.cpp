@@ -106,65 +106,9 @@ FGE_OBJ_DRAW_BODY(ObjWindow)
 
     states.transform *= this->getTransform();
 
-    this->g_sprite.setTexture(this->g_tileSetWindow.getTexture());
-
-    //Fill
-    this->g_sprite.setScale({(this->g_size.x - FGE_WINDOW_PIXEL_SIZE / 2.0f) / FGE_WINDOW_PIXEL_SIZE, (this->g_size.y - FGE_WINDOW_PIXEL_SIZE / 2.0f) / FGE_WINDOW_PIXEL_SIZE});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_FILL).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(FGE_WINDOW_PIXEL_SIZE / 2.0f, FGE_WINDOW_PIXEL_SIZE / 2.0f);
-    target.draw(this->g_sprite, states);
-
-    //Limit
-    this->g_sprite.setScale({this->g_size.x / FGE_WINDOW_PIXEL_SIZE, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_UP_LIMIT).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(0.0f, FGE_WINDOW_DRAW_MOVE_RECTANGLE_HEIGHT - FGE_WINDOW_PIXEL_SIZE);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({this->g_size.x / FGE_WINDOW_PIXEL_SIZE, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_DOWN_LIMIT).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(0.0f, FGE_WINDOW_DRAW_MOVE_RECTANGLE_HEIGHT);
-    target.draw(this->g_sprite, states);
-
-    //Frame
-    this->g_sprite.setScale({1.0f, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_UP_LEFT_CORNER_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(0, 0);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({(this->g_size.x - FGE_WINDOW_PIXEL_SIZE * 2) / FGE_WINDOW_PIXEL_SIZE, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_UP_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(FGE_WINDOW_PIXEL_SIZE, 0);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({1.0f, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_UP_RIGHT_CORNER_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(this->g_size.x - FGE_WINDOW_PIXEL_SIZE, 0);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({1.0f, (this->g_size.y - FGE_WINDOW_PIXEL_SIZE * 2) / FGE_WINDOW_PIXEL_SIZE});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_LEFT_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(0, FGE_WINDOW_PIXEL_SIZE);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({1.0f, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_DOWN_LEFT_CORNER_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(0, this->g_size.y - FGE_WINDOW_PIXEL_SIZE);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({(this->g_size.x - FGE_WINDOW_PIXEL_SIZE * 2) / FGE_WINDOW_PIXEL_SIZE, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_DOWN_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(FGE_WINDOW_PIXEL_SIZE, this->g_size.y - FGE_WINDOW_PIXEL_SIZE);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({1.0f, 1.0f});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_DOWN_RIGHT_CORNER_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(this->g_size.x - FGE_WINDOW_PIXEL_SIZE, this->g_size.y - FGE_WINDOW_PIXEL_SIZE);
-    target.draw(this->g_sprite, states);
-
-    this->g_sprite.setScale({1.0f, (this->g_size.y - FGE_WINDOW_PIXEL_SIZE * 2) / FGE_WINDOW_PIXEL_SIZE});
-    this->g_sprite.setTextureRect( this->g_tileSetWindow.getTextureRect(FGE_WINDOW_DRAW_TILESET_RIGHT_FRAME).value_or(sf::IntRect{}) );
-    this->g_sprite.setPosition(this->g_size.x - FGE_WINDOW_PIXEL_SIZE, FGE_WINDOW_PIXEL_SIZE);
-    target.draw(this->g_sprite, states);
+    //Fill, limits and frame in one draw call
+    this->updateMesh();
+    this->g_mesh.draw(target, states);
 
     //Others
     if (this->g_makeResizable)
@@ -226,6 +170,8 @@ void ObjWindow::setSize(const sf::Vector2f& size)
     this->g_size.x = std::clamp(size.x, static_cast<float>(this->g_textureWindowResize.getTextureSize().x * 3), renderTarget.getDefaultView().getSize().x);
     this->g_size.y = std::clamp(size.y, static_cast<float>(this->g_textureWindowResize.getTextureSize().y) + FGE_WINDOW_DRAW_MOVE_RECTANGLE_HEIGHT, renderTarget.getDefaultView().getSize().y);
 
+    this->g_meshNeedUpdate = true;
+
     this->refreshRectBounds();
     this->_windowHandler._onGuiResized.call(this->_windowHandler, this->getDrawAreaSize());
     this->_windowHandler._lastSize = this->getDrawAreaSize();
@@ -271,7 +217,8 @@ fge::ObjWindow* ObjWindow::getWindowObjectFromScene(fge::Scene* scene)
 {
     if (scene != nullptr)
     {
-        return scene->_properties.getProperty(FGE_OBJWINDOW_SCENE_PARENT_PROPERTY).get<fge::ObjWindow*>().value_or(nullptr);
+        static const fge::PropertyKey key{FGE_OBJWINDOW_SCENE_PARENT_PROPERTY};
+        return scene->_properties.getProperty(key).get<fge::ObjWindow*>().value_or(nullptr);
     }
     return nullptr;
 }
@@ -402,7 +349,7 @@ void ObjWindow::onMouseMoved([[maybe_unused]] const fge::Event& evt, const sf::E
 void ObjWindow::onPlanUpdate([[maybe_unused]] fge::Scene* scene, fge::ObjectPlan plan)
 {
     auto myObjectData = this->_myObjectData.lock();
-    if (myObjectData->getPlan() == plan)
+    if (plan == FGE_SCENE_BAD_PLAN || myObjectData->getPlan() == plan)
     {
         if (myObjectData->getPlanDepth() == FGE_SCENE_BAD_PLANDEPTH)
         {
@@ -456,6 +403,8 @@ const fge::Texture& ObjWindow::getTextureResize() const
 
 fge::TileSet& ObjWindow::getTileSet()
 {
+    //The tileset can be modified, so the mesh must be rebuilt
+    this->g_meshNeedUpdate = true;
     return this->g_tileSetWindow;
 }
 const fge::TileSet& ObjWindow::getTileSet() const
@@ -463,6 +412,41 @@ const fge::TileSet& ObjWindow::getTileSet() const
     return this->g_tileSetWindow;
 }
 
+void ObjWindow::updateMesh() const
+{
+    //The tileset texture can be changed through a kept reference of getTileSet()
+    if (!this->g_meshNeedUpdate && this->g_mesh.getTexture().getData() == this->g_tileSetWindow.getTexture().getData())
+    {
+        return;
+    }
+    this->g_meshNeedUpdate = false;
+
+    const auto getRect = [this](fge::TileId id){ return this->g_tileSetWindow.getTextureRect(id).value_or(sf::IntRect{}); };
+
+    this->g_mesh.setTexture(this->g_tileSetWindow.getTexture());
+    this->g_mesh.setSize(this->g_size);
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_TOP_LEFT, getRect(FGE_WINDOW_DRAW_TILESET_UP_LEFT_CORNER_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_TOP, getRect(FGE_WINDOW_DRAW_TILESET_UP_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_TOP_RIGHT, getRect(FGE_WINDOW_DRAW_TILESET_UP_RIGHT_CORNER_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_LEFT, getRect(FGE_WINDOW_DRAW_TILESET_LEFT_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_RIGHT, getRect(FGE_WINDOW_DRAW_TILESET_RIGHT_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_BOTTOM_LEFT, getRect(FGE_WINDOW_DRAW_TILESET_DOWN_LEFT_CORNER_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_BOTTOM, getRect(FGE_WINDOW_DRAW_TILESET_DOWN_FRAME));
+    this->g_mesh.setSlice(fge::NineSliceMesh::SLICE_BOTTOM_RIGHT, getRect(FGE_WINDOW_DRAW_TILESET_DOWN_RIGHT_CORNER_FRAME));
+
+    //The fill start at half a tile and is covered by the right/bottom borders, like the legacy sprite
+    this->g_mesh.clearExtraPieces();
+    this->g_mesh.addExtraPiece(getRect(FGE_WINDOW_DRAW_TILESET_FILL),
+                               {FGE_WINDOW_PIXEL_SIZE / 2.0f, FGE_WINDOW_PIXEL_SIZE / 2.0f,
+                                this->g_size.x - FGE_WINDOW_PIXEL_SIZE / 2.0f, this->g_size.y - FGE_WINDOW_PIXEL_SIZE / 2.0f});
+
+    //Limits between the move area and the draw area
+    this->g_mesh.addExtraPiece(getRect(FGE_WINDOW_DRAW_TILESET_UP_LIMIT),
+                               {0.0f, FGE_WINDOW_DRAW_MOVE_RECTANGLE_HEIGHT - FGE_WINDOW_PIXEL_SIZE, this->g_size.x, FGE_WINDOW_PIXEL_SIZE});
+    this->g_mesh.addExtraPiece(getRect(FGE_WINDOW_DRAW_TILESET_DOWN_LIMIT),
+                               {0.0f, FGE_WINDOW_DRAW_MOVE_RECTANGLE_HEIGHT, this->g_size.x, FGE_WINDOW_PIXEL_SIZE});
+}
+
 void ObjWindow::refreshRectBounds()
 {
     this->g_windowMoveRect.width = this->g_size.x;
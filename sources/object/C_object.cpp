@@ -49,6 +49,10 @@ void Object::update([[maybe_unused]] sf::RenderWindow& screen, [[maybe_unused]]
 void Object::draw([[maybe_unused]] sf::RenderTarget& target, [[maybe_unused]] sf::RenderStates states) const
 {
 }
+bool Object::drawBatched([[maybe_unused]] fge::SpriteBatch& batch, [[maybe_unused]] sf::RenderStates states) const
+{
+    return false;
+}
 #endif //FGE_DEF_SERVER
 void Object::networkRegister()
 {
@@ -70,9 +74,9 @@ void Object::save(nlohmann::json& jsonObject, [[maybe_unused]] fge::Scene* scene
     jsonObject["_origin"] = this->getOrigin();
 
     jsonObject["tags"] = nlohmann::json::array();
-    for (const auto& tag : this->_tags)
+    for (auto tagId : this->_tags)
     {
-        jsonObject["tags"] += tag;
+        jsonObject["tags"] += std::string{fge::tag::GetTagName(tagId)};
     }
 }
 void Object::load(nlohmann::json& jsonObject, [[maybe_unused]] fge::Scene* scene)
@@ -227,5 +231,19 @@ sf::Vector2f Object::getParentsScale() const
     }
     return parentsScale;
 }
+void Object::invalidateParentsCache() const
+{
+#ifndef FGE_DEF_SERVER
+    if (auto myObject = this->_myObjectData.lock())
+    {
+        auto parent = myObject->getParent().lock();
+        while (parent)
+        {
+            parent->getObject()->_children.invalidateCache();
+            parent = parent->getParent().lock();
+        }
+    }
+#endif //FGE_DEF_SERVER
+}
 
 }//end fge
@@ -0,0 +1,229 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_callback.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+//A callback object that can be removed with delPtr()
+class Callee
+{
+public:
+    void onCall(int value)
+    {
+        CHECK_FALSE(this->_removed.load());
+        this->_sum += value;
+        ++this->_calls;
+    }
+
+    std::atomic<bool> _removed{false};
+    std::atomic<int> _calls{0};
+    std::atomic<int> _sum{0};
+};
+
+void Add(fge::CallbackHandler<int>& handler, Callee& callee)
+{
+    handler.add(new fge::CallbackFunctorObject<Callee, int>(&Callee::onCall, &callee));
+}
+
+}//end
+
+TEST_CASE("testing CallbackHandler add and del during a call")
+{
+    fge::CallbackHandler<int> handler;
+    Callee first;
+    Callee second;
+    Add(handler, second);
+    Add(handler, first);
+
+    SUBCASE("a callback added during a call is called by the next one")
+    {
+        Callee added;
+        std::atomic<int> adds{0};
+        handler.add(new fge::CallbackLambda<int>([&](int){
+            if (adds++ == 0)
+            {
+                Add(handler, added);
+            }
+        }));
+
+        handler.call(1);
+        CHECK(added._calls == 0);
+        handler.call(1);
+        CHECK(added._calls == 1);
+        CHECK(first._calls == 2);
+        CHECK(second._calls == 2);
+    }
+
+    SUBCASE("a callback removed during a call is not called anymore")
+    {
+        //New callbacks are called first, so "first" is called before "second"
+        handler.add(new fge::CallbackLambda<int>([&](int){
+            handler.delPtr(&second);
+            second._removed = true;
+        }));
+
+        handler.call(1);
+        CHECK(first._calls == 1);
+        CHECK(second._calls == 0);
+        handler.call(1);
+        CHECK(first._calls == 2);
+        CHECK(second._calls == 0);
+    }
+
+    SUBCASE("a callback removing itself")
+    {
+        handler.delPtr(&first);
+        handler.delPtr(&second);
+
+        std::atomic<int> calls{0};
+        handler.add(new fge::CallbackLambda<int>([&](int){
+            ++calls;
+            handler.del(nullptr);
+        }));
+
+        handler.call(1);
+        handler.call(1);
+        CHECK(calls == 1);
+    }
+
+    SUBCASE("removed from a nested call")
+    {
+        std::atomic<int> depth{0};
+        handler.add(new fge::CallbackLambda<int>([&](int value){
+            if (++depth == 1)
+            {
+                handler.call(value+1);
+            }
+            else
+            {
+                handler.delPtr(&first);
+                first._removed = true;
+            }
+            --depth;
+        }));
+
+        handler.call(1);
+        //The nested call is done before "first" is reached by the outer one
+        CHECK(first._calls == 0);
+        CHECK(second._calls == 2);
+        CHECK(second._sum == 3);
+    }
+
+    handler.clear();
+}
+
+TEST_CASE("testing CallbackHandler removal from another handler")
+{
+    fge::CallbackHandler<int> handler;
+    fge::CallbackHandler<int> otherHandler;
+
+    std::atomic<bool> inside{false};
+    std::atomic<bool> release{false};
+    std::atomic<bool> done{false};
+    handler.add(new fge::CallbackLambda<int>([&](int){
+        inside = true;
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(50ms);
+        done = true;
+    }));
+
+    std::thread thread([&](){
+        handler.call(1);
+    });
+    while (!inside)
+    {
+        std::this_thread::yield();
+    }
+
+    //A removal from a callback of another handler still wait for the calls in progress
+    otherHandler.add(new fge::CallbackLambda<int>([&](int){
+        release = true;
+        handler.del(nullptr);
+        CHECK(done.load());
+    }));
+    otherHandler.call(1);
+
+    thread.join();
+}
+
+TEST_CASE("testing CallbackHandler removal waiting for every call in progress")
+{
+    fge::CallbackHandler<int> handler;
+
+    constexpr int threadCount = 3;
+    std::atomic<int> inside{0};
+    std::atomic<int> done{0};
+    handler.add(new fge::CallbackLambda<int>([&](int){
+        ++inside;
+        std::this_thread::sleep_for(50ms);
+        ++done;
+    }));
+
+    std::vector<std::thread> threads;
+    for (int i=0; i<threadCount; ++i)
+    {
+        threads.emplace_back([&](){
+            handler.call(1);
+        });
+    }
+    while (inside != threadCount)
+    {
+        std::this_thread::yield();
+    }
+
+    //The removal is woken up by the last call leaving
+    handler.del(nullptr);
+    CHECK(done == threadCount);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST_CASE("testing CallbackHandler concurrent del and call")
+{
+    fge::CallbackHandler<int> handler;
+    std::atomic<bool> running{true};
+
+    std::vector<std::thread> threads;
+    for (int i=0; i<2; ++i)
+    {
+        threads.emplace_back([&](){
+            while (running)
+            {
+                handler.call(1);
+            }
+        });
+    }
+
+    for (int i=0; i<200; ++i)
+    {
+        auto callee = std::make_unique<Callee>();
+        Add(handler, *callee);
+        std::this_thread::sleep_for(100us);
+
+        //Once removed, the callback must not be running in any thread
+        handler.delPtr(callee.get());
+        callee->_removed = true;
+        const int calls = callee->_calls;
+        std::this_thread::sleep_for(10us);
+        CHECK(callee->_calls == calls);
+    }
+
+    running = false;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
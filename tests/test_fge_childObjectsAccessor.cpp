@@ -0,0 +1,150 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_scene.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <cstdlib>
+#include <memory>
+
+namespace
+{
+
+//The cache is a render texture, so an OpenGL context (and a display on Linux) is needed
+bool CanRender()
+{
+#ifdef __linux__
+    return std::getenv("DISPLAY") != nullptr;
+#else
+    return true;
+#endif
+}
+
+//A colored square that draw its children over it
+class Quad : public fge::Object
+{
+public:
+    Quad(float size, const sf::Color& color) :
+            g_size(size),
+            g_color(color)
+    {}
+
+    void setColor(const sf::Color& color)
+    {
+        this->g_color = color;
+        this->invalidateParentsCache();
+    }
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override
+    {
+        states.transform *= this->getTransform();
+
+        const sf::Vertex vertices[4]{
+            {{0.0f, 0.0f}, this->g_color},
+            {{0.0f, this->g_size}, this->g_color},
+            {{this->g_size, 0.0f}, this->g_color},
+            {{this->g_size, this->g_size}, this->g_color}
+        };
+        target.draw(vertices, 4, sf::TriangleStrip, states);
+
+        this->_children.draw(target, states);
+    }
+
+    sf::FloatRect getLocalBounds() const override
+    {
+        return {0.0f, 0.0f, this->g_size, this->g_size};
+    }
+
+private:
+    float g_size;
+    sf::Color g_color;
+};
+
+sf::Color RenderPixel(const fge::Object& object, sf::RenderTexture& target, unsigned int x, unsigned int y)
+{
+    target.clear(sf::Color::Black);
+    object.draw(target, sf::RenderStates::Default);
+    target.display();
+    return target.getTexture().copyToImage().getPixel(x, y);
+}
+
+}//end
+
+TEST_CASE("testing ChildObjectsAccessor cache budget")
+{
+    const std::size_t budget = fge::ChildObjectsAccessor::GetCacheMemoryBudget();
+    CHECK(budget == FGE_CHILDOBJECTS_DEFAULT_CACHE_BUDGET);
+
+    fge::ChildObjectsAccessor accessor;
+    CHECK_FALSE(accessor.isCacheEnabled());
+    accessor.setCacheEnabled(true);
+    CHECK(accessor.isCacheEnabled());
+
+    //Nothing is allocated before the first draw
+    CHECK(fge::ChildObjectsAccessor::GetCacheMemoryUsage() == 0);
+
+    fge::ChildObjectsAccessor::SetCacheMemoryBudget(1024);
+    CHECK(fge::ChildObjectsAccessor::GetCacheMemoryBudget() == 1024);
+    fge::ChildObjectsAccessor::SetCacheMemoryBudget(budget);
+
+    accessor.setCacheEnabled(false);
+    CHECK_FALSE(accessor.isCacheEnabled());
+}
+
+TEST_CASE("testing ChildObjectsAccessor render cache")
+{
+    if (!CanRender())
+    {
+        MESSAGE("no display, the cache can't be rendered");
+        return;
+    }
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(64, 64));
+
+    fge::Scene scene;
+    auto parentData = scene.newObject(std::make_unique<Quad>(8.0f, sf::Color::Blue));
+    auto* parent = static_cast<Quad*>(parentData->getObject());
+
+    auto* child = new Quad(4.0f, sf::Color::Red);
+    parent->_children.addNewObject(parentData, fge::ObjectPtr{child}, &scene);
+    auto* grandChild = new Quad(2.0f, sf::Color::Green);
+    child->_children.addNewObject(parent->_children.getSharedPtr(0), fge::ObjectPtr{grandChild}, &scene);
+
+    parent->_children.setCacheEnabled(true);
+
+    CHECK(RenderPixel(*parent, target, 3, 3) == sf::Color::Red);
+    CHECK(RenderPixel(*parent, target, 0, 0) == sf::Color::Green);
+    CHECK(fge::ChildObjectsAccessor::GetCacheMemoryUsage() == 4*4*4);
+
+    SUBCASE("a content change of a child is propagated to the cache")
+    {
+        grandChild->setColor(sf::Color::White);
+        CHECK(RenderPixel(*parent, target, 0, 0) == sf::Color::White);
+
+        child->setColor(sf::Color::Yellow);
+        CHECK(RenderPixel(*parent, target, 3, 3) == sf::Color::Yellow);
+    }
+
+    SUBCASE("a moved child must be notified")
+    {
+        grandChild->setPosition(2.0f, 2.0f);
+        grandChild->invalidateParentsCache();
+        CHECK(RenderPixel(*parent, target, 0, 0) == sf::Color::Red);
+        CHECK(RenderPixel(*parent, target, 3, 3) == sf::Color::Green);
+    }
+
+    SUBCASE("removing a child invalidate the cache")
+    {
+        child->_children.remove(0);
+        CHECK(RenderPixel(*parent, target, 0, 0) == sf::Color::Red);
+    }
+
+    SUBCASE("a scaled parent use a texture at the target resolution")
+    {
+        parent->setScale(4.0f, 4.0f);
+        CHECK(RenderPixel(*parent, target, 13, 13) == sf::Color::Red);
+        CHECK(RenderPixel(*parent, target, 7, 7) == sf::Color::Green);
+        CHECK(fge::ChildObjectsAccessor::GetCacheMemoryUsage() == 16*16*4);
+    }
+
+    parent->_children.setCacheEnabled(false);
+    CHECK(fge::ChildObjectsAccessor::GetCacheMemoryUsage() == 0);
+}
@@ -0,0 +1,308 @@
+#include <doctest/doctest.h>
+#include <FastEngine/object/C_lightObstacle.hpp>
+#include <FastEngine/C_threadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+class TestObstacle : public fge::LightObstacle
+{
+public:
+    void setRect(const sf::FloatRect& rect)
+    {
+        this->_g_myPoints = {{rect.left, rect.top},
+                             {rect.left+rect.width, rect.top},
+                             {rect.left+rect.width, rect.top+rect.height},
+                             {rect.left, rect.top+rect.height}};
+        this->invalidateObstacle();
+    }
+    void setEmpty()
+    {
+        this->_g_myPoints.clear();
+        this->invalidateObstacle();
+    }
+
+    [[nodiscard]] const fge::ListOfPoints& getPoints() const
+    {
+        return this->_g_myPoints;
+    }
+};
+
+using Obstacles = std::vector<std::unique_ptr<TestObstacle> >;
+
+//A light that only count its shadow computations
+class TestLight : public fge::LightComponent
+{
+public:
+    explicit TestLight(const sf::FloatRect& bounds) :
+            g_bounds(bounds)
+    {}
+
+    void move()
+    {
+        this->invalidateLight();
+    }
+    void moveWithoutUpdate()
+    {
+        this->invalidateLightOnly();
+    }
+
+    sf::FloatRect getLightBounds() const override
+    {
+        return this->g_bounds;
+    }
+    void computeShadows([[maybe_unused]] const fge::LightSystem& lightSystem, [[maybe_unused]] fge::ShadowScratch& scratch) const override
+    {
+        ++this->_computeCount;
+    }
+
+    mutable std::atomic<int> _computeCount{0};
+
+private:
+    sf::FloatRect g_bounds;
+};
+
+//Same inclusive test as the light system, on every obstacle
+std::vector<fge::LightObstacle*> BruteForce(const Obstacles& obstacles, const sf::FloatRect& rect)
+{
+    std::vector<fge::LightObstacle*> result;
+    for (const auto& obstacle : obstacles)
+    {
+        const auto& points = obstacle->getPoints();
+        if (points.empty())
+        {
+            continue;
+        }
+
+        sf::Vector2f min = points.front();
+        sf::Vector2f max = min;
+        for (const auto& point : points)
+        {
+            min.x = std::min(min.x, point.x);
+            min.y = std::min(min.y, point.y);
+            max.x = std::max(max.x, point.x);
+            max.y = std::max(max.y, point.y);
+        }
+
+        if (min.x <= rect.left+rect.width && max.x >= rect.left &&
+            min.y <= rect.top+rect.height && max.y >= rect.top)
+        {
+            result.push_back(obstacle.get());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<fge::LightObstacle*> Query(fge::LightSystem& lightSystem, const sf::FloatRect& rect)
+{
+    std::vector<fge::LightObstacle*> result;
+    lightSystem.updateIndex();
+    const std::size_t count = lightSystem.getObstacles(rect, result);
+    CHECK(count == result.size());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+sf::FloatRect RandomRect(std::mt19937& generator)
+{
+    std::uniform_real_distribution<float> position{-200.0f, 200.0f};
+    std::uniform_real_distribution<float> size{0.0f, 60.0f};
+    return {position(generator), position(generator), size(generator), size(generator)};
+}
+
+void CheckQueries(fge::LightSystem& lightSystem, const Obstacles& obstacles, std::mt19937& generator)
+{
+    std::uniform_real_distribution<float> size{0.0f, 150.0f};
+    for (int i=0; i<50; ++i)
+    {
+        sf::FloatRect rect = RandomRect(generator);
+        rect.width = size(generator);
+        rect.height = size(generator);
+        CAPTURE(i);
+
+        const auto result = Query(lightSystem, rect);
+        //Every obstacle is present only once
+        CHECK(std::adjacent_find(result.begin(), result.end()) == result.end());
+        CHECK(result == BruteForce(obstacles, rect));
+    }
+}
+
+}//end
+
+TEST_CASE("testing LightSystem spatial index")
+{
+    std::mt19937 generator{42};
+
+    fge::LightSystem lightSystem;
+    lightSystem.setCellSize(32.0f);
+
+    Obstacles obstacles;
+    for (int i=0; i<100; ++i)
+    {
+        auto obstacle = std::make_unique<TestObstacle>();
+        obstacle->setRect(RandomRect(generator));
+        obstacle->setLightSystem(lightSystem);
+        obstacles.push_back(std::move(obstacle));
+    }
+
+    CheckQueries(lightSystem, obstacles, generator);
+
+    SUBCASE("an obstacle spanning several cells is reported once")
+    {
+        auto& big = obstacles.front();
+        big->setRect({-100.0f, -100.0f, 200.0f, 200.0f});
+
+        const auto result = Query(lightSystem, {-150.0f, -150.0f, 300.0f, 300.0f});
+        CHECK(std::count(result.begin(), result.end(), big.get()) == 1);
+        CHECK(result == BruteForce(obstacles, {-150.0f, -150.0f, 300.0f, 300.0f}));
+
+        //A query starting inside the obstacle
+        const auto inside = Query(lightSystem, {10.0f, 10.0f, 80.0f, 80.0f});
+        CHECK(std::count(inside.begin(), inside.end(), big.get()) == 1);
+    }
+
+    SUBCASE("a flat obstacle is found by the inclusive test")
+    {
+        auto& line = obstacles.front();
+        line->setRect({500.0f, 500.0f, 100.0f, 0.0f});
+
+        const auto result = Query(lightSystem, {550.0f, 490.0f, 10.0f, 10.0f});
+        REQUIRE(result.size() == 1);
+        CHECK(result.front() == line.get());
+    }
+
+    SUBCASE("moved obstacles are updated incrementally")
+    {
+        for (int step=0; step<5; ++step)
+        {
+            for (std::size_t i=0; i<obstacles.size(); i+=7)
+            {
+                obstacles[i]->setRect(RandomRect(generator));
+            }
+            CheckQueries(lightSystem, obstacles, generator);
+        }
+    }
+
+    SUBCASE("most obstacles moved")
+    {
+        for (auto& obstacle : obstacles)
+        {
+            obstacle->setRect(RandomRect(generator));
+        }
+        CheckQueries(lightSystem, obstacles, generator);
+    }
+
+    SUBCASE("emptied obstacles are removed")
+    {
+        obstacles[3]->setEmpty();
+        obstacles[50]->setEmpty();
+        CheckQueries(lightSystem, obstacles, generator);
+
+        const auto result = Query(lightSystem, {-1000.0f, -1000.0f, 2000.0f, 2000.0f});
+        CHECK(result.size() == obstacles.size()-2);
+        CHECK(std::count(result.begin(), result.end(), obstacles[3].get()) == 0);
+
+        SUBCASE("and come back")
+        {
+            obstacles[3]->setRect({0.0f, 0.0f, 10.0f, 10.0f});
+            CheckQueries(lightSystem, obstacles, generator);
+            const auto back = Query(lightSystem, {0.0f, 0.0f, 1.0f, 1.0f});
+            CHECK(std::count(back.begin(), back.end(), obstacles[3].get()) == 1);
+        }
+    }
+
+    SUBCASE("added and destroyed obstacles")
+    {
+        obstacles.erase(obstacles.begin()+10, obstacles.begin()+20);
+        CheckQueries(lightSystem, obstacles, generator);
+
+        auto obstacle = std::make_unique<TestObstacle>();
+        obstacle->setRect({-5.0f, -5.0f, 10.0f, 10.0f});
+        obstacle->setLightSystem(lightSystem);
+        obstacles.push_back(std::move(obstacle));
+        CheckQueries(lightSystem, obstacles, generator);
+    }
+
+    SUBCASE("cell size change")
+    {
+        lightSystem.setCellSize(7.0f);
+        CheckQueries(lightSystem, obstacles, generator);
+    }
+}
+
+TEST_CASE("testing LightSystem batched shadows")
+{
+    fge::ThreadPool threadPool{2};
+    fge::LightSystem lightSystem;
+
+    const sf::FloatRect visibleArea{0.0f, 0.0f, 100.0f, 100.0f};
+
+    std::vector<std::unique_ptr<TestLight> > lights;
+    for (int i=0; i<10; ++i)
+    {
+        //The last light is outside the visible area
+        const float position = i < 9 ? static_cast<float>(i)*10.0f : 500.0f;
+        lights.push_back(std::make_unique<TestLight>(sf::FloatRect{position, position, 10.0f, 10.0f}));
+        lights.back()->setLightSystem(lightSystem);
+    }
+    REQUIRE(lightSystem.getLightsSize() == 10);
+
+    auto totalCount = [&](){
+        int count = 0;
+        for (auto& light : lights)
+        {
+            count += light->_computeCount.exchange(0);
+        }
+        return count;
+    };
+
+    SUBCASE("on the calling thread") {}
+    SUBCASE("on a thread pool")
+    {
+        lightSystem.setThreadPool(&threadPool);
+    }
+
+    //Only the visible lights are computed by the batched pass
+    lightSystem.computeShadows(visibleArea);
+    CHECK(totalCount() == 9);
+    lightSystem.computeShadows(*lights.back());
+    CHECK(totalCount() == 1);
+
+    //Nothing have changed
+    lightSystem.computeShadows(visibleArea);
+    for (auto& light : lights)
+    {
+        lightSystem.computeShadows(*light);
+    }
+    CHECK(totalCount() == 0);
+
+    //Every light moved before the draws is computed by one pass
+    lights[1]->move();
+    lights[4]->move();
+    lights[7]->move();
+    lightSystem.computeShadows(visibleArea);
+    CHECK(lights[1]->_computeCount == 1);
+    CHECK(lights[4]->_computeCount == 1);
+    CHECK(lights[7]->_computeCount == 1);
+    for (auto& light : lights)
+    {
+        lightSystem.computeShadows(visibleArea);
+        lightSystem.computeShadows(*light);
+    }
+    CHECK(totalCount() == 3);
+
+    //A light moved during the draws don't start the batched pass again
+    lights[2]->moveWithoutUpdate();
+    lightSystem.computeShadows(visibleArea);
+    CHECK(totalCount() == 0);
+    lightSystem.computeShadows(*lights[2]);
+    CHECK(totalCount() == 1);
+
+    lightSystem.setThreadPool(nullptr);
+}
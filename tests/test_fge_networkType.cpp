@@ -0,0 +1,56 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_networkType.hpp>
+#include <string>
+
+TEST_CASE("testing NetworkTypeProperty inside a growing PropertyList")
+{
+    static const fge::PropertyKey key{"networkValue"};
+
+    fge::PropertyList list;
+    list[key] = 1;
+    fge::net::NetworkTypeProperty<fge::PintType> networkType{&list, key};
+    CHECK(networkType.getSource() == &list);
+
+    //Other properties are inserted before and after, so the property is moved
+    for (int32_t i=0; i<100; ++i)
+    {
+        list.setProperty("before"+std::to_string(i), i);
+    }
+    list[key] = 42;
+    list.clearAllModificationFlags();
+
+    fge::net::Packet pck;
+    networkType.packData(pck);
+    CHECK_FALSE(networkType.check());
+    networkType.forceCheck();
+    CHECK(networkType.check());
+    CHECK(list[key].isModified());
+
+    for (int32_t i=0; i<100; ++i)
+    {
+        list.setProperty("after"+std::to_string(i), i);
+    }
+    list[key] = 0;
+
+    CHECK(networkType.applyData(pck));
+    CHECK(list[key].get<fge::PintType>() == 42);
+}
+
+TEST_CASE("testing NetworkTypePropertyList with a key")
+{
+    static const fge::PropertyKey key{"networkListValue"};
+
+    fge::PropertyList list;
+    fge::net::NetworkTypePropertyList<fge::PintType> networkType{&list, key};
+    CHECK(list.checkProperty(key));
+    CHECK(networkType.getValueName() == "networkListValue");
+
+    list[key] = 7;
+    fge::net::Packet pck;
+    networkType.packData(pck);
+    list.setProperty("other", 1);
+    list[key] = 0;
+
+    networkType.applyData(pck);
+    CHECK(list[key].get<fge::PintType>() == 7);
+}
@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_nineSliceMesh.hpp>
+#include <memory>
+
+namespace
+{
+
+//Only the texture area is used to build the geometry, so no texture is created
+fge::texture::TextureDataPtr MakeTextureData(const sf::IntRect& rect)
+{
+    auto data = std::make_shared<fge::texture::TextureData>();
+    data->_valid = true;
+    data->_rect = rect;
+    return data;
+}
+
+//A 12x12 texture cut in 4x4 slices
+void SetSlices(fge::NineSliceMesh& mesh)
+{
+    for (int y=0; y<3; ++y)
+    {
+        for (int x=0; x<3; ++x)
+        {
+            mesh.setSlice(static_cast<fge::NineSliceMesh::Slices>(y*3+x), {x*4, y*4, 4, 4});
+        }
+    }
+}
+
+//Every piece is 6 vertices, the first one is the top left corner of its area
+sf::FloatRect GetPieceArea(const fge::NineSliceMesh& mesh, std::size_t piece)
+{
+    const auto& vertices = mesh.getVertices();
+    const sf::Vector2f& topLeft = vertices[piece*6].position;
+    const sf::Vector2f& bottomRight = vertices[piece*6+5].position;
+    return {topLeft, bottomRight-topLeft};
+}
+
+}//end
+
+TEST_CASE("testing NineSliceMesh geometry")
+{
+    fge::NineSliceMesh mesh;
+    mesh.setTexture(fge::Texture{MakeTextureData({0, 0, 12, 12})});
+
+    CHECK(mesh.getVertexCount() == 0);
+
+    SetSlices(mesh);
+    mesh.setSize({20.0f, 16.0f});
+
+    SUBCASE("every piece is built")
+    {
+        REQUIRE(mesh.getVertexCount() == 9*6);
+
+        //Center, then edges (top, bottom, left, right), then corners
+        CHECK(GetPieceArea(mesh, 0) == sf::FloatRect{4.0f, 4.0f, 12.0f, 8.0f});
+        CHECK(GetPieceArea(mesh, 1) == sf::FloatRect{4.0f, 0.0f, 12.0f, 4.0f});
+        CHECK(GetPieceArea(mesh, 4) == sf::FloatRect{16.0f, 4.0f, 4.0f, 8.0f});
+        CHECK(GetPieceArea(mesh, 6) == sf::FloatRect{16.0f, 0.0f, 4.0f, 4.0f});
+        CHECK(GetPieceArea(mesh, 8) == sf::FloatRect{16.0f, 12.0f, 4.0f, 4.0f});
+
+        //The top right corner keep its texture size
+        const auto& vertices = mesh.getVertices();
+        CHECK(vertices[6*6].texCoords == sf::Vector2f{8.0f, 0.0f});
+        CHECK(vertices[6*6+5].texCoords == sf::Vector2f{12.0f, 4.0f});
+    }
+
+    SUBCASE("a frame smaller than its borders only have corners")
+    {
+        mesh.setSize({8.0f, 8.0f});
+        CHECK(mesh.getVertexCount() == 4*6);
+    }
+
+    SUBCASE("center margin")
+    {
+        mesh.setCenterMargin(2.0f);
+        REQUIRE(mesh.getVertexCount() == 9*6);
+        CHECK(GetPieceArea(mesh, 0) == sf::FloatRect{2.0f, 2.0f, 16.0f, 12.0f});
+    }
+
+    SUBCASE("extra pieces are drawn after the center")
+    {
+        mesh.addExtraPiece({0, 0, 4, 4}, {0.0f, 6.0f, 20.0f, 2.0f});
+        REQUIRE(mesh.getVertexCount() == 10*6);
+        CHECK(GetPieceArea(mesh, 1) == sf::FloatRect{0.0f, 6.0f, 20.0f, 2.0f});
+
+        mesh.clearExtraPieces();
+        CHECK(mesh.getVertexCount() == 9*6);
+    }
+
+    SUBCASE("color")
+    {
+        REQUIRE(mesh.getVertexCount() > 0);
+        mesh.setColor(sf::Color::Red);
+        for (const auto& vertex : mesh.getVertices())
+        {
+            CHECK(vertex.color == sf::Color::Red);
+        }
+    }
+}
+
+TEST_CASE("testing NineSliceMesh atlas texture")
+{
+    auto data = MakeTextureData({0, 0, 12, 12});
+
+    fge::NineSliceMesh mesh;
+    mesh.setTexture(fge::Texture{data});
+    SetSlices(mesh);
+    mesh.setSize({20.0f, 16.0f});
+
+    REQUIRE(mesh.getVertexCount() == 9*6);
+    CHECK(mesh.getVertices()[0].texCoords == sf::Vector2f{4.0f, 4.0f});
+
+    //The texture is packed in an atlas page after the first build
+    data->_rect = {100, 50, 12, 12};
+
+    REQUIRE(mesh.getVertexCount() == 9*6);
+    CHECK(mesh.getVertices()[0].texCoords == sf::Vector2f{104.0f, 54.0f});
+    CHECK(mesh.getVertices()[5].texCoords == sf::Vector2f{108.0f, 58.0f});
+}
@@ -0,0 +1,366 @@
+#include <doctest/doctest.h>
+#include <FastEngine/extra/extra_pathFinding.hpp>
+#include <FastEngine/extra/extra_pathService.hpp>
+#include <FastEngine/extra/extra_flowField.hpp>
+#include <FastEngine/C_tilelayer.hpp>
+#include <algorithm>
+#include <memory>
+
+TEST_CASE("testing AStar generator")
+{
+    fge::AStar::Generator generator;
+    generator.setWorldSize({10, 10});
+
+    SUBCASE("straight path")
+    {
+        auto path = generator.findPath({0, 0}, {9, 0});
+        REQUIRE(path.size() == 10);
+        REQUIRE(path.front() == fge::AStar::Vector2i(0, 0));
+        REQUIRE(path.back() == fge::AStar::Vector2i(9, 0));
+    }
+
+    SUBCASE("path around a wall")
+    {
+        for (int32_t y=0; y<9; ++y)
+        {
+            generator.addCollision({5, y});
+        }
+        REQUIRE(generator.detectCollision({5, 0}));
+
+        auto path = generator.findPath({0, 0}, {9, 0});
+        //Down to the opening at y=9 and back up
+        REQUIRE(path.size() == 28);
+        for (const auto& coord : path)
+        {
+            REQUIRE_FALSE(generator.detectCollision(coord));
+        }
+
+        //Same query again, nothing is cleared between queries
+        REQUIRE(generator.findPath({0, 0}, {9, 0}) == path);
+
+        generator.addCollision({5, 9});
+        REQUIRE(generator.findPath({0, 0}, {9, 0}).empty());
+
+        generator.removeCollision({5, 4});
+        REQUIRE(generator.findPath({0, 0}, {9, 0}).size() == 18);
+    }
+
+    SUBCASE("collisions are kept when resizing")
+    {
+        generator.addCollision({2, 2});
+        generator.addCollision({8, 8});
+        generator.setWorldSize({5, 5});
+        REQUIRE(generator.detectCollision({2, 2}));
+        REQUIRE(generator.detectCollision({8, 8})); //Outside of the world
+        generator.setWorldSize({10, 10});
+        REQUIRE_FALSE(generator.detectCollision({8, 8}));
+    }
+
+    SUBCASE("invalid queries")
+    {
+        generator.addCollision({3, 3});
+        REQUIRE(generator.findPath({0, 0}, {3, 3}).empty());
+        REQUIRE(generator.findPath({-1, 0}, {3, 4}).empty());
+        REQUIRE(generator.findPath({0, 0}, {10, 0}).empty());
+        REQUIRE(generator.findPath({4, 4}, {4, 4}).size() == 1);
+    }
+
+    SUBCASE("search strategies")
+    {
+        generator.setWorldSize({40, 40});
+        generator.setDiagonalMovement(true);
+        generator.setHeuristic(&fge::AStar::Heuristic::octagonal);
+        for (int32_t y=0; y<35; ++y)
+        {
+            generator.addCollision({20, y});
+        }
+
+        auto getCost = [](const fge::AStar::CoordinateList& path){
+            unsigned int cost = 0;
+            for (std::size_t i=1; i<path.size(); ++i)
+            {
+                cost += (path[i].x != path[i-1].x && path[i].y != path[i-1].y) ? 14 : 10;
+            }
+            return cost;
+        };
+
+        const auto path = generator.findPath({2, 2}, {38, 2});
+        REQUIRE_FALSE(path.empty());
+
+        generator.setStrategy(fge::AStar::Generator::Strategies::STRATEGY_JUMP_POINT);
+        const auto jumpPointPath = generator.findPath({2, 2}, {38, 2});
+        REQUIRE(getCost(jumpPointPath) == getCost(path));
+        REQUIRE(jumpPointPath.front() == fge::AStar::Vector2i(2, 2));
+        REQUIRE(jumpPointPath.back() == fge::AStar::Vector2i(38, 2));
+
+        generator.setStrategy(fge::AStar::Generator::Strategies::STRATEGY_HIERARCHICAL);
+        generator.setClusterSize(8);
+        auto hierarchicalPath = generator.findPath({2, 2}, {38, 2});
+        REQUIRE(getCost(hierarchicalPath) >= getCost(path));
+        for (const auto& coord : hierarchicalPath)
+        {
+            REQUIRE_FALSE(generator.detectCollision(coord));
+        }
+
+        //Clusters are updated with the collisions
+        for (int32_t y=35; y<40; ++y)
+        {
+            generator.addCollision({20, y});
+        }
+        REQUIRE(generator.findPath({2, 2}, {38, 2}).empty());
+        generator.removeCollision({20, 37});
+        hierarchicalPath = generator.findPath({2, 2}, {38, 2});
+        REQUIRE(std::find(hierarchicalPath.begin(), hierarchicalPath.end(), fge::AStar::Vector2i(20, 37)) != hierarchicalPath.end());
+    }
+
+    SUBCASE("external collision bitmap")
+    {
+        //A wall on the column 5 except for the last row
+        auto collisions = std::make_shared<std::vector<uint64_t> >(2, 0);
+        for (std::size_t y=0; y<9; ++y)
+        {
+            const std::size_t index = y*10 + 5;
+            (*collisions)[index/64] |= uint64_t{1} << (index%64);
+        }
+        generator.setCollisions({10, 10}, collisions);
+        REQUIRE(generator.detectCollision({5, 0}));
+        REQUIRE(generator.findPath({0, 0}, {9, 0}).size() == 28);
+
+        //Modifications are done on a copy
+        generator.removeCollision({5, 0});
+        REQUIRE_FALSE(generator.detectCollision({5, 0}));
+        REQUIRE(((*collisions)[0] >> 5) & 1);
+
+        //Too small
+        generator.setCollisions({20, 20}, collisions);
+        REQUIRE(generator.getWorldSize() == fge::AStar::Vector2i(10, 10));
+
+        //The provided bitmap is never modified, even when the caller doesn't keep it
+        std::weak_ptr<const std::vector<uint64_t> > weakCollisions = collisions;
+        generator.setCollisions({10, 10}, std::move(collisions));
+        generator.addCollision({0, 9});
+        REQUIRE(weakCollisions.expired());
+        REQUIRE(generator.detectCollision({0, 9}));
+    }
+
+    SUBCASE("a new collision bitmap only invalidate the changed cells")
+    {
+        generator.setWorldSize({40, 40});
+        generator.setStrategy(fge::AStar::Generator::Strategies::STRATEGY_HIERARCHICAL);
+        generator.setClusterSize(8);
+
+        auto makeWall = [](int32_t holeY){
+            auto collisions = std::make_shared<std::vector<uint64_t> >((40*40+63)/64, 0);
+            for (int32_t y=0; y<40; ++y)
+            {
+                if (y != holeY)
+                {
+                    const auto index = static_cast<std::size_t>(y*40 + 20);
+                    (*collisions)[index/64] |= uint64_t{1} << (index%64);
+                }
+            }
+            return collisions;
+        };
+
+        generator.setCollisions({40, 40}, makeWall(3));
+        REQUIRE_FALSE(generator.findPath({2, 2}, {38, 2}).empty());
+
+        generator.setCollisions({40, 40}, makeWall(30));
+        fge::AStar::Generator fresh;
+        fresh.shareCollisions(generator);
+
+        const auto path = generator.findPath({2, 2}, {38, 2});
+        REQUIRE(std::find(path.begin(), path.end(), fge::AStar::Vector2i(20, 30)) != path.end());
+        REQUIRE(path == fresh.findPath({2, 2}, {38, 2}));
+    }
+
+    SUBCASE("shared collisions follow the changes")
+    {
+        generator.setWorldSize({40, 40});
+        generator.setStrategy(fge::AStar::Generator::Strategies::STRATEGY_HIERARCHICAL);
+        generator.setClusterSize(8);
+        for (int32_t y=0; y<39; ++y)
+        {
+            generator.addCollision({20, y});
+        }
+
+        fge::AStar::Generator worker;
+        worker.shareCollisions(generator);
+        REQUIRE(worker.findPath({2, 2}, {38, 2}).size() == generator.findPath({2, 2}, {38, 2}).size());
+
+        //Only the changed clusters are rebuilt, the result must be the same as a full rebuild
+        generator.addCollision({20, 39});
+        generator.removeCollision({20, 17});
+        worker.shareCollisions(generator);
+        REQUIRE_FALSE(worker.detectCollision({20, 17}));
+
+        fge::AStar::Generator fresh;
+        fresh.shareCollisions(generator);
+        const auto path = worker.findPath({2, 2}, {38, 2});
+        REQUIRE(std::find(path.begin(), path.end(), fge::AStar::Vector2i(20, 17)) != path.end());
+        REQUIRE(path == fresh.findPath({2, 2}, {38, 2}));
+
+        //A worker that modified its own collisions doesn't follow the shared history anymore
+        worker.addCollision({20, 17});
+        REQUIRE(worker.findPath({2, 2}, {38, 2}).empty());
+        generator.addCollision({0, 0});
+        worker.shareCollisions(generator);
+        REQUIRE_FALSE(worker.detectCollision({20, 17}));
+        REQUIRE(worker.findPath({2, 2}, {38, 2}) == path);
+    }
+}
+
+TEST_CASE("testing AStar path service")
+{
+    fge::AStar::PathService service;
+    service.getGenerator().setWorldSize({20, 20});
+    for (int32_t y=0; y<19; ++y)
+    {
+        service.getGenerator().addCollision({10, y});
+    }
+
+    std::vector<fge::AStar::QueryId> results;
+    service._onPathFound.add(new fge::CallbackLambda<fge::AStar::QueryId, const fge::AStar::CoordinateList&>(
+            [&](fge::AStar::QueryId id, const fge::AStar::CoordinateList& path){
+        REQUIRE_FALSE(path.empty());
+        results.push_back(id);
+    }));
+
+    SUBCASE("without thread pool")
+    {
+        const auto id = service.request({0, 0}, {19, 0});
+        REQUIRE(id != FGE_PATHSERVICE_BAD_QUERY);
+        REQUIRE(service.getPendingCount() == 1);
+        REQUIRE(service.process() == 1);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results.front() == id);
+    }
+
+    SUBCASE("with thread pool")
+    {
+        fge::ThreadPool pool(2);
+        service.setThreadPool(&pool);
+        service.setDeduplicationRadius(1);
+
+        std::size_t callbackCount = 0;
+        for (int32_t i=0; i<16; ++i)
+        {
+            service.request({i%4, i/4}, {19, 0},
+                            new fge::CallbackLambda<fge::AStar::QueryId, const fge::AStar::CoordinateList&>(
+                                    [&](fge::AStar::QueryId, const fge::AStar::CoordinateList&){
+                ++callbackCount;
+            }));
+        }
+        REQUIRE(service.process() == 0);
+        service.wait();
+        REQUIRE(service.process() == 16);
+        REQUIRE(results.size() == 16);
+        REQUIRE(callbackCount == 16);
+    }
+
+    SUBCASE("destroyed while the batch is running")
+    {
+        fge::ThreadPool pool(2);
+        for (int i=0; i<64; ++i)
+        {
+            auto otherService = std::make_unique<fge::AStar::PathService>();
+            otherService->getGenerator().setWorldSize({20, 20});
+            otherService->setThreadPool(&pool);
+            otherService->request({0, 0}, {19, 19});
+            REQUIRE(otherService->process() == 0);
+            otherService.reset(); //Wait for the batch
+        }
+        pool.wait();
+    }
+}
+
+TEST_CASE("testing AStar flow field")
+{
+    fge::AStar::Generator generator;
+    generator.setWorldSize({10, 10});
+    for (int32_t y=0; y<9; ++y)
+    {
+        generator.addCollision({5, y});
+    }
+
+    fge::AStar::FlowField flowField;
+    flowField.compute(generator, {{9, 0}});
+
+    REQUIRE(flowField.getCost({9, 0}) == 0);
+    REQUIRE(flowField.getCost({5, 0}) == FGE_FLOWFIELD_NO_COST);
+    REQUIRE(flowField.getPath({0, 0}).size() == generator.findPath({0, 0}, {9, 0}).size());
+
+    fge::AStar::Vector2i next;
+    REQUIRE(flowField.getNextStep({4, 0}, next));
+    REQUIRE(next == fge::AStar::Vector2i(4, 1));
+    REQUIRE_FALSE(flowField.getNextStep({9, 0}, next));
+
+    SUBCASE("incremental update")
+    {
+        generator.removeCollision({5, 0});
+        flowField.update(generator, {5, 0});
+        REQUIRE(flowField.getPath({0, 0}).size() == 10);
+
+        generator.addCollision({5, 9});
+        flowField.update(generator, {5, 9});
+        generator.addCollision({5, 0});
+        flowField.update(generator, {5, 0});
+        REQUIRE(flowField.getCost({0, 0}) == FGE_FLOWFIELD_NO_COST);
+        REQUIRE(flowField.getPath({0, 0}).empty());
+    }
+}
+
+TEST_CASE("testing AStar with a TileLayer")
+{
+    //Tile 1 is free and tile 2 is solid
+    auto textureData = std::make_shared<fge::texture::TextureData>();
+    textureData->_valid = true;
+    textureData->_rect = {0, 0, 32, 16};
+    auto tileSet = std::make_shared<fge::TileSet>(fge::Texture{textureData}, sf::Vector2i{16, 16});
+    tileSet->setFirstGid(1);
+    REQUIRE(tileSet->getTile(1) != nullptr);
+    tileSet->getTile(1)->_properties[FGE_TILELAYER_DEFAULT_COLLISION_PROPERTY] = true;
+    const fge::TileSetList tileSets{tileSet};
+
+    fge::TileLayer layer;
+    layer.setGridSize(10, 10);
+    for (std::size_t y=0; y<10; ++y)
+    {
+        for (std::size_t x=0; x<10; ++x)
+        {
+            layer.setGid(x, y, tileSets, x == 5 && y < 9 ? 2 : 1);
+        }
+    }
+
+    fge::AStar::Generator generator;
+    generator.setCollisions({10, 10}, layer.getCollisions());
+    REQUIRE(generator.findPath({0, 0}, {9, 0}).size() == 28);
+
+    fge::AStar::FlowField flowField;
+    flowField.compute(generator, {{9, 0}});
+
+    //The layer push every changed cell
+    std::size_t changes = 0;
+    layer._onCollisionChanged.add(new fge::CallbackLambda<fge::TileLayer&, std::size_t, std::size_t, bool>(
+            [&](fge::TileLayer&, std::size_t x, std::size_t y, bool solid){
+        const fge::AStar::Vector2i coord{static_cast<int32_t>(x), static_cast<int32_t>(y)};
+        generator.setCollision(coord, solid);
+        flowField.update(generator, coord);
+        ++changes;
+    }));
+
+    layer.setGid(5, 9, tileSets, 2);
+    REQUIRE(changes == 1);
+    REQUIRE(layer.isSolid(5, 9));
+    REQUIRE(generator.findPath({0, 0}, {9, 0}).empty());
+    REQUIRE(flowField.getCost({0, 0}) == FGE_FLOWFIELD_NO_COST);
+
+    //Same state, nothing is notified
+    layer.setGid(5, 9, tileSets, 2);
+    REQUIRE(changes == 1);
+
+    layer.setGid(5, 0, tileSets, 1);
+    REQUIRE(changes == 2);
+    REQUIRE(generator.findPath({0, 0}, {9, 0}).size() == 10);
+    REQUIRE(flowField.getPath({0, 0}).size() == 10);
+}
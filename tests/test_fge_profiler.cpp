@@ -0,0 +1,136 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_profiler.hpp>
+#include <FastEngine/C_scene.hpp>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+
+class ProfiledObject : public fge::Object
+{
+public:
+    const char* getClassName() const override
+    {
+        return "TEST_PROFILED_OBJECT";
+    }
+};
+
+const fge::prof::ClassReport* FindClass(const fge::prof::Report& report, std::string_view className)
+{
+    auto it = std::find_if(report._classes.begin(), report._classes.end(), [&](const fge::prof::ClassReport& classReport){
+        return classReport._className == className;
+    });
+    return it != report._classes.end() ? &(*it) : nullptr;
+}
+
+}//end
+
+TEST_CASE("testing profiler events")
+{
+    fge::prof::SetEnabled(true);
+    (void)fge::prof::Collect(); //Drop previous events
+
+    SUBCASE("events are aggregated per class")
+    {
+        //Names are compared by value, not by pointer
+        char nameCopy[] = "TEST_CLASS_A";
+        {
+            fge::prof::ScopedEvent sceneEvent{fge::prof::EventTypes::EVENT_SCENE_UPDATE, "Scene::update"};
+            for (int i=0; i<3; ++i)
+            {
+                fge::prof::ScopedEvent event{fge::prof::EventTypes::EVENT_OBJECT_UPDATE, "TEST_CLASS_A"};
+            }
+            fge::prof::ScopedEvent event{fge::prof::EventTypes::EVENT_OBJECT_DRAW, nameCopy};
+        }
+        fge::prof::PushEvent(fge::prof::EventTypes::EVENT_OBJECT_CULLED, "TEST_CLASS_B");
+        fge::prof::PushEvent(fge::prof::EventTypes::EVENT_OBJECT_CULLED, "TEST_CLASS_B");
+
+        auto report = fge::prof::Collect();
+        REQUIRE(report._updateFrameCount == 1);
+        REQUIRE(report._droppedEventCount == 0);
+        REQUIRE(report._classes.size() == 2);
+
+        const auto* classA = FindClass(report, "TEST_CLASS_A");
+        REQUIRE(classA != nullptr);
+        REQUIRE(classA->_updateCount == 3);
+        REQUIRE(classA->_drawCount == 1);
+        REQUIRE(classA->_updateTime <= report._updateTime);
+
+        const auto* classB = FindClass(report, "TEST_CLASS_B");
+        REQUIRE(classB != nullptr);
+        REQUIRE(classB->_culledCount == 2);
+        REQUIRE(classB->_updateCount == 0);
+
+        //Events are only collected once
+        REQUIRE(fge::prof::Collect()._classes.empty());
+    }
+
+    SUBCASE("disabled profiling push nothing")
+    {
+        fge::prof::SetEnabled(false);
+        {
+            fge::prof::ScopedEvent event{fge::prof::EventTypes::EVENT_OBJECT_UPDATE, "TEST_CLASS_A"};
+        }
+        fge::prof::PushEvent(fge::prof::EventTypes::EVENT_OBJECT_CULLED, "TEST_CLASS_A");
+        REQUIRE(fge::prof::Collect()._classes.empty());
+        fge::prof::SetEnabled(true);
+    }
+
+    SUBCASE("full buffers drop events")
+    {
+        //The capacity is applied to buffers of new threads
+        fge::prof::SetBufferCapacity(4);
+        std::thread thread([](){
+            for (int i=0; i<6; ++i)
+            {
+                fge::prof::PushEvent(fge::prof::EventTypes::EVENT_OBJECT_CULLED, "TEST_CLASS_C");
+            }
+        });
+        thread.join();
+        fge::prof::SetBufferCapacity(FGE_PROF_DEFAULT_BUFFER_CAPACITY);
+
+        auto report = fge::prof::Collect();
+        REQUIRE(report._droppedEventCount == 2);
+        const auto* classC = FindClass(report, "TEST_CLASS_C");
+        REQUIRE(classC != nullptr);
+        REQUIRE(classC->_culledCount == 4);
+    }
+
+    fge::prof::SetEnabled(false);
+}
+
+TEST_CASE("testing Scene profiling")
+{
+    if ( !fge::prof::IsCompiledIn() )
+    {//The instrumentation of the Scene is not built in
+        return;
+    }
+
+    fge::prof::SetEnabled(true);
+    (void)fge::prof::Collect();
+
+    fge::Scene scene;
+    scene.newObject(FGE_NEWOBJECT(ProfiledObject));
+    scene.newObject(FGE_NEWOBJECT(ProfiledObject));
+
+    fge::Event event;
+    for (int i=0; i<2; ++i)
+    {
+#ifdef FGE_DEF_SERVER
+        scene.update(event, std::chrono::milliseconds{16});
+#else
+        sf::RenderWindow screen;
+        scene.update(screen, event, std::chrono::milliseconds{16});
+#endif //FGE_DEF_SERVER
+    }
+
+    auto report = fge::prof::Collect();
+    REQUIRE(report._updateFrameCount == 2);
+    const auto* classReport = FindClass(report, "TEST_PROFILED_OBJECT");
+    REQUIRE(classReport != nullptr);
+    REQUIRE(classReport->_updateCount == 4);
+
+    fge::prof::SetEnabled(false);
+}
@@ -0,0 +1,215 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_propertyList.hpp>
+#include <cstdint>
+
+namespace
+{
+
+//Not trivially copyable, so always allocated
+struct Counted
+{
+    Counted() { ++_alive; }
+    Counted(const Counted& r) : _value(r._value) { ++_alive; }
+    ~Counted() { --_alive; }
+    Counted& operator=(const Counted& r) = default;
+
+    int _value{0};
+    static inline int _alive = 0;
+};
+
+//Small and trivially copyable, so stored inline
+struct Small
+{
+    int _a;
+    int _b;
+};
+
+bool IsStoredIn(const fge::Property& property, const void* ptr)
+{
+    const auto begin = reinterpret_cast<std::uintptr_t>(&property);
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    return address >= begin && address < begin + sizeof(fge::Property);
+}
+
+}//end
+
+TEST_CASE("testing property keys")
+{
+    const fge::PropertyKey keyA{"testKeyA"};
+    const fge::PropertyKey keyB{std::string{"testKeyB"}};
+
+    REQUIRE(keyA.isValid());
+    REQUIRE(keyB.isValid());
+    REQUIRE(keyA != keyB);
+    REQUIRE(fge::PropertyKey{"testKeyA"} == keyA);
+    REQUIRE(keyA.getName() == "testKeyA");
+
+    REQUIRE(fge::PropertyKey::find("testKeyB") == keyB);
+    REQUIRE_FALSE(fge::PropertyKey::find("testKeyNeverRegistered").isValid());
+    REQUIRE_FALSE(fge::PropertyKey{}.isValid());
+    REQUIRE(fge::PropertyKey{}.getName().empty());
+}
+
+TEST_CASE("testing property list")
+{
+    fge::PropertyList list;
+
+    list.setProperty("testListC", 3);
+    list.setProperty("testListA", 1);
+    list["testListB"] = "two";
+
+    REQUIRE(list.getPropertiesSize() == 3);
+    REQUIRE(list.checkProperty("testListA"));
+    REQUIRE(list.checkProperty(fge::PropertyKey{"testListB"}));
+    REQUIRE(list.getProperty("testListC").get<int>().value_or(0) == 3);
+    REQUIRE(*list.getPropertyType<std::string>("testListB") == "two");
+
+    SUBCASE("keys are sorted and unique")
+    {
+        list.setProperty("testListA", 10);
+        REQUIRE(list.getPropertiesSize() == 3);
+        REQUIRE(list["testListA"].get<int>().value_or(0) == 10);
+
+        auto it = list.begin();
+        for (auto itNext=it+1; itNext!=list.end(); ++it, ++itNext)
+        {
+            REQUIRE(it->first < itNext->first);
+        }
+    }
+
+    SUBCASE("const lookups don't create properties")
+    {
+        const fge::PropertyList& constList = list;
+
+        REQUIRE_FALSE(constList.checkProperty("testListNeverRegistered"));
+        REQUIRE(constList.find("testListNeverRegistered") == constList.end());
+        REQUIRE(constList.getPropertyType<std::string>("testListNeverRegistered") == nullptr);
+        REQUIRE_FALSE(fge::PropertyKey::find("testListNeverRegistered").isValid());
+
+        bool thrown = false;
+        try
+        {
+            [[maybe_unused]] const auto& property = constList["testListNeverRegistered"];
+        }
+        catch (const std::logic_error&)
+        {
+            thrown = true;
+        }
+        REQUIRE(thrown);
+    }
+
+    SUBCASE("deleting properties")
+    {
+        list.delProperty("testListB");
+        REQUIRE(list.getPropertiesSize() == 2);
+        REQUIRE_FALSE(list.checkProperty("testListB"));
+
+        list.delProperty("testListNeverRegistered");
+        REQUIRE(list.getPropertiesSize() == 2);
+
+        list.delAllProperties();
+        REQUIRE(list.getPropertiesSize() == 0);
+    }
+
+    SUBCASE("modification flags")
+    {
+        REQUIRE(list.countAllModificationFlags() == 3);
+        list.clearAllModificationFlags();
+        REQUIRE(list.countAllModificationFlags() == 0);
+        list.setProperty("testListA", 5);
+        REQUIRE(list.countAllModificationFlags() == 1);
+    }
+}
+
+TEST_CASE("testing property inline storage")
+{
+    REQUIRE(Counted::_alive == 0);
+
+    SUBCASE("inline class copy")
+    {
+        fge::Property property{Small{1, 2}};
+        REQUIRE(property.getPtr<Small>() != nullptr);
+        REQUIRE(IsStoredIn(property, property.getPtr<Small>()));
+
+        fge::Property copy{property};
+        REQUIRE(copy.getPtr<Small>() != nullptr);
+        REQUIRE(IsStoredIn(copy, copy.getPtr<Small>()));
+        REQUIRE(copy.getPtr<Small>()->_b == 2);
+
+        property.getPtr<Small>()->_b = 3;
+        REQUIRE(copy.getPtr<Small>()->_b == 2);
+
+        fge::Property assigned;
+        assigned = property;
+        REQUIRE(IsStoredIn(assigned, assigned.getPtr<Small>()));
+        REQUIRE(assigned.getPtr<Small>()->_b == 3);
+    }
+
+    SUBCASE("move between inline and heap")
+    {
+        fge::Property heap{Counted{}};
+        REQUIRE(Counted::_alive == 1);
+        const Counted* heapPtr = heap.getPtr<Counted>();
+        REQUIRE(heapPtr != nullptr);
+        REQUIRE_FALSE(IsStoredIn(heap, heapPtr));
+
+        //The allocated class is stolen
+        fge::Property moved{std::move(heap)};
+        REQUIRE(heap.getType() == fge::Property::Types::PTYPE_NULL);
+        REQUIRE(moved.getPtr<Counted>() == heapPtr);
+        REQUIRE(Counted::_alive == 1);
+
+        fge::Property small{Small{4, 5}};
+        fge::Property movedSmall{std::move(small)};
+        REQUIRE(small.getType() == fge::Property::Types::PTYPE_NULL);
+        REQUIRE(IsStoredIn(movedSmall, movedSmall.getPtr<Small>()));
+
+        //Inline to heap, then heap to inline
+        movedSmall = std::move(moved);
+        REQUIRE(movedSmall.getPtr<Counted>() == heapPtr);
+        REQUIRE(Counted::_alive == 1);
+
+        movedSmall = fge::Property{Small{6, 7}};
+        REQUIRE(Counted::_alive == 0);
+        REQUIRE(IsStoredIn(movedSmall, movedSmall.getPtr<Small>()));
+        REQUIRE(movedSmall.getPtr<Small>()->_a == 6);
+    }
+
+    SUBCASE("self move")
+    {
+        fge::Property heap{Counted{}};
+        fge::Property& heapRef = heap;
+        REQUIRE(heap.set(std::move(heapRef)));
+        REQUIRE(heap.getPtr<Counted>() != nullptr);
+        REQUIRE(Counted::_alive == 1);
+
+        fge::Property small{Small{1, 2}};
+        fge::Property& smallRef = small;
+        REQUIRE(small.set(std::move(smallRef)));
+        REQUIRE(small.getPtr<Small>()->_b == 2);
+
+        fge::Property string{"a string long enough to not fit in the small string buffer"};
+        fge::Property& stringRef = string;
+        REQUIRE(string.set(std::move(stringRef)));
+        REQUIRE(*string.getPtr<std::string>() == "a string long enough to not fit in the small string buffer");
+    }
+
+    SUBCASE("moving a class over a class release the previous one")
+    {
+        fge::Property property{Counted{}};
+        for (int i=0; i<8; ++i)
+        {
+            Counted counted;
+            counted._value = i;
+            REQUIRE(property.set(fge::Property{counted}));
+        }
+        REQUIRE(Counted::_alive == 1);
+        REQUIRE(property.getPtr<Counted>()->_value == 7);
+
+        fge::Property string{"first"};
+        REQUIRE(string.set(fge::Property{"second"}));
+        REQUIRE(*string.getPtr<std::string>() == "second");
+    }
+
+    REQUIRE(Counted::_alive == 0);
+}
@@ -0,0 +1,65 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_rectPacker.hpp>
+#include <FastEngine/C_textureAtlas.hpp>
+#include <vector>
+
+TEST_CASE("testing RectPacker")
+{
+    fge::RectPacker packer{{64, 64}, 1};
+
+    SUBCASE("rectangles don't overlap and stay in the bin")
+    {
+        std::vector<sf::IntRect> rects;
+        for (unsigned int i=0; i<20; ++i)
+        {
+            auto rect = packer.insert({7+i%5, 5+i%3});
+            REQUIRE(rect.has_value());
+            REQUIRE(rect->left >= 0);
+            REQUIRE(rect->top >= 0);
+            REQUIRE(rect->left + rect->width <= 64);
+            REQUIRE(rect->top + rect->height <= 64);
+            REQUIRE(rect->width == static_cast<int>(7+i%5));
+            REQUIRE(rect->height == static_cast<int>(5+i%3));
+            rects.push_back(*rect);
+        }
+
+        for (std::size_t a=0; a<rects.size(); ++a)
+        {
+            for (std::size_t b=a+1; b<rects.size(); ++b)
+            {
+                //The padding keep at least one empty pixel between rectangles
+                sf::IntRect padded{rects[a].left, rects[a].top, rects[a].width+1, rects[a].height+1};
+                REQUIRE_FALSE(padded.intersects(rects[b]));
+            }
+        }
+        REQUIRE(packer.getOccupancy() > 0.0f);
+        REQUIRE(packer.getOccupancy() <= 1.0f);
+    }
+
+    SUBCASE("full bin")
+    {
+        REQUIRE(packer.insert({63, 63}).has_value());
+        REQUIRE_FALSE(packer.insert({8, 8}).has_value());
+        REQUIRE_FALSE(packer.insert({65, 1}).has_value());
+
+        packer.clear();
+        REQUIRE(packer.getOccupancy() == 0.0f);
+        REQUIRE(packer.insert({8, 8}).has_value());
+    }
+}
+
+TEST_CASE("testing TextureAtlas rejections")
+{
+    fge::TextureAtlas atlas{16, 1};
+
+    //Nothing is created for images that can't be packed
+    sf::Image empty;
+    REQUIRE_FALSE(atlas.add(empty).has_value());
+
+    sf::Image tooBig;
+    tooBig.create(32, 8, sf::Color::White);
+    REQUIRE_FALSE(atlas.add(tooBig).has_value());
+    REQUIRE_FALSE(atlas.add(tooBig, true).has_value());
+
+    REQUIRE(atlas.getPageCount() == 0);
+}
@@ -0,0 +1,420 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_scene.hpp>
+#include <FastEngine/manager/reg_manager.hpp>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+class UpdateCallbackObject : public fge::Object
+{
+public:
+    explicit UpdateCallbackObject(std::function<void(fge::Scene*)> func) :
+            g_func(std::move(func))
+    {}
+
+#ifdef FGE_DEF_SERVER
+    void update([[maybe_unused]] fge::Event& event, [[maybe_unused]] const std::chrono::milliseconds& deltaTime, fge::Scene* scene) override
+#else
+    void update([[maybe_unused]] sf::RenderWindow& screen, [[maybe_unused]] fge::Event& event, [[maybe_unused]] const std::chrono::milliseconds& deltaTime, fge::Scene* scene) override
+#endif //FGE_DEF_SERVER
+    {
+        if (this->g_func)
+        {
+            this->g_func(scene);
+        }
+    }
+
+private:
+    std::function<void(fge::Scene*)> g_func;
+};
+
+void UpdateScene(fge::Scene& scene)
+{
+    fge::Event event;
+#ifdef FGE_DEF_SERVER
+    scene.update(event, std::chrono::milliseconds{16});
+#else
+    sf::RenderWindow screen;
+    scene.update(screen, event, std::chrono::milliseconds{16});
+#endif //FGE_DEF_SERVER
+}
+
+}//end
+
+TEST_CASE("testing SidAllocator")
+{
+    fge::SidAllocator allocator{10, 13};
+
+    REQUIRE(allocator.get() == 10);
+    REQUIRE(allocator.get() == 11);
+    REQUIRE(allocator.get() == 12);
+
+    SUBCASE("range exhausted")
+    {
+        REQUIRE(allocator.get() == FGE_SCENE_BAD_SID);
+    }
+
+    SUBCASE("recycling released SIDs")
+    {
+        allocator.release(11);
+        allocator.release(42); //Out of range, ignored
+        REQUIRE(allocator.getRecycledSize() == 1);
+        REQUIRE(allocator.get() == 11);
+        REQUIRE(allocator.get() == FGE_SCENE_BAD_SID);
+    }
+
+    SUBCASE("reset")
+    {
+        allocator.release(10);
+        allocator.reset();
+        REQUIRE(allocator.getRecycledSize() == 0);
+        REQUIRE(allocator.get() == 10);
+    }
+}
+
+TEST_CASE("testing Scene SID generation")
+{
+    fge::Scene scene;
+    scene.setSidAllocator(fge::SidAllocator{0, 4});
+
+    REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_DEFAULT, 1)->getSid() == 1);
+
+    SUBCASE("taken SIDs are skipped")
+    {
+        REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object))->getSid() == 0);
+        REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object))->getSid() == 2);
+        REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object))->getSid() == 3);
+        REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object)) == nullptr);
+
+        SUBCASE("deleted SIDs are recycled")
+        {
+            REQUIRE(scene.delObject(2));
+            REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object))->getSid() == 2);
+        }
+    }
+
+    SUBCASE("a wanted SID that is already taken fail")
+    {
+        REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_DEFAULT, 1) == nullptr);
+    }
+}
+
+TEST_CASE("testing Scene SID ranges")
+{
+    REQUIRE(fge::SidAllocator{}.getRangeBegin() == FGE_SCENE_DEFAULT_SID_BEGIN);
+    REQUIRE(fge::SidAllocator{}.getRangeEnd() == FGE_SCENE_DEFAULT_SID_END);
+    REQUIRE(FGE_SCENE_NETWORK_SID_END <= FGE_SCENE_LOCAL_SID_BEGIN);
+
+    fge::reg::RegisterNewClass(std::make_unique<fge::reg::Stamp<fge::Object> >());
+
+    fge::Scene serverScene;
+    serverScene.setSidAllocator(fge::SidAllocator{FGE_SCENE_NETWORK_SID_BEGIN, FGE_SCENE_NETWORK_SID_END});
+    auto serverObject1 = serverScene.newObject(FGE_NEWOBJECT(fge::Object));
+    auto serverObject2 = serverScene.newObject(FGE_NEWOBJECT(fge::Object));
+    REQUIRE(serverObject1->getSid() < FGE_SCENE_NETWORK_SID_END);
+    REQUIRE(serverObject2->getSid() < FGE_SCENE_NETWORK_SID_END);
+
+    fge::Scene clientScene;
+    clientScene.setSidAllocator(fge::SidAllocator{FGE_SCENE_LOCAL_SID_BEGIN, FGE_SCENE_LOCAL_SID_END});
+
+    SUBCASE("local GUI objects are kept on unpack")
+    {
+        auto localObject = clientScene.newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_GUI, FGE_SCENE_BAD_SID, fge::ObjectType::TYPE_GUI);
+        REQUIRE(localObject->getSid() >= FGE_SCENE_LOCAL_SID_BEGIN);
+
+        fge::net::Packet pck;
+        serverScene.pack(pck);
+        clientScene.unpack(pck);
+
+        REQUIRE(pck.isValid());
+        REQUIRE(clientScene.getObjectSize() == 3);
+        REQUIRE(clientScene.getObject(localObject->getSid()) == localObject);
+        REQUIRE(clientScene.isValid(serverObject1->getSid()));
+        REQUIRE(clientScene.isValid(serverObject2->getSid()));
+    }
+
+    SUBCASE("a colliding SID invalidate the packet")
+    {
+        clientScene.newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_GUI, serverObject1->getSid(), fge::ObjectType::TYPE_GUI);
+
+        fge::net::Packet pck;
+        serverScene.pack(pck);
+        clientScene.unpack(pck);
+
+        REQUIRE_FALSE(pck.isValid());
+    }
+}
+
+TEST_CASE("testing Scene tag index")
+{
+    fge::Scene scene;
+
+    auto object1 = scene.newObject(FGE_NEWOBJECT(fge::Object));
+    auto object2 = scene.newObject(FGE_NEWOBJECT(fge::Object));
+    object1->getObject()->_tags.add("enemy");
+    object2->getObject()->_tags.add("enemy");
+    object2->getObject()->_tags.add("boss");
+
+    fge::ObjectContainer result;
+    REQUIRE(scene.getAllObj_ByTag("enemy", result) == 2);
+    REQUIRE(scene.getFirstObj_ByTag("boss") == object2);
+
+    SUBCASE("removing a tag")
+    {
+        object2->getObject()->_tags.del("boss");
+        REQUIRE(scene.getFirstObj_ByTag("boss") == nullptr);
+    }
+
+    SUBCASE("removing an object")
+    {
+        REQUIRE(scene.delObject(object1->getSid()));
+        result.clear();
+        REQUIRE(scene.getAllObj_ByTag("enemy", result) == 1);
+        REQUIRE(result.front() == object2);
+    }
+
+    SUBCASE("searching by tag id")
+    {
+        result.clear();
+        REQUIRE(scene.getAllObj_ByTag(fge::tag::GetTagId("enemy"), result) == 2);
+        REQUIRE(scene.getFirstObj_ByTag("unknownTag") == nullptr);
+    }
+
+    SUBCASE("searching by class")
+    {
+        result.clear();
+        REQUIRE(scene.getAllObj_ByClass(FGE_OBJ_BADCLASSNAME, result) == 2);
+    }
+
+    SUBCASE("the first object follow the Scene order")
+    {
+        auto object3 = scene.newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_DEFAULT-1);
+        object3->getObject()->_tags.add("enemy");
+        REQUIRE(scene.getFirstObj_ByTag("enemy") == object3);
+        REQUIRE(scene.getFirstObj_ByClass(FGE_OBJ_BADCLASSNAME) == object3);
+
+        REQUIRE(scene.delObject(object3->getSid()));
+        auto expected = *std::find_if(scene.begin(), scene.end(), [](const fge::ObjectDataShared& data){
+            return data->getObject()->_tags.check("enemy");
+        });
+        for (int i=0; i<10; ++i)
+        {
+            REQUIRE(scene.getFirstObj_ByTag("enemy") == expected);
+            REQUIRE(scene.getFirstObj_ByClass(FGE_OBJ_BADCLASSNAME) == expected);
+        }
+    }
+}
+
+TEST_CASE("testing Scene destruction with shared objects")
+{
+    fge::ObjectDataShared object;
+    {
+        fge::Scene scene;
+        object = scene.newObject(FGE_NEWOBJECT(fge::Object));
+        object->getObject()->_tags.add("enemy");
+    }
+
+    REQUIRE(object->getLinkedScene() == nullptr);
+    //The Scene is destroyed, this must not touch its index
+    object->getObject()->_tags.add("boss");
+    object->getObject()->_tags.del("enemy");
+    REQUIRE(object->getObject()->_tags.check("boss"));
+}
+
+TEST_CASE("testing TagList interning")
+{
+    fge::TagList tags;
+
+    tags.add("b_tag");
+    tags.add("a_tag");
+    tags.add("a_tag");
+    REQUIRE(tags.getSize() == 2);
+
+    fge::tag::TagId idA = fge::tag::GetTagId("a_tag");
+    REQUIRE(idA != FGE_TAG_BADID);
+    REQUIRE(fge::tag::Intern("a_tag") == idA);
+    REQUIRE(fge::tag::GetTagName(idA) == "a_tag");
+    REQUIRE(tags.check(idA));
+    REQUIRE_FALSE(tags.check("c_tag"));
+    REQUIRE(fge::tag::GetTagId("c_tag") == FGE_TAG_BADID);
+
+    fge::TagList copy = tags;
+    copy.del("b_tag");
+    REQUIRE(copy.getSize() == 1);
+    REQUIRE(tags.check("b_tag"));
+
+    SUBCASE("interning from multiple threads")
+    {
+        std::vector<std::thread> threads;
+        std::vector<fge::tag::TagId> ids(4, FGE_TAG_BADID);
+        for (std::size_t i=0; i<ids.size(); ++i)
+        {
+            threads.emplace_back([&ids, i](){
+                for (int n=0; n<1000; ++n)
+                {
+                    ids[i] = fge::tag::Intern("threaded_tag");
+                    REQUIRE(fge::tag::GetTagId("a_tag") != FGE_TAG_BADID);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (auto id : ids)
+        {
+            REQUIRE(id == fge::tag::GetTagId("threaded_tag"));
+        }
+        REQUIRE(fge::tag::Check(ids.front()));
+    }
+}
+
+TEST_CASE("testing Scene deferred changes")
+{
+    fge::Scene scene;
+    scene.deferChanges(true);
+
+    std::size_t planUpdateCount = 0;
+    scene._onPlanUpdate.add( new fge::CallbackLambda<fge::Scene*, fge::ObjectPlan>([&](fge::Scene*, fge::ObjectPlan){
+        ++planUpdateCount;
+    }) );
+
+    SUBCASE("new objects get their SID when queued")
+    {
+        fge::ObjectDataShared queued1;
+        fge::ObjectDataShared queued2;
+        scene.newObject(FGE_NEWOBJECT(UpdateCallbackObject, [&](fge::Scene* s){
+            if (queued1 == nullptr)
+            {
+                queued1 = s->newObject(FGE_NEWOBJECT(fge::Object));
+                queued2 = s->newObject(FGE_NEWOBJECT(fge::Object));
+                REQUIRE(queued1 != nullptr);
+                REQUIRE(queued2 != nullptr);
+                REQUIRE(queued1->getSid() != FGE_SCENE_BAD_SID);
+                REQUIRE(queued2->getSid() != FGE_SCENE_BAD_SID);
+                REQUIRE(queued1->getSid() != queued2->getSid());
+                REQUIRE_FALSE(s->isValid(queued1->getSid()));
+                //A wanted SID already queued is refused
+                REQUIRE(s->newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_DEFAULT, queued1->getSid()) == nullptr);
+            }
+        }));
+        planUpdateCount = 0;
+
+        UpdateScene(scene);
+
+        REQUIRE(scene.getObjectSize() == 3);
+        REQUIRE(scene.getObject(queued1->getSid()) == queued1);
+        REQUIRE(scene.getObject(queued2->getSid()) == queued2);
+        REQUIRE(planUpdateCount == 1);
+    }
+
+    SUBCASE("queued objects can be deleted during the same update")
+    {
+        fge::ObjectDataShared queued;
+        scene.newObject(FGE_NEWOBJECT(UpdateCallbackObject, [&](fge::Scene* s){
+            if (queued == nullptr)
+            {
+                queued = s->newObject(FGE_NEWOBJECT(fge::Object));
+                REQUIRE(s->delObject(queued->getSid()));
+            }
+        }));
+        auto other = scene.newObject(FGE_NEWOBJECT(fge::Object));
+
+        UpdateScene(scene);
+
+        REQUIRE(scene.getObjectSize() == 2);
+        REQUIRE_FALSE(scene.isValid(queued->getSid()));
+        REQUIRE(scene.getObject(other->getSid()) == other);
+    }
+
+    SUBCASE("queued objects can change plan during the same update")
+    {
+        fge::ObjectDataShared queued;
+        scene.newObject(FGE_NEWOBJECT(UpdateCallbackObject, [&](fge::Scene* s){
+            if (queued == nullptr)
+            {
+                queued = s->newObject(FGE_NEWOBJECT(fge::Object), 1);
+                REQUIRE(s->setObjectPlan(queued->getSid(), 5));
+            }
+        }));
+
+        UpdateScene(scene);
+
+        REQUIRE(scene.getObject(queued->getSid())->getPlan() == 5);
+    }
+
+    SUBCASE("deleting objects during update")
+    {
+        auto object1 = scene.newObject(FGE_NEWOBJECT(fge::Object));
+        auto object2 = scene.newObject(FGE_NEWOBJECT(fge::Object));
+        scene.newObject(FGE_NEWOBJECT(UpdateCallbackObject, [&](fge::Scene* s){
+            s->delObject(object1->getSid());
+            s->delUpdatedObject();
+            //Nothing is removed before the end of the update
+            REQUIRE(s->getObjectSize() == 3);
+        }));
+        planUpdateCount = 0;
+
+        UpdateScene(scene);
+
+        REQUIRE(scene.getObjectSize() == 1);
+        REQUIRE(scene.getObject(object2->getSid()) == object2);
+        REQUIRE(planUpdateCount == 1);
+    }
+}
+
+TEST_CASE("testing Scene SID generation while deferring")
+{
+    constexpr std::size_t spawnCount = 4000;
+
+    for (const auto range : {std::pair{FGE_SCENE_NETWORK_SID_BEGIN+1000, FGE_SCENE_NETWORK_SID_BEGIN+1000+spawnCount+100},
+                             std::pair{FGE_SCENE_LOCAL_SID_BEGIN, FGE_SCENE_LOCAL_SID_BEGIN+spawnCount+100}})
+    {
+        CAPTURE(range.first);
+
+        fge::Scene scene;
+        scene.setSidAllocator(fge::SidAllocator{range.first, range.second});
+        scene.deferChanges(true);
+
+        //Some SIDs of the range are already taken by objects with a wanted SID
+        for (fge::ObjectSid sid=range.first+10; sid<range.first+60; ++sid)
+        {
+            REQUIRE(scene.newObject(FGE_NEWOBJECT(fge::Object), FGE_SCENE_PLAN_DEFAULT, sid) != nullptr);
+        }
+
+        std::vector<fge::ObjectDataShared> queued;
+        queued.reserve(spawnCount);
+        scene.newObject(FGE_NEWOBJECT(UpdateCallbackObject, [&](fge::Scene* s){
+            if (queued.empty())
+            {
+                for (std::size_t i=0; i<spawnCount; ++i)
+                {
+                    queued.push_back(s->newObject(FGE_NEWOBJECT(fge::Object)));
+                }
+            }
+        }));
+        const std::size_t objectCount = scene.getObjectSize();
+
+        UpdateScene(scene);
+
+        REQUIRE(queued.size() == spawnCount);
+        REQUIRE(scene.getDeferredChangesSize() == 0);
+        REQUIRE(scene.getObjectSize() == objectCount + spawnCount);
+
+        std::unordered_set<fge::ObjectSid> sids;
+        for (const auto& object : queued)
+        {
+            REQUIRE(object != nullptr);
+            const fge::ObjectSid sid = object->getSid();
+            REQUIRE(sid >= range.first);
+            REQUIRE(sid < range.second);
+            REQUIRE(sids.insert(sid).second);
+            REQUIRE(scene.getObject(sid) == object);
+        }
+    }
+}
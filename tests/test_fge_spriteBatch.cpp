@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+#include <FastEngine/C_spriteBatch.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace
+{
+
+//The batch only compare texture addresses, no texture is created (and so no OpenGL context is needed)
+alignas(sf::Texture) unsigned char gTextureStorage[2][sizeof(sf::Texture)];
+const sf::Texture* const gTexture1 = reinterpret_cast<const sf::Texture*>(gTextureStorage[0]);
+const sf::Texture* const gTexture2 = reinterpret_cast<const sf::Texture*>(gTextureStorage[1]);
+
+sf::RenderStates MakeStates(const sf::Texture* texture, const sf::BlendMode& blendMode=sf::BlendAlpha)
+{
+    sf::RenderStates states;
+    states.texture = texture;
+    states.blendMode = blendMode;
+    return states;
+}
+
+}//end
+
+TEST_CASE("testing SpriteBatch")
+{
+    fge::SpriteBatch batch;
+    sf::Vertex quad[4];
+    sf::Vertex triangles[6];
+
+    batch.begin(nullptr);
+
+    SUBCASE("same states are merged in one draw call")
+    {
+        for (int i=0; i<100; ++i)
+        {
+            batch.addQuad(quad, MakeStates(gTexture1));
+        }
+        batch.addTriangles(triangles, 6, MakeStates(gTexture1));
+        batch.end();
+
+        const auto& stats = batch.getStats();
+        REQUIRE(stats._drawCalls == 1);
+        REQUIRE(stats._flushCount == 1);
+        REQUIRE(stats._batchedCount == 101);
+        REQUIRE(stats._vertexCount == 100*6 + 6);
+        REQUIRE(stats._textureBinds == 1);
+    }
+
+    SUBCASE("changing texture or blend mode flush the batch in order")
+    {
+        batch.addQuad(quad, MakeStates(gTexture1));
+        batch.addQuad(quad, MakeStates(gTexture2));
+        batch.addQuad(quad, MakeStates(gTexture1));
+        batch.addQuad(quad, MakeStates(gTexture1, sf::BlendAdd));
+        batch.end();
+
+        const auto& stats = batch.getStats();
+        REQUIRE(stats._drawCalls == 4);
+        REQUIRE(stats._flushCount == 4);
+        //The last flush use the same texture than the previous one
+        REQUIRE(stats._textureBinds == 3);
+    }
+
+    SUBCASE("shaders and drawables are drawn directly")
+    {
+        batch.addQuad(quad, MakeStates(gTexture1));
+
+        sf::RenderStates shaderStates = MakeStates(gTexture1);
+        shaderStates.shader = reinterpret_cast<const sf::Shader*>(gTextureStorage[0]); //Never dereferenced without a target
+        batch.addQuad(quad, shaderStates);
+
+        batch.addQuad(quad, MakeStates(gTexture1));
+        batch.addTriangles(triangles, 0, MakeStates(gTexture2)); //Ignored
+        batch.end();
+
+        const auto& stats = batch.getStats();
+        REQUIRE(stats._drawCalls == 3);
+        REQUIRE(stats._fallbackCount == 1);
+        REQUIRE(stats._batchedCount == 2);
+        REQUIRE(stats._vertexCount == 6 + 4 + 6);
+    }
+
+    SUBCASE("reset statistics")
+    {
+        batch.addQuad(quad, MakeStates(gTexture1));
+        batch.end();
+        batch.resetStats();
+        REQUIRE(batch.getStats()._drawCalls == 0);
+        REQUIRE(batch.getTarget() == nullptr);
+    }
+}
@@ -0,0 +1,140 @@
+#include <doctest/doctest.h>
+#include <FastEngine/object/C_objText.hpp>
+#include <FastEngine/object/C_objTextList.hpp>
+#include <FastEngine/manager/font_manager.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <cstdlib>
+#include <memory>
+
+namespace
+{
+
+//The glyphs are rendered in a texture, so an OpenGL context (and a display on Linux) is needed
+bool CanRenderGlyphs()
+{
+#ifdef __linux__
+    return std::getenv("DISPLAY") != nullptr;
+#else
+    return true;
+#endif
+}
+
+fge::Font LoadTestFont()
+{
+    auto data = std::make_shared<fge::font::FontData>();
+    data->_path = FGE_TESTS_RESOURCES_DIR "/fonts/SourceSansPro-Regular.ttf";
+    data->_font = std::make_shared<sf::Font>();
+    data->_valid = data->_font->loadFromFile(data->_path.string());
+    return fge::Font{std::move(data)};
+}
+
+void CheckSameLayout(const fge::ObjText& text, const fge::ObjText& expected)
+{
+    const sf::FloatRect bounds = text.getLocalBounds();
+    const sf::FloatRect expectedBounds = expected.getLocalBounds();
+    CHECK(bounds == expectedBounds);
+
+    REQUIRE(text.getString() == expected.getString());
+
+    const auto& characters = text.getCharacters();
+    const auto& expectedCharacters = expected.getCharacters();
+    REQUIRE(characters.size() == expectedCharacters.size());
+    for (std::size_t i=0; i<characters.size(); ++i)
+    {
+        CHECK(characters[i].getUnicode() == expectedCharacters[i].getUnicode());
+        CHECK(characters[i].getPosition() == expectedCharacters[i].getPosition());
+    }
+}
+
+}//end
+
+TEST_CASE("testing ObjText incremental rebuild")
+{
+    if (!CanRenderGlyphs())
+    {
+        MESSAGE("no display, glyphs can't be rendered");
+        return;
+    }
+
+    const fge::Font font = LoadTestFont();
+    REQUIRE(font.valid());
+
+    fge::ObjText text{font};
+    text.setOutlineThickness(1.0f);
+
+    //Every string share a prefix with the previous one, so only the tail is rebuilt
+    const char* strings[] = {"Hello", "Hello world", "Hello\nthere", "Help", "", "Tab\tand spaces ",
+                             "Tab\tand spaces, then more", "x"};
+    for (const char* string : strings)
+    {
+        CAPTURE(string);
+        text.setString(string);
+
+        fge::ObjText expected{string, font};
+        expected.setOutlineThickness(1.0f);
+
+        CheckSameLayout(text, expected);
+    }
+
+    SUBCASE("style change rebuild everything")
+    {
+        text.setString("Hello world");
+        REQUIRE(text.getLocalBounds().width > 0.0f);
+        text.setCharacterSize(14);
+        text.setString("Hello world!");
+
+        fge::ObjText expected{"Hello world!", font, {}, 14};
+        expected.setOutlineThickness(1.0f);
+
+        CheckSameLayout(text, expected);
+    }
+}
+
+TEST_CASE("testing ObjTextList text cache")
+{
+    fge::ObjTextList list;
+    list.setMaxStrings(3);
+
+    list.addString("first");
+    list.addString("second");
+    list.addString("third");
+    list.addString("fourth");
+
+    REQUIRE(list.getStringsSize() == 3);
+    CHECK(list.getText(0).getString() == "fourth");
+    CHECK(list.getText(1).getString() == "third");
+    CHECK(list.getText(2).getString() == "second");
+
+    SUBCASE("a modified string is pushed to its text")
+    {
+        list.getString(1) = "modified";
+        CHECK(list.getText(1).getString() == "modified");
+        CHECK(list.getText(0).getString() == "fourth");
+    }
+
+    SUBCASE("a style change is pushed to every text")
+    {
+        fge::Font font{std::make_shared<fge::font::FontData>()};
+        list.setFont(font);
+        list.first(nullptr);
+
+        for (std::size_t i=0; i<list.getStringsSize(); ++i)
+        {
+            CHECK(list.getText(i).getFont().getData() == font.getData());
+            CHECK(list.getText(i).getCharacterSize() == 14);
+            CHECK(list.getText(i).getOutlineThickness() == 1.0f);
+        }
+
+        list.addString("fifth");
+        CHECK(list.getText(0).getCharacterSize() == 14);
+        CHECK(list.getText(0).getString() == "fifth");
+    }
+
+    SUBCASE("removing every strings")
+    {
+        list.removeAllStrings();
+        CHECK(list.getStringsSize() == 0);
+        list.addString("again");
+        CHECK(list.getText(0).getString() == "again");
+    }
+}
@@ -0,0 +1,386 @@
+#include <doctest/doctest.h>
+#include <FastEngine/manager/timer_manager.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+//The timer thread work with the real clock, so every wait have a generous timeout
+constexpr auto TimeOut = 3000ms;
+
+struct TimerManagerScope
+{
+    TimerManagerScope() { fge::timer::Init(); }
+    ~TimerManagerScope() { fge::timer::Uninit(); }
+};
+
+template<class TPredicate>
+bool WaitFor(const TPredicate& predicate, std::chrono::milliseconds timeout=TimeOut)
+{
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() >= end)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+//Count the calls of a timer and keep the time of the last one
+struct TimerProbe
+{
+    explicit TimerProbe(const std::chrono::milliseconds& goal, bool paused=false) :
+            _timer(std::make_shared<fge::Timer>(goal, paused)),
+            _start(std::chrono::steady_clock::now())
+    {
+        this->_timer->_onTimeReached.add(new fge::CallbackLambda<fge::Timer&>([this](fge::Timer&){
+            this->_calledAfter = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->_start).count();
+            this->_order = ++(*this->_counter);
+            ++this->_calls;
+        }));
+    }
+    ~TimerProbe()
+    {
+        fge::timer::Destroy(this->_timer);
+    }
+
+    [[nodiscard]] bool waitCall() const
+    {
+        return WaitFor([this](){ return this->_calls > 0; });
+    }
+
+    fge::timer::TimerShared _timer;
+    std::chrono::steady_clock::time_point _start;
+    std::atomic<int>* _counter{&_dummyCounter};
+    std::atomic<int> _dummyCounter{0};
+    std::atomic<int> _calls{0};
+    std::atomic<int> _order{0};
+    std::atomic<long long> _calledAfter{0};
+};
+
+}//end
+
+TEST_CASE("testing timer wheel cascade")
+{
+    TimerManagerScope scope;
+    std::atomic<int> counter{0};
+
+    SUBCASE("timers on the first two levels are called in order")
+    {
+        //The first level cover 256 ms, the longer goals are cascaded from the second level
+        TimerProbe shortProbe{5ms};
+        TimerProbe mediumProbe{300ms};
+        TimerProbe longProbe{700ms};
+        shortProbe._counter = &counter;
+        mediumProbe._counter = &counter;
+        longProbe._counter = &counter;
+
+        fge::timer::Create(longProbe._timer);
+        fge::timer::Create(shortProbe._timer);
+        fge::timer::Create(mediumProbe._timer);
+        CHECK(fge::timer::GetTimerSize() == 3);
+
+        REQUIRE(longProbe.waitCall());
+        REQUIRE(shortProbe._calls == 1);
+        REQUIRE(mediumProbe._calls == 1);
+
+        CHECK(shortProbe._order == 1);
+        CHECK(mediumProbe._order == 2);
+        CHECK(longProbe._order == 3);
+
+        CHECK(shortProbe._calledAfter >= 5);
+        CHECK(mediumProbe._calledAfter >= 300);
+        CHECK(longProbe._calledAfter >= 700);
+
+        //Timers that reached their goal are removed
+        CHECK(WaitFor([](){ return fge::timer::GetTimerSize() == 0; }));
+    }
+
+    SUBCASE("a timer alone on an upper level")
+    {
+        //Nothing is on the first level, the wheel skip the ticks up to the next cascade
+        TimerProbe probe{600ms};
+        fge::timer::Create(probe._timer);
+
+        REQUIRE(probe.waitCall());
+        CHECK(probe._calledAfter >= 600);
+        CHECK(probe._calls == 1);
+    }
+
+    SUBCASE("a timer restarted in its callback is kept")
+    {
+        std::atomic<int> calls{0};
+        auto timer = std::make_shared<fge::Timer>(300ms);
+        timer->_onTimeReached.add(new fge::CallbackLambda<fge::Timer&>([&](fge::Timer& t){
+            if (++calls < 2)
+            {
+                t.restart();
+            }
+        }));
+        fge::timer::Create(timer);
+
+        CHECK(WaitFor([&](){ return calls == 2; }));
+        CHECK(WaitFor([](){ return fge::timer::GetTimerSize() == 0; }));
+    }
+}
+
+TEST_CASE("testing timer goals beyond the last level")
+{
+    TimerManagerScope scope;
+
+    //The last level cover 2^32 ms (around 49 days)
+    TimerProbe probe{std::chrono::hours{24*100}};
+    fge::timer::Create(probe._timer);
+
+    std::this_thread::sleep_for(100ms);
+    CHECK(probe._calls == 0);
+    CHECK(fge::timer::Check(probe._timer));
+    CHECK(probe._timer->getTimeLeft() > std::chrono::hours{24*99});
+
+    SUBCASE("still rescheduled when the goal is brought closer")
+    {
+        probe._timer->setGoalDuration(probe._timer->getElapsedTime() + 20ms);
+        REQUIRE(fge::timer::Notify(probe._timer));
+
+        REQUIRE(probe.waitCall());
+        CHECK_FALSE(fge::timer::Check(probe._timer));
+    }
+
+    SUBCASE("removed without being called")
+    {
+        CHECK(fge::timer::Destroy(probe._timer));
+        CHECK_FALSE(fge::timer::Check(probe._timer));
+        CHECK(probe._calls == 0);
+    }
+}
+
+TEST_CASE("testing timer pause and resume")
+{
+    TimerManagerScope scope;
+
+    SUBCASE("created paused")
+    {
+        TimerProbe probe{50ms, true};
+        fge::timer::Create(probe._timer);
+
+        std::this_thread::sleep_for(150ms);
+        CHECK(probe._calls == 0);
+        CHECK(probe._timer->getElapsedTime() == 0ms);
+
+        const auto resumeTime = std::chrono::steady_clock::now();
+        probe._timer->resume();
+        fge::timer::Notify(probe._timer);
+
+        REQUIRE(probe.waitCall());
+        CHECK(std::chrono::steady_clock::now() - resumeTime >= 50ms);
+    }
+
+    SUBCASE("paused before its goal")
+    {
+        TimerProbe probe{200ms};
+        fge::timer::Create(probe._timer);
+
+        std::this_thread::sleep_for(50ms);
+        probe._timer->pause();
+        const auto elapsed = probe._timer->getElapsedTime();
+        REQUIRE(elapsed < 200ms);
+
+        //The old deadline is reached while paused, the timer must not be called
+        std::this_thread::sleep_for(300ms);
+        CHECK(probe._calls == 0);
+        CHECK(probe._timer->getElapsedTime() == elapsed);
+        CHECK(fge::timer::Check(probe._timer));
+
+        const auto resumeTime = std::chrono::steady_clock::now();
+        probe._timer->resume();
+        fge::timer::Notify(probe._timer);
+
+        REQUIRE(probe.waitCall());
+        CHECK(std::chrono::steady_clock::now() - resumeTime >= 200ms - elapsed);
+    }
+}
+
+TEST_CASE("testing timer goal changes")
+{
+    TimerManagerScope scope;
+
+    SUBCASE("a closer goal is not seen without Notify")
+    {
+        TimerProbe probe{1h};
+        fge::timer::Create(probe._timer);
+
+        //Documented behaviour: the timer stay scheduled on its old deadline
+        probe._timer->setGoalDuration(10ms);
+        std::this_thread::sleep_for(150ms);
+        CHECK(probe._calls == 0);
+        CHECK(probe._timer->goalReached());
+
+        SUBCASE("Notify the timer")
+        {
+            REQUIRE(fge::timer::Notify(probe._timer));
+            CHECK(probe.waitCall());
+        }
+        SUBCASE("Notify every timers")
+        {
+            fge::timer::Notify();
+            CHECK(probe.waitCall());
+        }
+    }
+
+    SUBCASE("a further goal is seen without Notify")
+    {
+        TimerProbe probe{50ms};
+        fge::timer::Create(probe._timer);
+        probe._timer->addToGoal(200ms);
+
+        //The old deadline is reached first, the timer is rescheduled on its new goal
+        REQUIRE(probe.waitCall());
+        CHECK(probe._calledAfter >= 250);
+        CHECK(probe._calls == 1);
+    }
+
+    SUBCASE("Notify a timer that is not handled")
+    {
+        auto timer = std::make_shared<fge::Timer>(10ms);
+        CHECK_FALSE(fge::timer::Notify(timer));
+    }
+}
+
+TEST_CASE("testing timer dispatch policies")
+{
+    TimerManagerScope scope;
+    const auto mainThread = std::this_thread::get_id();
+
+    SUBCASE("main loop timers wait for ProcessQueuedCallbacks")
+    {
+        std::atomic<int> calls{0};
+        std::thread::id callThread;
+        auto timer = std::make_shared<fge::Timer>(10ms);
+        timer->setDispatchPolicy(fge::Timer::DispatchPolicies::DISPATCH_MAIN_LOOP);
+        timer->_onTimeReached.add(new fge::CallbackLambda<fge::Timer&>([&](fge::Timer&){
+            callThread = std::this_thread::get_id();
+            ++calls;
+        }));
+        fge::timer::Create(timer);
+
+        REQUIRE(WaitFor([](){ return fge::timer::GetStats()._queuedCount == 1; }));
+        std::this_thread::sleep_for(50ms);
+        CHECK(calls == 0);
+        CHECK(fge::timer::Check(timer));
+
+        CHECK(fge::timer::ProcessQueuedCallbacks() == 1);
+        CHECK(calls == 1);
+        CHECK(callThread == mainThread);
+        CHECK_FALSE(fge::timer::Check(timer));
+        CHECK(fge::timer::GetStats()._queuedCount == 0);
+        CHECK(fge::timer::ProcessQueuedCallbacks() == 0);
+    }
+
+    SUBCASE("thread pool timers are called by a worker")
+    {
+        fge::ThreadPool threadPool{2};
+        fge::timer::SetThreadPool(&threadPool);
+        CHECK(fge::timer::GetThreadPool() == &threadPool);
+
+        std::atomic<std::thread::id> inlineThread{};
+        std::atomic<std::thread::id> poolThread{};
+
+        auto inlineTimer = std::make_shared<fge::Timer>(10ms);
+        inlineTimer->_onTimeReached.add(new fge::CallbackLambda<fge::Timer&>([&](fge::Timer&){
+            inlineThread = std::this_thread::get_id();
+        }));
+        auto poolTimer = std::make_shared<fge::Timer>(10ms);
+        poolTimer->setDispatchPolicy(fge::Timer::DispatchPolicies::DISPATCH_THREAD_POOL);
+        poolTimer->_onTimeReached.add(new fge::CallbackLambda<fge::Timer&>([&](fge::Timer&){
+            poolThread = std::this_thread::get_id();
+        }));
+        fge::timer::Create(inlineTimer);
+        fge::timer::Create(poolTimer);
+
+        REQUIRE(WaitFor([&](){ return inlineThread.load() != std::thread::id{} && poolThread.load() != std::thread::id{}; }));
+        CHECK(inlineThread.load() != mainThread);
+        CHECK(poolThread.load() != mainThread);
+        CHECK(poolThread.load() != inlineThread.load());
+        CHECK(WaitFor([](){ return fge::timer::GetTimerSize() == 0; }));
+
+        fge::timer::SetThreadPool(nullptr);
+    }
+
+    SUBCASE("queued timers are dropped after the queue timeout")
+    {
+        fge::timer::ResetStats();
+        fge::timer::SetQueueTimeout(50ms);
+        CHECK(fge::timer::GetQueueTimeout() == 50ms);
+
+        std::atomic<int> calls{0};
+        auto timer = std::make_shared<fge::Timer>(10ms);
+        timer->setDispatchPolicy(fge::Timer::DispatchPolicies::DISPATCH_MAIN_LOOP);
+        timer->_onTimeReached.add(new fge::CallbackLambda<fge::Timer&>([&](fge::Timer&){
+            ++calls;
+        }));
+        fge::timer::Create(timer);
+
+        //The queue is checked at least every second by the timer thread
+        REQUIRE(WaitFor([&](){ return !fge::timer::Check(timer); }));
+        CHECK(fge::timer::GetStats()._droppedCount == 1);
+        CHECK(fge::timer::GetStats()._queuedCount == 0);
+        CHECK(fge::timer::ProcessQueuedCallbacks() == 0);
+        CHECK(calls == 0);
+
+        fge::timer::SetQueueTimeout(0ms);
+    }
+}
+
+TEST_CASE("testing timer stats")
+{
+    TimerManagerScope scope;
+    fge::timer::ResetStats();
+
+    auto stats = fge::timer::GetStats();
+    CHECK(stats._callbackCount == 0);
+    CHECK(stats._totalLatency == 0ms);
+    CHECK(stats._maxLatency == 0ms);
+
+    TimerProbe probe{10ms};
+    fge::timer::Create(probe._timer);
+    REQUIRE(probe.waitCall());
+
+    stats = fge::timer::GetStats();
+    CHECK(stats._callbackCount == 1);
+    CHECK(stats._maxLatency >= 0ms);
+    CHECK(stats._totalLatency == stats._maxLatency);
+
+    SUBCASE("the time spent in the queue is part of the latency")
+    {
+        TimerProbe queuedProbe{10ms};
+        queuedProbe._timer->setDispatchPolicy(fge::Timer::DispatchPolicies::DISPATCH_MAIN_LOOP);
+        fge::timer::Create(queuedProbe._timer);
+
+        REQUIRE(WaitFor([](){ return fge::timer::GetStats()._queuedCount == 1; }));
+        std::this_thread::sleep_for(100ms);
+        CHECK(fge::timer::ProcessQueuedCallbacks() == 1);
+
+        stats = fge::timer::GetStats();
+        CHECK(stats._callbackCount == 2);
+        CHECK(stats._maxLatency >= 100ms);
+        CHECK(stats._totalLatency >= stats._maxLatency);
+    }
+
+    SUBCASE("reset")
+    {
+        fge::timer::ResetStats();
+        stats = fge::timer::GetStats();
+        CHECK(stats._callbackCount == 0);
+        CHECK(stats._totalLatency == 0ms);
+        CHECK(stats._maxLatency == 0ms);
+        CHECK(stats._droppedCount == 0);
+    }
+}